@@ -1,108 +1,78 @@
 #include "AStarPathfinder.h"
+
 #include <algorithm>
-#include <chrono>
-#include <set>
+#include <stdexcept>
 
-double AStarPathfinder::heuristic(std::shared_ptr<Cell> from,
-                                  std::shared_ptr<Cell> to) const {
+PathCost AStarPathfinder::heuristic(Coordinate from, Coordinate to) {
   // Manhattan distance
-  return std::abs(from->getX() - to->getX()) +
-         std::abs(from->getY() - to->getY());
+  return static_cast<PathCost>(std::abs(from.x - to.x)) +
+         static_cast<PathCost>(std::abs(from.y - to.y));
 }
 
-std::vector<Cell>
-AStarPathfinder::findPath(const Maze &maze, std::shared_ptr<Cell> start,
-                          std::shared_ptr<Cell> goal,
-                          std::function<void(std::shared_ptr<Cell>)> onVisit) {
-  auto startTime = std::chrono::high_resolution_clock::now();
-
-  // Initialize
-  path.clear();
-  stats = {};
+PathCost AStarPathfinder::octileHeuristic(Coordinate from, Coordinate to) {
+  // Diagonal steps while both offsets remain, then straight ones
+  const PathCost dx = static_cast<PathCost>(std::abs(from.x - to.x));
+  const PathCost dy = static_cast<PathCost>(std::abs(from.y - to.y));
+  const PathCost diagonal = std::min(dx, dy);
+  return Movement::DIAGONAL_COST * diagonal +
+         Movement::STRAIGHT_COST * (dx + dy - 2 * diagonal);
+}
 
-  if (!start || !goal) {
-    return path;
+AStarPathfinder::AStarPathfinder(OpenList openList) : openList(openList) {}
+
+AStarPathfinder::AStarPathfinder(
+    std::shared_ptr<const LandmarkTable> landmarks, OpenList openList)
+    : openList(openList), landmarks(std::move(landmarks)) {}
+
+std::vector<Cell> AStarPathfinder::findPath(
+    const Maze &maze, SearchContext &context, std::shared_ptr<Cell> start,
+    std::shared_ptr<Cell> goal,
+    std::function<void(std::shared_ptr<Cell>)> onVisit) const {
+  // Open list ordered by f = g + h, with the Manhattan (or, moving
+  // diagonally, octile) distance as h. Every step costs at least the maze's
+  // lowest terrain cost, so scaling by it keeps h admissible.
+  const PathCost minCost = maze.getMinCost();
+  const bool octile =
+      context.getMovement().connectivity == Connectivity::EIGHT;
+  auto distance = [minCost, octile](Coordinate from, Coordinate to) {
+    return minCost *
+           (octile ? octileHeuristic(from, to) : heuristic(from, to));
+  };
+
+  if (landmarks && !octile && !landmarks->matches(maze)) {
+    throw std::invalid_argument("Landmark table was not built for this maze");
   }
-
-  // Priority queue for A* (min-heap based on f-score)
-  std::priority_queue<Node, std::vector<Node>, std::greater<Node>> openSet;
-
-  // Map to track g-scores (cost from start)
-  std::map<std::shared_ptr<Cell>, double> gScore;
-
-  // Map to track parent cells for path reconstruction
-  std::map<std::shared_ptr<Cell>, std::shared_ptr<Cell>> parent;
-
-  // Set to track visited cells
-  std::set<std::shared_ptr<Cell>> closedSet;
-
-  // Initialize start
-  gScore[start] = 0.0;
-  double fScore = heuristic(start, goal);
-  parent[start] = nullptr;
-  openSet.push({start, fScore});
-  stats.nodesExplored = 0;
-
-  bool found = false;
-
-  // A* main loop
-  while (!openSet.empty() && !found) {
-    Node current = openSet.top();
-    openSet.pop();
-
-    // Skip if already visited
-    if (closedSet.find(current.cell) != closedSet.end()) {
-      continue;
-    }
-
-    closedSet.insert(current.cell);
-    current.cell->setVisited(true);
-    stats.nodesExplored++;
-
-    // Call animation callback if provided
-    if (onVisit) {
-      onVisit(current.cell);
-    }
-
-    // Check if we reached the goal
-    if (*current.cell == *goal) {
-      found = true;
-      break;
-    }
-
-    // Explore neighbors
-    auto neighbors = maze.getNeighbors(current.cell);
-    for (auto &neighbor : neighbors) {
-      if (closedSet.find(neighbor) == closedSet.end()) {
-        double tentativeGScore =
-            gScore[current.cell] + 1.0; // Cost of 1 per move
-
-        // If we found a better path to this neighbor
-        if (gScore.find(neighbor) == gScore.end() ||
-            tentativeGScore < gScore[neighbor]) {
-          gScore[neighbor] = tentativeGScore;
-          double fScore = tentativeGScore + heuristic(neighbor, goal);
-          parent[neighbor] = current.cell;
-          openSet.push({neighbor, fScore});
-        }
-      }
+  // A table whose walls or costs have changed may overestimate, so those
+  // searches use the plain distance until it is rebuilt
+  if (landmarks && !octile && landmarks->isCurrent(maze)) {
+    // ALT: the landmark bound where it beats the Manhattan distance
+    const LandmarkTable *table = landmarks.get();
+    const std::uint8_t *costs = maze.getCostPlane();
+    const CellIndex width = static_cast<CellIndex>(maze.getWidth());
+    auto indexOf = [width](Coordinate coords) {
+      return static_cast<CellIndex>(coords.y) * width +
+             static_cast<CellIndex>(coords.x);
+    };
+    auto alt = [table, costs, distance, indexOf](Coordinate from,
+                                                 Coordinate to) {
+      return std::max(distance(from, to),
+                      table->lowerBound(indexOf(from), indexOf(to), costs));
+    };
+    // A wall start lies outside every landmark's region, so its estimate
+    // can fall far below its neighbors' and overrun the bucket ring
+    const bool openStart = start && !maze.isWall(start->getX(), start->getY());
+    if (openList == OpenList::BUCKETS && !costs && openStart) {
+      return runEngine(maze, context, start, goal, onVisit,
+                       BucketPolicy<decltype(alt)>(alt));
     }
+    return runEngine(maze, context, start, goal, onVisit,
+                     HeapPolicy<decltype(alt)>(alt));
   }
 
-  // Reconstruct path if found
-  if (found) {
-    auto current = goal;
-    while (current != nullptr) {
-      path.push_back(*current);
-      current = parent[current];
-    }
-    std::reverse(path.begin(), path.end());
-    stats.pathLength = path.size();
+  if (openList == OpenList::BUCKETS) {
+    return runEngine(maze, context, start, goal, onVisit,
+                     BucketPolicy<decltype(distance)>(distance));
   }
-
-  auto endTime = std::chrono::high_resolution_clock::now();
-  stats.executionTime =
-      std::chrono::duration<double, std::milli>(endTime - startTime);
-
-  return path;
+  return runEngine(maze, context, start, goal, onVisit,
+                   HeapPolicy<decltype(distance)>(distance));
 }
@@ -1,11 +1,11 @@
 #ifndef ASTAR_PATHFINDER_H
 #define ASTAR_PATHFINDER_H
 
+#include "LandmarkTable.h"
 #include "Maze.h"
 #include "PathFinder.h"
 #include <cmath>
-#include <map>
-#include <queue>
+#include <memory>
 
 /**
  * @brief A* pathfinding algorithm implementation.
@@ -13,40 +13,82 @@
  * A* uses a heuristic function to guide the search toward the goal,
  * combining the benefits of Dijkstra's algorithm with informed search.
  * Guarantees the shortest path if the heuristic is admissible.
+ *
+ * On mazes with terrain costs (Maze::getCost()) the path minimizes the total
+ * cost, and the Manhattan distance is scaled by Maze::getMinCost() to stay
+ * admissible. With 8-connected movement (SearchContext::setMovement()) the
+ * octile distance takes its place.
+ *
+ * Given a LandmarkTable, 4-connected searches use the ALT heuristic: the
+ * larger of the scaled Manhattan distance and the table's landmark bound.
+ * Both are consistent, so paths stay optimal, and in mazes far fewer cells
+ * are expanded. 8-connected searches ignore the table, whose distances are
+ * 4-connected, and so do searches after the maze's walls or costs have
+ * changed since the table was built.
+ *
+ * The landmark table is only read during a search. Any number of A*
+ * pathfinders may hold the same table and search on several threads, each
+ * with its own SearchContext; rebuild or reload it only while none runs.
  */
 class AStarPathfinder : public PathFinder {
 public:
+  using PathFinder::findPath;
+
+  /**
+   * @brief Construct an A* pathfinder.
+   * @param openList The open list to use (default: binary heap). BUCKETS
+   * gives the same path costs with O(1) queue operations.
+   */
+  explicit AStarPathfinder(OpenList openList = OpenList::BINARY_HEAP);
+
+  /**
+   * @brief Construct an A* pathfinder with the ALT heuristic.
+   * @param landmarks The landmark table of the mazes that will be searched.
+   * @param openList The open list to use (default: binary heap). On mazes
+   * with terrain costs the landmark bound can change by more than a bucket
+   * queue allows between neighbors, so those searches use the binary heap.
+   */
+  explicit AStarPathfinder(std::shared_ptr<const LandmarkTable> landmarks,
+                           OpenList openList = OpenList::BINARY_HEAP);
+
   /**
    * @brief Find a path from start to goal using A* algorithm.
    * @param maze The maze to search.
+   * @param context The per-query state to use.
    * @param start The starting cell.
    * @param goal The goal cell.
    * @param onVisit Optional callback for animation (default: nullptr).
    * @return A vector of cells representing the path, or empty if no path
    * exists.
+   * @throws std::invalid_argument if a landmark table is used that was built
+   * for a maze of a different size.
    */
-  std::vector<Cell> findPath(
-      const Maze &maze, std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
-      std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr) override;
+  std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const override;
 
-private:
   /**
-   * @brief Node structure for priority queue with f-score.
+   * @brief Calculate Manhattan distance heuristic.
+   * @param from The coordinates of the current cell.
+   * @param to The coordinates of the goal cell.
+   * @return The Manhattan distance.
    */
-  struct Node {
-    std::shared_ptr<Cell> cell;
-    double fScore; // f = g + h
-
-    bool operator>(const Node &other) const { return fScore > other.fScore; }
-  };
+  static PathCost heuristic(Coordinate from, Coordinate to);
 
   /**
-   * @brief Calculate Manhattan distance heuristic.
-   * @param from The starting cell.
-   * @param to The goal cell.
-   * @return The Manhattan distance.
+   * @brief Calculate the octile distance heuristic for 8-connected movement.
+   * @param from The coordinates of the current cell.
+   * @param to The coordinates of the goal cell.
+   * @return The cost of the cheapest straight and diagonal steps between the
+   * cells on an open grid, in Movement's 10/14 units.
    */
-  double heuristic(std::shared_ptr<Cell> from, std::shared_ptr<Cell> to) const;
+  static PathCost octileHeuristic(Coordinate from, Coordinate to);
+
+private:
+  OpenList openList;
+  std::shared_ptr<const LandmarkTable> landmarks; // ALT table, or null
 };
 
 #endif // ASTAR_PATHFINDER_H
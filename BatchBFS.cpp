@@ -0,0 +1,114 @@
+#include "BatchBFS.h"
+
+#include <algorithm>
+#include <numeric>
+
+BatchBFS::BatchBFS() : cellsExpanded(0) {}
+
+std::vector<std::uint64_t>
+BatchBFS::pathLengths(const Maze &maze, const std::vector<Query> &queries) {
+  const std::size_t cellCount = static_cast<std::size_t>(maze.getCellCount());
+  if (seen.size() != cellCount) {
+    seen.assign(cellCount, 0);
+    frontier.assign(cellCount, 0);
+    next.assign(cellCount, 0);
+    goals.assign(cellCount, 0);
+  }
+  cellsExpanded = 0;
+
+  // Lanes only share work when their searches move in step, which mostly
+  // means a shared start: batches are filled in order of start cell, and
+  // the lengths written back in the caller's order
+  std::vector<std::size_t> order(queries.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t a, std::size_t b) {
+                     return queries[a].start < queries[b].start;
+                   });
+
+  std::vector<std::uint64_t> lengths(queries.size(), 0);
+  Query batch[LANES];
+  std::uint64_t batchLengths[LANES];
+  for (std::size_t first = 0; first < queries.size(); first += LANES) {
+    const int count = static_cast<int>(
+        std::min<std::size_t>(LANES, queries.size() - first));
+    for (int i = 0; i < count; ++i) {
+      batch[i] = queries[order[first + i]];
+      batchLengths[i] = 0; // Lanes that never reach their goal
+    }
+    runBatch(maze, batch, count, batchLengths);
+    for (int i = 0; i < count; ++i)
+      lengths[order[first + i]] = batchLengths[i];
+  }
+  return lengths;
+}
+
+void BatchBFS::runBatch(const Maze &maze, const Query *queries, int count,
+                        std::uint64_t *lengths) {
+  current.clear();
+  touched.clear();
+  for (int i = 0; i < count; ++i) {
+    const CellIndex start = queries[i].start;
+    if (seen[start] == 0) {
+      touched.push_back(start);
+      current.push_back(start);
+    }
+    seen[start] |= std::uint64_t{1} << i;
+    frontier[start] |= std::uint64_t{1} << i;
+    goals[queries[i].goal] |= std::uint64_t{1} << i;
+  }
+
+  // Lanes still looking for their goal; those that start on it are done
+  std::uint64_t pending = count == LANES ? ~std::uint64_t{0}
+                                         : (std::uint64_t{1} << count) - 1;
+  auto arrive = [&](std::uint64_t lanes, std::uint64_t length) {
+    for (int i = 0; lanes != 0; ++i, lanes >>= 1) {
+      if (lanes & 1)
+        lengths[i] = length;
+    }
+  };
+  for (CellIndex start : current) {
+    const std::uint64_t done = seen[start] & goals[start];
+    arrive(done, 1);
+    pending &= ~done;
+  }
+
+  for (std::uint64_t length = 2; pending != 0 && !current.empty(); ++length) {
+    // Push every frontier lane still pending to the neighbors; the lanes
+    // that had not seen a neighbor are its frontier for the next level
+    reached.clear();
+    for (CellIndex cell : current) {
+      const std::uint64_t lanes = frontier[cell] & pending;
+      frontier[cell] = 0;
+      if (lanes == 0)
+        continue;
+      ++cellsExpanded;
+      maze.forEachNeighbor(cell, [&](CellIndex neighbor, Direction) {
+        const std::uint64_t fresh = lanes & ~seen[neighbor];
+        if (fresh == 0)
+          return;
+        if (seen[neighbor] == 0)
+          touched.push_back(neighbor);
+        if (next[neighbor] == 0)
+          reached.push_back(neighbor);
+        seen[neighbor] |= fresh;
+        next[neighbor] |= fresh;
+        const std::uint64_t done = goals[neighbor] & fresh;
+        if (done != 0) {
+          arrive(done, length);
+          pending &= ~done;
+        }
+      });
+    }
+    frontier.swap(next);
+    current.swap(reached);
+  }
+
+  for (CellIndex cell : touched) {
+    seen[cell] = 0;
+    frontier[cell] = 0;
+    next[cell] = 0;
+  }
+  for (int i = 0; i < count; ++i)
+    goals[queries[i].goal] = 0;
+}
@@ -0,0 +1,93 @@
+#ifndef BATCH_BFS_H
+#define BATCH_BFS_H
+
+#include "Maze.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Bit-parallel breadth-first search (MS-BFS) answering up to 64
+ * path-length queries per sweep of the maze.
+ *
+ * Each query of a batch owns one bit lane of a 64-bit word. Every cell
+ * holds a word of the lanes that have seen it and a word of the lanes
+ * whose frontier is on it. One level of all the searches takes one pass
+ * over the cells on any frontier: a cell's frontier lanes are ORed into
+ * its neighbors, and the lanes a neighbor had not seen become its new
+ * frontier. Where searches overlap, a cell is expanded once for all of
+ * them instead of once each. A lane stops when its goal is seen, and the
+ * batch when every lane has stopped or run out of cells.
+ *
+ * Searches only overlap when they reach a cell at the same level, which in
+ * a maze mostly means they share a start. pathLengths() therefore fills
+ * its batches in order of start cell, whatever the order of the queries.
+ * Queries from a few starts gain; unrelated queries are slower than one
+ * BFSPathfinder search each.
+ *
+ * Lengths count cells, as in PathStats::pathLength, and match
+ * BFSPathfinder with 4-connected movement: 0 if there is no path, 1 if the
+ * start is the goal. Terrain costs are ignored, as in BFSPathfinder.
+ *
+ * The per-cell words (32 bytes per cell) are kept between calls and only
+ * the cells a batch reached are cleared, so a BatchBFS that is reused
+ * allocates nothing per batch. A BatchBFS must not be shared between
+ * threads.
+ */
+class BatchBFS {
+public:
+  /**
+   * @brief Queries answered per sweep: the bits of a lane word.
+   */
+  static constexpr int LANES = 64;
+
+  /**
+   * @brief A path-length query.
+   */
+  struct Query {
+    CellIndex start;
+    CellIndex goal;
+  };
+
+  BatchBFS();
+
+  /**
+   * @brief Find the BFS path length of every query, LANES at a time, with
+   * the queries grouped into batches by start cell.
+   * @param maze The maze to search.
+   * @param queries The queries, in any order.
+   * @return The path length of each query, in the order of queries.
+   */
+  std::vector<std::uint64_t> pathLengths(const Maze &maze,
+                                         const std::vector<Query> &queries);
+
+  /**
+   * @brief Get the number of cell expansions of the last pathLengths()
+   * call: one per cell and level on any frontier, however many lanes.
+   */
+  std::uint64_t getCellsExpanded() const { return cellsExpanded; }
+
+  /**
+   * @brief Get the size of the per-cell words in bytes.
+   */
+  std::size_t getMemoryBytes() const {
+    return (seen.capacity() + frontier.capacity() + next.capacity() +
+            goals.capacity()) *
+           sizeof(std::uint64_t);
+  }
+
+private:
+  // Answer up to LANES queries in one sweep
+  void runBatch(const Maze &maze, const Query *queries, int count,
+                std::uint64_t *lengths);
+
+  std::vector<std::uint64_t> seen;     // Lanes that have seen each cell
+  std::vector<std::uint64_t> frontier; // Lanes whose frontier is on it
+  std::vector<std::uint64_t> next;     // Its frontier lanes next level
+  std::vector<std::uint64_t> goals;    // Lanes whose goal it is
+  std::vector<CellIndex> current;      // Cells with frontier lanes
+  std::vector<CellIndex> reached;      // Cells with next-level lanes
+  std::vector<CellIndex> touched;      // Cells to clear after the batch
+  std::uint64_t cellsExpanded;
+};
+
+#endif // BATCH_BFS_H
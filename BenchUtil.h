@@ -0,0 +1,98 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "Maze.h"
+
+/*
+ * Helpers shared by the benchmarks: timing, command line arguments, maze
+ * layouts and random open cells. Header-only, so that each benchmark stays
+ * a single source file.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+inline double millisecondsSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+/**
+ * @brief Get a numeric command line argument.
+ * @return argv[position] as an integer, or fallback if it was not given.
+ */
+inline int intArgument(int argc, char *argv[], int position, int fallback) {
+  return argc > position ? std::atoi(argv[position]) : fallback;
+}
+
+/**
+ * @brief Get a command line argument as text.
+ * @return argv[position], or fallback if it was not given.
+ */
+inline std::string textArgument(int argc, char *argv[], int position,
+                                const std::string &fallback) {
+  return argc > position ? argv[position] : fallback;
+}
+
+/**
+ * @brief Check a layout name: "perfect" (recursive backtracking), "rooms"
+ * (recursive division), "open" (Maze::generate, an open grid with scattered
+ * pillars) or "terrain" (the open grid with random terrain costs of 1-9).
+ */
+inline bool isLayout(const std::string &layout) {
+  return layout == "perfect" || layout == "rooms" || layout == "open" ||
+         layout == "terrain";
+}
+
+/**
+ * @brief Generate a size x size maze with one of the layouts of isLayout().
+ * @param rng Draws the terrain costs; left untouched by the other layouts.
+ */
+inline void generateLayout(Maze &maze, int size, const std::string &layout,
+                           std::mt19937 &rng) {
+  if (layout == "open" || layout == "terrain")
+    maze.generate(size, size);
+  else
+    maze.generatePerfectMaze(
+        size, size,
+        layout == "rooms" ? MazeGenerationAlgorithm::RECURSIVE_DIVISION
+                          : MazeGenerationAlgorithm::RECURSIVE_BACKTRACKING);
+  if (layout == "terrain") {
+    std::uniform_int_distribution<int> terrainCost(1, 9);
+    for (int y = 0; y < size; ++y)
+      for (int x = 0; x < size; ++x)
+        maze.setCost(x, y, static_cast<std::uint8_t>(terrainCost(rng)));
+  }
+}
+
+/**
+ * @brief Draw random cells until one is open. The maze must have one.
+ * @return The index of the open cell.
+ */
+inline CellIndex randomOpenIndex(const Maze &maze, std::mt19937 &rng) {
+  std::uniform_int_distribution<int> column(0, maze.getWidth() - 1);
+  std::uniform_int_distribution<int> row(0, maze.getHeight() - 1);
+  int x, y;
+  do {
+    x = column(rng);
+    y = row(rng);
+  } while (maze.isWall(x, y));
+  return maze.indexOf(x, y);
+}
+
+/**
+ * @brief As randomOpenIndex(), but returns a handle to the cell.
+ */
+inline std::shared_ptr<Cell> randomOpenCell(const Maze &maze,
+                                            std::mt19937 &rng) {
+  const Coordinate coords = maze.coordsOf(randomOpenIndex(maze, rng));
+  return maze.getCell(coords.x, coords.y);
+}
+
+#endif // BENCH_UTIL_H
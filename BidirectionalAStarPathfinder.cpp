@@ -0,0 +1,191 @@
+#include "BidirectionalAStarPathfinder.h"
+
+#include "AStarPathfinder.h"
+#include <chrono>
+#include <queue>
+
+namespace {
+
+const int DX[] = {0, 0, -1, 1}; // UP, DOWN, LEFT, RIGHT
+const int DY[] = {-1, 1, 0, 0};
+
+struct Node {
+  CellIndex index;
+  PathCost fScore; // f = g + h
+  PathCost gScore; // Cost from the side's root when the node was queued
+
+  bool operator>(const Node &other) const {
+    return fScore > other.fScore ||
+           (fScore == other.fScore && gScore < other.gScore);
+  }
+};
+
+// One direction of the search
+struct Side {
+  SearchContext *context;
+  Coordinate target; // Cell the side's heuristic estimates the distance to
+  std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
+  PathCost lowestF;        // Smallest f on the open list (a lower bound)
+  std::uint64_t *expanded; // Expansion counter of the side
+};
+
+} // namespace
+
+template <typename Visitor>
+bool BidirectionalAStarPathfinder::searchBothWays(
+    const Maze &maze, SearchContext &context, CellIndex start, CellIndex goal,
+    Visitor &visit, std::uint64_t (&expanded)[2]) {
+  SearchContext &reverse = context.getReverse();
+  reverse.begin(maze);
+  context.reserveCosts();
+  reverse.reserveCosts();
+
+  // Every step costs at least the cheapest cell, so the scaled Manhattan
+  // distance stays a lower bound with terrain costs
+  const std::uint8_t *costs = maze.getCostPlane();
+  const PathCost minCost = maze.getMinCost();
+  auto heuristic = [minCost](Coordinate from, Coordinate to) {
+    return minCost * AStarPathfinder::heuristic(from, to);
+  };
+
+  const Coordinate startCoords = maze.coordsOf(start);
+  const Coordinate goalCoords = maze.coordsOf(goal);
+  const PathCost estimate = heuristic(startCoords, goalCoords);
+
+  Side sides[2] = {
+      {&context, goalCoords, {}, estimate, &expanded[0]},
+      {&reverse, startCoords, {}, estimate, &expanded[1]}};
+  context.relax(start, 0, SearchContext::ROOT_PARENT);
+  reverse.relax(goal, 0, SearchContext::ROOT_PARENT);
+  sides[0].open.push({start, estimate, 0});
+  sides[1].open.push({goal, estimate, 0});
+
+  // Shortest path found so far (L) and the cell where its halves meet
+  constexpr std::uint64_t NO_PATH = ~std::uint64_t{0};
+  std::uint64_t best = start == goal ? 0 : NO_PATH;
+  CellIndex meeting = start;
+
+  while (!sides[0].open.empty() && !sides[1].open.empty()) {
+    const int side = sides[0].open.size() <= sides[1].open.size() ? 0 : 1;
+    Side &own = sides[side];
+    Side &other = sides[1 - side];
+    SearchContext &ownContext = *own.context;
+    SearchContext &otherContext = *other.context;
+
+    const Node node = own.open.top();
+    own.open.pop();
+
+    // Skip outdated entries and cells either side has already closed
+    const bool current = node.gScore <= ownContext.getCost(node.index) &&
+                         !ownContext.isClosed(node.index) &&
+                         !otherContext.isClosed(node.index);
+    if (current) {
+      ownContext.markClosed(node.index);
+
+      // Expand only if a path through the cell could still beat the best,
+      // judged by this side's estimate and by the other side's lower bound
+      const Coordinate coords = maze.coordsOf(node.index);
+      const std::uint64_t g = node.gScore;
+      const bool promising =
+          best == NO_PATH ||
+          (node.fScore < best &&
+           g + other.lowestF < best + heuristic(coords, other.target));
+
+      if (promising) {
+        ++*own.expanded;
+        visit(node.index);
+
+        // A step pays for the cell it enters: the neighbor going forward,
+        // and the expanded cell going backward, since the path leaves the
+        // neighbor for it
+        const PathCost backwardStep = costs ? costs[node.index] : 1;
+
+        maze.forEachNeighbor(node.index, [&](CellIndex neighbor,
+                                             Direction step) {
+          if (ownContext.isClosed(neighbor) || otherContext.isClosed(neighbor))
+            return;
+          const PathCost neighborG =
+              node.gScore +
+              (side == 1 ? backwardStep : costs ? costs[neighbor] : 1);
+          if (!ownContext.relax(neighbor, neighborG,
+                                SearchContext::oppositeDirection(step)))
+            return;
+
+          const int d = static_cast<int>(step);
+          const Coordinate neighborCoords = {coords.x + DX[d],
+                                             coords.y + DY[d]};
+          own.open.push(
+              {neighbor,
+               neighborG + heuristic(neighborCoords, own.target),
+               neighborG});
+
+          if (otherContext.isVisited(neighbor)) {
+            const std::uint64_t length =
+                std::uint64_t{neighborG} + otherContext.getCost(neighbor);
+            if (length < best) {
+              best = length;
+              meeting = neighbor;
+            }
+          }
+        });
+      }
+    }
+
+    if (!own.open.empty())
+      own.lowestF = own.open.top().fScore;
+  }
+
+  if (best == NO_PATH)
+    return false;
+  joinReversePath(maze, context, meeting, goal);
+  return true;
+}
+
+std::vector<Cell> BidirectionalAStarPathfinder::findPath(
+    const Maze &maze, SearchContext &context, std::shared_ptr<Cell> start,
+    std::shared_ptr<Cell> goal,
+    std::function<void(std::shared_ptr<Cell>)> onVisit) const {
+  requireFourConnected(context, "Bidirectional A*");
+  auto startTime = std::chrono::high_resolution_clock::now();
+
+  context.begin(maze);
+  if (!start || !goal) {
+    return context.getPath();
+  }
+
+  const CellIndex startIndex = maze.indexOf(start->getX(), start->getY());
+  const CellIndex goalIndex = maze.indexOf(goal->getX(), goal->getY());
+
+  // No neighbor ever steps onto a wall goal, so the single-direction
+  // searches find no path to it; the backward side must not start there
+  const bool wallGoal =
+      goalIndex != startIndex && maze.isWall(goal->getX(), goal->getY());
+
+  std::uint64_t expanded[2] = {0, 0}; // Forward, backward
+  bool found;
+  if (wallGoal || isUnreachable(maze, context, startIndex, goalIndex)) {
+    found = false;
+  } else if (onVisit) {
+    CellCallbackVisitor visitor(maze, onVisit);
+    found = searchBothWays(maze, context, startIndex, goalIndex, visitor,
+                           expanded);
+  } else {
+    NullVisitor visitor;
+    found = searchBothWays(maze, context, startIndex, goalIndex, visitor,
+                           expanded);
+  }
+
+  forwardNodes.store(expanded[0]);
+  backwardNodes.store(expanded[1]);
+  PathStats &stats = context.getStats();
+  stats.nodesExplored = expanded[0] + expanded[1];
+  if (found) {
+    reconstructPath(maze, context, startIndex, goalIndex);
+  }
+
+  auto endTime = std::chrono::high_resolution_clock::now();
+  stats.executionTime =
+      std::chrono::duration<double, std::milli>(endTime - startTime);
+
+  return context.getPath();
+}
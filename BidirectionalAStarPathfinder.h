@@ -0,0 +1,85 @@
+#ifndef BIDIRECTIONAL_ASTAR_PATHFINDER_H
+#define BIDIRECTIONAL_ASTAR_PATHFINDER_H
+
+#include "Maze.h"
+#include "PathFinder.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Bidirectional A* pathfinding (NBA*, "New Bidirectional A*").
+ *
+ * Runs A* from the start towards the goal and from the goal towards the
+ * start, each with the Manhattan distance (AStarPathfinder::heuristic) to
+ * its own target, scaled by Maze::getMinCost(). A step pays the terrain cost
+ * of the cell it enters, as in AStarPathfinder; the backward side walks the
+ * steps in reverse, so it pays for the cell it leaves. Each step expands a
+ * cell from the side with the smaller open list. The best path found where
+ * the searches touch is the upper bound L. A cell is skipped unexpanded when
+ * no path through it can beat L, judged by either side's lower bound:
+ * - g(x) + h(x) >= L, or
+ * - g(x) + F - h'(x) >= L, where F is the smallest f on the other side's
+ *   open list and h' that side's heuristic.
+ * Expanded and skipped cells join one closed set shared by both sides. The
+ * search ends when either open list runs out, and L is then optimal, so
+ * paths cost as little as those of AStarPathfinder.
+ *
+ * The backward search runs in the context's reverse context, and its half
+ * of the path is copied into the forward parents as in
+ * BidirectionalBFSPathfinder. getForwardNodes() and getBackwardNodes()
+ * count the cells expanded by each side; stats.nodesExplored is their sum.
+ */
+class BidirectionalAStarPathfinder : public PathFinder {
+public:
+  using PathFinder::findPath;
+
+  /**
+   * @brief Find a path from start to goal using bidirectional A*.
+   * @param maze The maze to search.
+   * @param context The per-query state to use.
+   * @param start The starting cell.
+   * @param goal The goal cell.
+   * @param onVisit Optional callback for animation, called for the cells
+   * expanded by either side (default: nullptr).
+   * @return A vector of cells representing the path, or empty if no path
+   * exists.
+   * @throws std::invalid_argument if the context's movement is not
+   * 4-connected.
+   */
+  std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const override;
+
+  /**
+   * @brief Get the number of cells the forward search expanded in the last
+   * query through this pathfinder. Queries running at the same time
+   * overwrite each other's counts.
+   */
+  std::uint64_t getForwardNodes() const { return forwardNodes.load(); }
+
+  /**
+   * @brief Get the number of cells the backward search expanded in the last
+   * query through this pathfinder.
+   */
+  std::uint64_t getBackwardNodes() const { return backwardNodes.load(); }
+
+private:
+  /**
+   * @brief Run both searches until one open list is exhausted. On success
+   * the forward parents lead from the goal to the start.
+   * @param visit Called with every expanded cell.
+   * @param expanded Receives the cells expanded forward, then backward.
+   * @return true if a path was found.
+   */
+  template <typename Visitor>
+  static bool searchBothWays(const Maze &maze, SearchContext &context,
+                             CellIndex start, CellIndex goal, Visitor &visit,
+                             std::uint64_t (&expanded)[2]);
+
+  mutable std::atomic<std::uint64_t> forwardNodes{0};
+  mutable std::atomic<std::uint64_t> backwardNodes{0};
+};
+
+#endif // BIDIRECTIONAL_ASTAR_PATHFINDER_H
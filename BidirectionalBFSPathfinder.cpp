@@ -0,0 +1,114 @@
+#include "BidirectionalBFSPathfinder.h"
+
+#include <chrono>
+
+template <typename Visitor>
+bool BidirectionalBFSPathfinder::searchBothWays(const Maze &maze,
+                                                SearchContext &context,
+                                                CellIndex start, CellIndex goal,
+                                                Visitor &visit,
+                                                std::uint64_t (&expanded)[2]) {
+  SearchContext &reverse = context.getReverse();
+  reverse.begin(maze);
+
+  context.markVisited(start, SearchContext::ROOT_PARENT);
+  reverse.markVisited(goal, SearchContext::ROOT_PARENT);
+  if (start == goal)
+    return true;
+
+  SearchContext *sides[2] = {&context, &reverse};
+  std::vector<CellIndex> frontiers[2] = {{start}, {goal}};
+  std::vector<CellIndex> next;
+
+  while (!frontiers[0].empty() && !frontiers[1].empty()) {
+    const int side = frontiers[0].size() <= frontiers[1].size() ? 0 : 1;
+    SearchContext &own = *sides[side];
+    const SearchContext &other = *sides[1 - side];
+
+    next.clear();
+    for (CellIndex cell : frontiers[side]) {
+      ++expanded[side];
+      visit(cell);
+
+      bool met = false;
+      CellIndex meeting = 0;
+      Direction meetingStep = Direction::UP;
+      maze.forEachNeighbor(cell, [&](CellIndex neighbor, Direction step) {
+        if (met || own.isVisited(neighbor))
+          return;
+        if (other.isVisited(neighbor)) {
+          met = true;
+          meeting = neighbor;
+          meetingStep = step;
+          return;
+        }
+        own.markVisited(neighbor, SearchContext::oppositeDirection(step));
+        next.push_back(neighbor);
+      });
+
+      if (met) {
+        // Link the forward side to the cell the backward side reached
+        if (side == 0) {
+          context.markVisited(meeting,
+                              SearchContext::oppositeDirection(meetingStep));
+        } else {
+          context.markVisited(cell, static_cast<std::uint8_t>(meetingStep));
+          meeting = cell;
+        }
+        joinReversePath(maze, context, meeting, goal);
+        return true;
+      }
+    }
+    frontiers[side].swap(next);
+  }
+  return false;
+}
+
+std::vector<Cell> BidirectionalBFSPathfinder::findPath(
+    const Maze &maze, SearchContext &context, std::shared_ptr<Cell> start,
+    std::shared_ptr<Cell> goal,
+    std::function<void(std::shared_ptr<Cell>)> onVisit) const {
+  requireFourConnected(context, "Bidirectional BFS");
+  auto startTime = std::chrono::high_resolution_clock::now();
+
+  context.begin(maze);
+  if (!start || !goal) {
+    return context.getPath();
+  }
+
+  const CellIndex startIndex = maze.indexOf(start->getX(), start->getY());
+  const CellIndex goalIndex = maze.indexOf(goal->getX(), goal->getY());
+
+  // No neighbor ever steps onto a wall goal, so the single-direction
+  // searches find no path to it; the backward side must not start there
+  const bool wallGoal =
+      goalIndex != startIndex && maze.isWall(goal->getX(), goal->getY());
+
+  std::uint64_t expanded[2] = {0, 0}; // Forward, backward
+  bool found;
+  if (wallGoal || isUnreachable(maze, context, startIndex, goalIndex)) {
+    found = false;
+  } else if (onVisit) {
+    CellCallbackVisitor visitor(maze, onVisit);
+    found = searchBothWays(maze, context, startIndex, goalIndex, visitor,
+                           expanded);
+  } else {
+    NullVisitor visitor;
+    found = searchBothWays(maze, context, startIndex, goalIndex, visitor,
+                           expanded);
+  }
+
+  forwardNodes.store(expanded[0]);
+  backwardNodes.store(expanded[1]);
+  PathStats &stats = context.getStats();
+  stats.nodesExplored = expanded[0] + expanded[1];
+  if (found) {
+    reconstructPath(maze, context, startIndex, goalIndex);
+  }
+
+  auto endTime = std::chrono::high_resolution_clock::now();
+  stats.executionTime =
+      std::chrono::duration<double, std::milli>(endTime - startTime);
+
+  return context.getPath();
+}
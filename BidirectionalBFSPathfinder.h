@@ -0,0 +1,78 @@
+#ifndef BIDIRECTIONAL_BFS_PATHFINDER_H
+#define BIDIRECTIONAL_BFS_PATHFINDER_H
+
+#include "Maze.h"
+#include "PathFinder.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Bidirectional Breadth-First Search pathfinding implementation.
+ *
+ * Runs one BFS from the start and one from the goal and stops when they
+ * meet. Each round expands a whole level of the smaller frontier, so the
+ * search stays balanced even when one side is boxed in. Until they meet,
+ * the two searches reach disjoint sets of cells. So the first meeting closes
+ * a shortest path, as short as the one BFSPathfinder finds.
+ *
+ * The backward search runs in the context's reverse context. On success the
+ * goal's half of the path is copied into the forward parents, so the
+ * context holds the whole path like any other search.
+ *
+ * getForwardNodes() and getBackwardNodes() count the cells expanded by
+ * each side; stats.nodesExplored is their sum.
+ */
+class BidirectionalBFSPathfinder : public PathFinder {
+public:
+  using PathFinder::findPath;
+
+  /**
+   * @brief Find a path from start to goal using bidirectional BFS.
+   * @param maze The maze to search.
+   * @param context The per-query state to use.
+   * @param start The starting cell.
+   * @param goal The goal cell.
+   * @param onVisit Optional callback for animation, called for the cells
+   * expanded by either side (default: nullptr).
+   * @return A vector of cells representing the path, or empty if no path
+   * exists.
+   * @throws std::invalid_argument if the context's movement is not
+   * 4-connected.
+   */
+  std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const override;
+
+  /**
+   * @brief Get the number of cells the forward search expanded in the last
+   * query through this pathfinder. Queries running at the same time
+   * overwrite each other's counts.
+   */
+  std::uint64_t getForwardNodes() const { return forwardNodes.load(); }
+
+  /**
+   * @brief Get the number of cells the backward search expanded in the last
+   * query through this pathfinder.
+   */
+  std::uint64_t getBackwardNodes() const { return backwardNodes.load(); }
+
+private:
+  /**
+   * @brief Expand levels of the smaller frontier until the two searches
+   * meet. On success the forward parents lead from the goal to the start.
+   * @param visit Called with every expanded cell.
+   * @param expanded Receives the cells expanded forward, then backward.
+   * @return true if the searches met.
+   */
+  template <typename Visitor>
+  static bool searchBothWays(const Maze &maze, SearchContext &context,
+                             CellIndex start, CellIndex goal, Visitor &visit,
+                             std::uint64_t (&expanded)[2]);
+
+  mutable std::atomic<std::uint64_t> forwardNodes{0};
+  mutable std::atomic<std::uint64_t> backwardNodes{0};
+};
+
+#endif // BIDIRECTIONAL_BFS_PATHFINDER_H
@@ -1,6 +1,23 @@
 #include "Cell.h"
 
-Cell::Cell(int x, int y) : coords{x, y}, wall(false), visited(false), path(false) {}
+#include "Maze.h"
+#include <stdexcept>
+
+namespace {
+
+void requireEditable(const Maze *maze) {
+    if (maze) {
+        throw std::logic_error("Cell handle of a const Maze is read-only");
+    }
+}
+
+} // namespace
+
+Cell::Cell(int x, int y) : coords{x, y}, maze(nullptr), wall(false), visited(false), path(false) {}
+
+Cell::Cell(int x, int y, Maze *maze) : coords{x, y}, maze(maze), editable(maze) {}
+
+Cell::Cell(int x, int y, const Maze *maze) : coords{x, y}, maze(maze) {}
 
 Coordinate Cell::getCoords() const {
     return coords;
@@ -15,32 +32,51 @@ int Cell::getY() const {
 }
 
 bool Cell::isWall() const {
-    return wall;
+    return maze ? maze->isWall(coords.x, coords.y) : wall;
 }
 
 bool Cell::isVisited() const {
-    return visited;
+    return maze ? maze->isVisited(coords.x, coords.y) : visited;
 }
 
 bool Cell::isPath() const {
-    return path;
+    return maze ? maze->isPath(coords.x, coords.y) : path;
+}
+
+bool Cell::isReadOnly() const {
+    return maze && !editable;
 }
 
 void Cell::setWall(bool isWall) {
-    this->wall = isWall;
+    if (editable) {
+        editable->setWall(coords.x, coords.y, isWall);
+    } else {
+        requireEditable(maze);
+        this->wall = isWall;
+    }
 }
 
 void Cell::setVisited(bool isVisited) {
-    this->visited = isVisited;
+    if (editable) {
+        editable->setVisited(coords.x, coords.y, isVisited);
+    } else {
+        requireEditable(maze);
+        this->visited = isVisited;
+    }
 }
 
 void Cell::setPath(bool isPath) {
-    this->path = isPath;
+    if (editable) {
+        editable->setPath(coords.x, coords.y, isPath);
+    } else {
+        requireEditable(maze);
+        this->path = isPath;
+    }
 }
 
 void Cell::reset() {
-    visited = false;
-    path = false;
+    setVisited(false);
+    setPath(false);
 }
 
 bool Cell::operator==(const Cell& other) const {
@@ -3,20 +3,44 @@
 
 #include "PathStats.h" // For Coordinate struct
 
+class Maze;
+
 /**
  * @brief Represents a single cell in the maze grid.
- * It stores its position, its state (wall, visited, path), and provides
- * methods to manage this state.
+ *
+ * A Cell obtained from a Maze is a lightweight handle: it stores only its
+ * position and reads/writes its state (wall, visited, path) through the
+ * maze's flat storage planes. The handle must not outlive the maze. Handles
+ * obtained from a const Maze are read-only: their setters throw.
+ *
+ * A Cell constructed without a maze is a detached value (for example the
+ * cells of a returned path) and keeps its own state.
  */
 class Cell {
 public:
     /**
-     * @brief Construct a new Cell object.
+     * @brief Construct a new detached Cell object.
      * @param x The x-coordinate of the cell.
      * @param y The y-coordinate of the cell.
      */
     Cell(int x = 0, int y = 0);
 
+    /**
+     * @brief Construct a handle onto a cell of a maze.
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @param maze The maze whose storage the handle views and edits.
+     */
+    Cell(int x, int y, Maze *maze);
+
+    /**
+     * @brief Construct a read-only handle onto a cell of a maze.
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @param maze The maze whose storage the handle views.
+     */
+    Cell(int x, int y, const Maze *maze);
+
     // --- Getters ---
     Coordinate getCoords() const;
     int getX() const;
@@ -25,7 +49,14 @@ public:
     bool isVisited() const;
     bool isPath() const;
 
+    /**
+     * @brief Check whether the setters would throw, as for a handle obtained
+     * from a const Maze.
+     */
+    bool isReadOnly() const;
+
     // --- Setters ---
+    // These throw std::logic_error on a read-only handle.
     void setWall(bool isWall);
     void setVisited(bool isVisited);
     void setPath(bool isPath);
@@ -52,6 +83,10 @@ public:
 
 private:
     Coordinate coords;
+    const Maze *maze = nullptr; // Maze this cell views, or null when detached
+    Maze *editable = nullptr;   // The same maze if the handle may edit it
+
+    // State of a detached cell; unused for maze handles.
     bool wall = false;
     bool visited = false;
     bool path = false;
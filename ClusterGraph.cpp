@@ -0,0 +1,329 @@
+#include "ClusterGraph.h"
+
+#include "SearchContext.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// Calls emit(i) for each transition along a border of the given length,
+// where open(i) tells whether the cells on both sides of position i are open
+template <typename Open, typename Emit>
+void forEachTransition(int length, Open open, Emit emit) {
+  int i = 0;
+  while (i < length) {
+    if (!open(i)) {
+      ++i;
+      continue;
+    }
+    int end = i + 1;
+    while (end < length && open(end))
+      ++end;
+    if (end - i < ClusterGraph::LONG_ENTRANCE) {
+      emit(i + (end - i) / 2);
+    } else {
+      emit(i);
+      emit(end - 1);
+    }
+    i = end;
+  }
+}
+
+// Position of distance(i, j), i < j, in a cluster's triangle of distances
+std::size_t triangleIndex(std::size_t nodes, std::size_t i, std::size_t j) {
+  return i * (2 * nodes - i - 1) / 2 + (j - i - 1);
+}
+
+} // namespace
+
+ClusterGraph::ClusterGraph()
+    : width(0), height(0), clusterSize(0), clustersX(0), clustersY(0),
+      walls{0, 0}, costs{0, 0}, firstNodes(1, 0) {}
+
+ClusterGraph::ClusterGraph(const Maze &maze, int clusterSize)
+    : ClusterGraph() {
+  build(maze, clusterSize);
+}
+
+void ClusterGraph::build(const Maze &maze, int newClusterSize) {
+  if (newClusterSize < 2) {
+    throw std::invalid_argument("Cluster size must be at least 2");
+  }
+  width = maze.getWidth();
+  height = maze.getHeight();
+  clusterSize = newClusterSize;
+  clustersX = (width + clusterSize - 1) / clusterSize;
+  clustersY = (height + clusterSize - 1) / clusterSize;
+
+  clusters.assign(static_cast<std::size_t>(clustersX) *
+                      static_cast<std::size_t>(clustersY),
+                  Cluster());
+  ClusterSearch search;
+  for (std::size_t cluster = 0; cluster < clusters.size(); ++cluster)
+    buildCluster(maze, cluster, search);
+  numberNodes();
+  walls = maze.getWallVersion();
+  costs = maze.getCostVersion();
+}
+
+std::size_t ClusterGraph::update(const Maze &maze, int x, int y) {
+  if (!matches(maze)) {
+    throw std::invalid_argument("Cluster graph was not built for this maze");
+  }
+
+  // A cell on the edge of its cluster decides the entrances of that border,
+  // which the cluster across it shares
+  std::vector<std::size_t> affected = {clusterOf(x, y)};
+  if (x % clusterSize == 0 && x > 0)
+    affected.push_back(clusterOf(x - 1, y));
+  if (x % clusterSize == clusterSize - 1 && x + 1 < width)
+    affected.push_back(clusterOf(x + 1, y));
+  if (y % clusterSize == 0 && y > 0)
+    affected.push_back(clusterOf(x, y - 1));
+  if (y % clusterSize == clusterSize - 1 && y + 1 < height)
+    affected.push_back(clusterOf(x, y + 1));
+
+  ClusterSearch search;
+  bool renumber = false;
+  for (std::size_t cluster : affected) {
+    const std::size_t before = clusters[cluster].nodes.size();
+    buildCluster(maze, cluster, search);
+    renumber = renumber || clusters[cluster].nodes.size() != before;
+  }
+  if (renumber)
+    numberNodes();
+  walls = maze.getWallVersion();
+  costs = maze.getCostVersion();
+  return affected.size();
+}
+
+ClusterGraph::Bounds ClusterGraph::getBounds(std::size_t cluster) const {
+  const std::size_t perRow = static_cast<std::size_t>(clustersX);
+  const int x0 = static_cast<int>(cluster % perRow) * clusterSize;
+  const int y0 = static_cast<int>(cluster / perRow) * clusterSize;
+  return {x0, y0, std::min(x0 + clusterSize, width),
+          std::min(y0 + clusterSize, height)};
+}
+
+int ClusterGraph::findNode(std::size_t cluster, CellIndex cell) const {
+  const std::vector<CellIndex> &nodes = clusters[cluster].nodes;
+  auto it = std::lower_bound(nodes.begin(), nodes.end(), cell);
+  if (it == nodes.end() || *it != cell)
+    return -1;
+  return static_cast<int>(it - nodes.begin());
+}
+
+PathCost ClusterGraph::distance(std::size_t cluster, int i, int j) const {
+  if (i == j)
+    return 0;
+  const Cluster &c = clusters[cluster];
+  const std::size_t low = static_cast<std::size_t>(std::min(i, j));
+  const std::size_t high = static_cast<std::size_t>(std::max(i, j));
+  return c.distances[triangleIndex(c.nodes.size(), low, high)];
+}
+
+std::size_t ClusterGraph::getMemoryBytes() const {
+  std::size_t bytes = clusters.capacity() * sizeof(Cluster) +
+                      firstNodes.capacity() * sizeof(std::size_t);
+  for (const Cluster &cluster : clusters) {
+    bytes += cluster.nodes.capacity() * sizeof(CellIndex) +
+             cluster.distances.capacity() * sizeof(PathCost);
+  }
+  return bytes;
+}
+
+void ClusterGraph::buildCluster(const Maze &maze, std::size_t cluster,
+                                ClusterSearch &search) {
+  const Bounds b = getBounds(cluster);
+  std::vector<CellIndex> nodes;
+
+  // Each border is scanned from both of its clusters, which place their
+  // transitions at the same positions
+  auto addNodes = [&](int length, auto open, auto inside) {
+    forEachTransition(length, open,
+                      [&](int i) { nodes.push_back(inside(i)); });
+  };
+  const int columns = b.x1 - b.x0;
+  const int rows = b.y1 - b.y0;
+  if (b.y0 > 0) {
+    addNodes(
+        columns,
+        [&](int i) {
+          return !maze.isWall(b.x0 + i, b.y0) &&
+                 !maze.isWall(b.x0 + i, b.y0 - 1);
+        },
+        [&](int i) { return maze.indexOf(b.x0 + i, b.y0); });
+  }
+  if (b.y1 < height) {
+    addNodes(
+        columns,
+        [&](int i) {
+          return !maze.isWall(b.x0 + i, b.y1 - 1) &&
+                 !maze.isWall(b.x0 + i, b.y1);
+        },
+        [&](int i) { return maze.indexOf(b.x0 + i, b.y1 - 1); });
+  }
+  if (b.x0 > 0) {
+    addNodes(
+        rows,
+        [&](int i) {
+          return !maze.isWall(b.x0, b.y0 + i) &&
+                 !maze.isWall(b.x0 - 1, b.y0 + i);
+        },
+        [&](int i) { return maze.indexOf(b.x0, b.y0 + i); });
+  }
+  if (b.x1 < width) {
+    addNodes(
+        rows,
+        [&](int i) {
+          return !maze.isWall(b.x1 - 1, b.y0 + i) &&
+                 !maze.isWall(b.x1, b.y0 + i);
+        },
+        [&](int i) { return maze.indexOf(b.x1 - 1, b.y0 + i); });
+  }
+  // A corner cell can be a node of two borders
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+  // Costs are symmetric, so one search per node covers the later nodes
+  const std::size_t k = nodes.size();
+  std::vector<PathCost> distances(k > 1 ? k * (k - 1) / 2 : 0, NO_PATH);
+  const std::uint8_t *cellCosts = maze.getCostPlane();
+  for (std::size_t i = 0; i + 1 < k; ++i) {
+    search.run(maze, b, nodes[i], false);
+    const PathCost own = cellCosts ? cellCosts[nodes[i]] : 1;
+    for (std::size_t j = i + 1; j < k; ++j) {
+      const PathCost cost = search.cost(maze, nodes[j]);
+      if (cost != NO_PATH)
+        distances[triangleIndex(k, i, j)] = cost + own;
+    }
+  }
+
+  clusters[cluster].nodes = std::move(nodes);
+  clusters[cluster].distances = std::move(distances);
+}
+
+void ClusterGraph::numberNodes() {
+  firstNodes.resize(clusters.size() + 1);
+  firstNodes[0] = 0;
+  for (std::size_t cluster = 0; cluster < clusters.size(); ++cluster) {
+    firstNodes[cluster + 1] =
+        firstNodes[cluster] + clusters[cluster].nodes.size();
+  }
+}
+
+void ClusterSearch::run(const Maze &maze, const ClusterGraph::Bounds &area,
+                        CellIndex source, bool reverse, CellIndex target) {
+  bounds = area;
+  const int columns = bounds.x1 - bounds.x0;
+  const std::size_t cells = static_cast<std::size_t>(columns) *
+                            static_cast<std::size_t>(bounds.y1 - bounds.y0);
+  costs.assign(cells, ClusterGraph::NO_PATH);
+  parent.resize(cells);
+
+  const std::uint8_t *cellCosts = maze.getCostPlane();
+  const std::uint32_t start = static_cast<std::uint32_t>(local(maze, source));
+  const std::uint32_t goal =
+      target == Maze::NO_CELL ? ~std::uint32_t{0}
+                              : static_cast<std::uint32_t>(local(maze, target));
+  costs[start] = 0;
+  parent[start] = SearchContext::ROOT_PARENT;
+
+  // Visits the in-bounds open neighbors of a local cell
+  auto forEachNeighbor = [&](std::uint32_t cell, auto &&visit) {
+    const int x = bounds.x0 + static_cast<int>(cell % columns);
+    const int y = bounds.y0 + static_cast<int>(cell / columns);
+    const std::uint8_t open = maze.openDirections(x, y);
+    if ((open & Maze::directionBit(Direction::UP)) && y > bounds.y0)
+      visit(cell - columns, Direction::UP);
+    if ((open & Maze::directionBit(Direction::DOWN)) && y + 1 < bounds.y1)
+      visit(cell + columns, Direction::DOWN);
+    if ((open & Maze::directionBit(Direction::LEFT)) && x > bounds.x0)
+      visit(cell - 1, Direction::LEFT);
+    if ((open & Maze::directionBit(Direction::RIGHT)) && x + 1 < bounds.x1)
+      visit(cell + 1, Direction::RIGHT);
+  };
+  auto cellCost = [&](std::uint32_t cell) -> PathCost {
+    if (!cellCosts)
+      return 1;
+    const int x = bounds.x0 + static_cast<int>(cell % columns);
+    const int y = bounds.y0 + static_cast<int>(cell / columns);
+    return cellCosts[maze.indexOf(x, y)];
+  };
+
+  if (!cellCosts) {
+    // Every step costs 1, so cells are final when first reached
+    queue.clear();
+    queue.push_back(start);
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      const std::uint32_t current = queue[head];
+      ++expanded;
+      if (current == goal)
+        return;
+      const PathCost next = costs[current] + 1;
+      forEachNeighbor(current, [&](std::uint32_t neighbor, Direction dir) {
+        if (costs[neighbor] != ClusterGraph::NO_PATH)
+          return;
+        costs[neighbor] = next;
+        parent[neighbor] = SearchContext::oppositeDirection(dir);
+        queue.push_back(neighbor);
+      });
+    }
+    return;
+  }
+
+  // Min-heap on cost, with stale entries skipped when popped
+  auto later = [](const std::pair<PathCost, std::uint32_t> &a,
+                  const std::pair<PathCost, std::uint32_t> &b) {
+    return a.first > b.first;
+  };
+  heap.clear();
+  heap.push_back({0, start});
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    const auto [cost, current] = heap.back();
+    heap.pop_back();
+    if (cost != costs[current])
+      continue;
+    ++expanded;
+    if (current == goal)
+      return;
+    // Forward, a step pays for the cell it enters; in reverse the step runs
+    // from the neighbor into the current cell
+    const PathCost reverseStep = reverse ? cellCost(current) : 0;
+    forEachNeighbor(current, [&](std::uint32_t neighbor, Direction dir) {
+      const PathCost next =
+          cost + (reverse ? reverseStep : cellCost(neighbor));
+      if (next >= costs[neighbor])
+        return;
+      costs[neighbor] = next;
+      parent[neighbor] = SearchContext::oppositeDirection(dir);
+      heap.push_back({next, neighbor});
+      std::push_heap(heap.begin(), heap.end(), later);
+    });
+  }
+}
+
+PathCost ClusterSearch::cost(const Maze &maze, CellIndex cell) const {
+  return costs[local(maze, cell)];
+}
+
+void ClusterSearch::appendPath(const Maze &maze, CellIndex target,
+                               std::vector<CellIndex> &path) const {
+  const std::size_t first = path.size();
+  CellIndex cell = target;
+  std::uint8_t dir = parent[local(maze, cell)];
+  while (dir != SearchContext::ROOT_PARENT) {
+    path.push_back(cell);
+    cell = maze.neighborIndex(cell, static_cast<Direction>(dir));
+    dir = parent[local(maze, cell)];
+  }
+  std::reverse(path.begin() + static_cast<std::ptrdiff_t>(first), path.end());
+}
+
+std::size_t ClusterSearch::local(const Maze &maze, CellIndex cell) const {
+  const Coordinate coords = maze.coordsOf(cell);
+  return static_cast<std::size_t>(coords.y - bounds.y0) *
+             static_cast<std::size_t>(bounds.x1 - bounds.x0) +
+         static_cast<std::size_t>(coords.x - bounds.x0);
+}
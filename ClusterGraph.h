@@ -0,0 +1,272 @@
+#ifndef CLUSTER_GRAPH_H
+#define CLUSTER_GRAPH_H
+
+#include "Maze.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class ClusterSearch;
+
+/**
+ * @brief Abstract graph of a maze for HPA* (see HPAStarPathfinder).
+ *
+ * The maze is cut into square clusters of a fixed size. Where a border
+ * between two clusters has a run of open cells on both sides, the run is an
+ * entrance: runs shorter than LONG_ENTRANCE get one transition in their
+ * middle, longer ones one at each end. The cells on either side of a
+ * transition are the nodes of their clusters.
+ *
+ * For each cluster the graph caches the cost of the cheapest path between
+ * every pair of its nodes that stays inside the cluster. Moving between two
+ * adjacent nodes of different clusters costs the terrain cost of the cell
+ * entered, which is read from the maze at query time.
+ *
+ * Every cluster is built from the maze alone, so after a wall or cost
+ * change only the clusters around the changed cell have to be rebuilt (see
+ * update()). The graph records the maze's wall and cost versions
+ * (Maze::getWallVersion() and getCostVersion()) as of its last build or
+ * update, so isCurrent() tells in O(1) whether a change has not been passed
+ * on yet. The graph is 4-connected.
+ */
+class ClusterGraph {
+public:
+  /**
+   * @brief Cost reported for pairs of nodes with no path inside a cluster.
+   */
+  static constexpr PathCost NO_PATH = ~PathCost{0};
+
+  /**
+   * @brief Entrances of at least this many cells get two transitions.
+   */
+  static constexpr int LONG_ENTRANCE = 6;
+
+  /**
+   * @brief The cells of a cluster: x0 <= x < x1 and y0 <= y < y1.
+   */
+  struct Bounds {
+    int x0, y0, x1, y1;
+
+    bool contains(int x, int y) const {
+      return x >= x0 && x < x1 && y >= y0 && y < y1;
+    }
+  };
+
+  /**
+   * @brief Construct an empty graph; see build().
+   */
+  ClusterGraph();
+
+  /**
+   * @brief Construct the graph of a maze.
+   * @param maze The maze to abstract.
+   * @param clusterSize The width and height of a cluster, in cells.
+   * @throws std::invalid_argument if clusterSize is below 2.
+   */
+  explicit ClusterGraph(const Maze &maze, int clusterSize = 32);
+
+  /**
+   * @brief Build the graph of a maze, replacing any graph held.
+   *
+   * Runs one search inside the cluster from every node, so building takes
+   * about O(cells * nodes per cluster).
+   *
+   * @param maze The maze to abstract.
+   * @param clusterSize The width and height of a cluster, in cells.
+   * @throws std::invalid_argument if clusterSize is below 2.
+   */
+  void build(const Maze &maze, int clusterSize = 32);
+
+  /**
+   * @brief Bring the graph up to date after a wall or cost change.
+   *
+   * Rebuilds the cluster holding the cell and, if the cell lies on the edge
+   * of its cluster, the clusters across that edge, whose entrances depend
+   * on it. All other clusters are kept. Call it for every changed cell;
+   * the graph takes the maze's current versions, so isCurrent() holds again
+   * after the last one.
+   *
+   * @param maze The changed maze (same size as the one the graph was built
+   * for).
+   * @param x The x-coordinate of the changed cell.
+   * @param y The y-coordinate of the changed cell.
+   * @return The number of clusters rebuilt.
+   * @throws std::invalid_argument if the maze has a different size.
+   */
+  std::size_t update(const Maze &maze, int x, int y);
+
+  /**
+   * @brief Check whether the graph was built for a maze of this size. The
+   * walls are not compared.
+   */
+  bool matches(const Maze &maze) const {
+    return maze.getWidth() == width && maze.getHeight() == height;
+  }
+
+  /**
+   * @brief Check whether the graph was built or updated for this maze and
+   * its walls and costs have not been edited since.
+   */
+  bool isCurrent(const Maze &maze) const {
+    return matches(maze) && maze.getWallVersion() == walls &&
+           maze.getCostVersion() == costs;
+  }
+
+  /**
+   * @brief Get the width and height of a cluster, in cells.
+   */
+  int getClusterSize() const { return clusterSize; }
+
+  /**
+   * @brief Get the cluster holding a cell.
+   * @param x The x-coordinate (must be valid).
+   * @param y The y-coordinate (must be valid).
+   */
+  std::size_t clusterOf(int x, int y) const {
+    return static_cast<std::size_t>(y / clusterSize) *
+               static_cast<std::size_t>(clustersX) +
+           static_cast<std::size_t>(x / clusterSize);
+  }
+
+  /**
+   * @brief Get the cells of a cluster.
+   */
+  Bounds getBounds(std::size_t cluster) const;
+
+  /**
+   * @brief Get the nodes of a cluster, as ascending cell indices.
+   */
+  const std::vector<CellIndex> &getNodes(std::size_t cluster) const {
+    return clusters[cluster].nodes;
+  }
+
+  /**
+   * @brief Get the number of the first node of a cluster.
+   *
+   * Nodes are numbered from 0 to getNodeCount() - 1, cluster by cluster, so
+   * the nodes of a cluster have consecutive numbers in the order of
+   * getNodes(). Numbers change when update() changes a cluster's nodes.
+   */
+  std::size_t getFirstNode(std::size_t cluster) const {
+    return firstNodes[cluster];
+  }
+
+  /**
+   * @brief Find a cell among the nodes of its cluster.
+   * @param cluster The cluster holding the cell.
+   * @param cell The cell index.
+   * @return The position of the cell in getNodes(cluster), or -1.
+   */
+  int findNode(std::size_t cluster, CellIndex cell) const;
+
+  /**
+   * @brief Get the cost of the cheapest path between two nodes of a cluster
+   * that stays inside it.
+   *
+   * The cost counts the terrain cost of every cell on the path, both ends
+   * included, so it is the same in either direction. A search moving from
+   * node i to node j pays this minus the cost of node i.
+   *
+   * @param cluster The cluster.
+   * @param i Position of one node in getNodes(cluster).
+   * @param j Position of another node in getNodes(cluster).
+   * @return The cost, or NO_PATH if there is no such path.
+   */
+  PathCost distance(std::size_t cluster, int i, int j) const;
+
+  /**
+   * @brief Get the number of clusters.
+   */
+  std::size_t getClusterCount() const { return clusters.size(); }
+
+  /**
+   * @brief Get the number of nodes in all clusters.
+   */
+  std::size_t getNodeCount() const { return firstNodes.back(); }
+
+  /**
+   * @brief Get the memory held by the graph in bytes.
+   */
+  std::size_t getMemoryBytes() const;
+
+private:
+  struct Cluster {
+    std::vector<CellIndex> nodes;    // Entrance cells, ascending
+    std::vector<PathCost> distances; // distance(i, j) for i < j, row by row
+  };
+
+  // Find the nodes of a cluster and the distances between them
+  void buildCluster(const Maze &maze, std::size_t cluster,
+                    ClusterSearch &search);
+
+  // Number the nodes after the node count of a cluster changed
+  void numberNodes();
+
+  int width;
+  int height;
+  int clusterSize;
+  int clustersX; // Clusters per row
+  int clustersY; // Clusters per column
+  Maze::WallVersion walls; // Maze::getWallVersion() at the last build/update
+  Maze::WallVersion costs; // Maze::getCostVersion() likewise
+  std::vector<Cluster> clusters;
+  std::vector<std::size_t> firstNodes; // Per cluster, then the node count
+};
+
+/**
+ * @brief Shortest paths inside one cluster, for building a ClusterGraph and
+ * for connecting and refining HPA* queries.
+ *
+ * Runs Dijkstra's algorithm (a breadth-first search on mazes without
+ * terrain costs) over the open cells of the cluster, on buffers sized for
+ * one cluster and kept between runs.
+ */
+class ClusterSearch {
+public:
+  /**
+   * @brief Search a cluster from a source cell.
+   * @param maze The maze.
+   * @param bounds The cluster; the search does not leave it.
+   * @param source The cell to search from (inside the bounds).
+   * @param reverse false to find the cost of moving from the source to each
+   * cell, true for the cost of moving from each cell to the source.
+   * @param target A cell at which to stop once its cost is known, or
+   * Maze::NO_CELL to reach every cell.
+   */
+  void run(const Maze &maze, const ClusterGraph::Bounds &bounds,
+           CellIndex source, bool reverse, CellIndex target = Maze::NO_CELL);
+
+  /**
+   * @brief Get the cost found for a cell by the last run.
+   * @param maze The maze.
+   * @param cell A cell inside the bounds of the last run.
+   * @return The cost, or ClusterGraph::NO_PATH if the cell was not reached.
+   */
+  PathCost cost(const Maze &maze, CellIndex cell) const;
+
+  /**
+   * @brief Append the path found by a forward run to a cell.
+   * @param maze The maze.
+   * @param target A cell reached by the last run (which must be forward).
+   * @param path Receives the cells after the source, up to the target.
+   */
+  void appendPath(const Maze &maze, CellIndex target,
+                  std::vector<CellIndex> &path) const;
+
+  /**
+   * @brief Get the number of cells expanded by all runs so far.
+   */
+  std::uint64_t getExpanded() const { return expanded; }
+
+private:
+  std::size_t local(const Maze &maze, CellIndex cell) const;
+
+  ClusterGraph::Bounds bounds{0, 0, 0, 0};
+  std::vector<PathCost> costs;      // Per cell of the bounds
+  std::vector<std::uint8_t> parent; // Direction back to the parent
+  std::vector<std::uint32_t> queue; // Breadth-first queue, local cells
+  std::vector<std::pair<PathCost, std::uint32_t>> heap; // Dijkstra queue
+  std::uint64_t expanded = 0;
+};
+
+#endif // CLUSTER_GRAPH_H
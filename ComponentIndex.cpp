@@ -0,0 +1,226 @@
+#include "ComponentIndex.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+ComponentIndex::ComponentIndex() : width(0), height(0), componentCount(0) {}
+
+ComponentIndex::ComponentIndex(const Maze &maze) : ComponentIndex() {
+  build(maze);
+}
+
+void ComponentIndex::build(const Maze &maze) {
+  const int w = maze.getWidth();
+  const int h = maze.getHeight();
+  const std::size_t cellCount = static_cast<std::size_t>(maze.getCellCount());
+  std::vector<std::uint32_t> cellLabels(cellCount, NO_LABEL);
+
+  // First scan: each open cell takes the provisional label of the open cell
+  // above or to its left, and labels that meet are united
+  std::vector<std::uint32_t> parent(1, NO_LABEL);
+  auto find = [&](std::uint32_t label) {
+    while (parent[label] != label) {
+      parent[label] = parent[parent[label]];
+      label = parent[label];
+    }
+    return label;
+  };
+  for (int y = 0; y < h; ++y) {
+    for (int x = 0; x < w; ++x) {
+      if (maze.isWall(x, y))
+        continue;
+      const CellIndex cell = maze.indexOf(x, y);
+      const std::uint32_t up =
+          y > 0 ? cellLabels[cell - static_cast<CellIndex>(w)] : NO_LABEL;
+      const std::uint32_t left = x > 0 ? cellLabels[cell - 1] : NO_LABEL;
+      if (up == NO_LABEL && left == NO_LABEL) {
+        cellLabels[cell] = static_cast<std::uint32_t>(parent.size());
+        parent.push_back(cellLabels[cell]);
+      } else if (up == NO_LABEL || left == NO_LABEL) {
+        cellLabels[cell] = up | left;
+      } else {
+        const std::uint32_t a = find(up);
+        const std::uint32_t b = find(left);
+        parent[std::max(a, b)] = std::min(a, b);
+        cellLabels[cell] = std::min(a, b);
+      }
+    }
+  }
+
+  // Second scan: number the united labels from 1 in order of appearance
+  std::vector<std::uint32_t> numbers(parent.size(), NO_LABEL);
+  std::vector<std::uint64_t> counts(1, 0);
+  for (std::size_t i = 0; i < cellCount; ++i) {
+    if (cellLabels[i] == NO_LABEL)
+      continue;
+    std::uint32_t &label = numbers[find(cellLabels[i])];
+    if (label == NO_LABEL) {
+      label = static_cast<std::uint32_t>(counts.size());
+      counts.push_back(0);
+    }
+    cellLabels[i] = label;
+    ++counts[label];
+  }
+
+  width = w;
+  height = h;
+  componentCount = counts.size() - 1;
+  labels.swap(cellLabels);
+  sizes.swap(counts);
+  freeLabels.clear();
+  std::vector<std::uint8_t>().swap(owners);
+  touched.clear();
+}
+
+std::uint32_t ComponentIndex::newLabel() {
+  ++componentCount;
+  if (!freeLabels.empty()) {
+    const std::uint32_t label = freeLabels.back();
+    freeLabels.pop_back();
+    return label;
+  }
+  sizes.push_back(0);
+  return static_cast<std::uint32_t>(sizes.size() - 1);
+}
+
+void ComponentIndex::update(const Maze &maze, int x, int y) {
+  if (!matches(maze)) {
+    throw std::invalid_argument(
+        "Component index was not built for this maze");
+  }
+  const CellIndex cell = maze.indexOf(x, y);
+  const bool wall = maze.isWall(x, y);
+  if (wall == (labels[cell] == NO_LABEL))
+    return;
+
+  if (wall) {
+    const std::uint32_t label = labels[cell];
+    labels[cell] = NO_LABEL;
+    if (--sizes[label] == 0) {
+      freeLabels.push_back(label);
+      --componentCount;
+    } else {
+      split(maze, cell, label);
+    }
+    return;
+  }
+
+  // An opened cell joins the largest region around it, and the others are
+  // relabeled into it
+  std::uint32_t keep = NO_LABEL;
+  maze.forEachNeighbor(cell, [&](CellIndex neighbor, Direction) {
+    if (keep == NO_LABEL || sizes[labels[neighbor]] > sizes[keep])
+      keep = labels[neighbor];
+  });
+  if (keep == NO_LABEL)
+    keep = newLabel();
+  labels[cell] = keep;
+  ++sizes[keep];
+  maze.forEachNeighbor(cell, [&](CellIndex neighbor, Direction) {
+    const std::uint32_t other = labels[neighbor];
+    if (other == keep)
+      return;
+    sizes[keep] += sizes[other];
+    sizes[other] = 0;
+    freeLabels.push_back(other);
+    --componentCount;
+    relabel(maze, neighbor, keep);
+  });
+}
+
+void ComponentIndex::relabel(const Maze &maze, CellIndex from,
+                             std::uint32_t label) {
+  const std::uint32_t old = labels[from];
+  labels[from] = label;
+  std::vector<CellIndex> queue{from};
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    maze.forEachNeighbor(queue[head], [&](CellIndex neighbor, Direction) {
+      if (labels[neighbor] == old) {
+        labels[neighbor] = label;
+        queue.push_back(neighbor);
+      }
+    });
+  }
+}
+
+void ComponentIndex::split(const Maze &maze, CellIndex removed,
+                           std::uint32_t label) {
+  // One search per open neighbor of the removed cell
+  CellIndex seeds[4];
+  int count = 0;
+  maze.forEachNeighbor(removed, [&](CellIndex neighbor, Direction) {
+    seeds[count++] = neighbor;
+  });
+  if (count < 2)
+    return;
+
+  if (owners.size() != labels.size())
+    owners.assign(labels.size(), 0);
+  std::vector<CellIndex> queues[4];
+  std::size_t heads[4] = {};
+  int groups[4]; // Searches that met share a group
+  bool done[4] = {};
+  auto group = [&](int search) {
+    while (groups[search] != search)
+      search = groups[search];
+    return search;
+  };
+  for (int i = 0; i < count; ++i) {
+    groups[i] = i;
+    owners[seeds[i]] = static_cast<std::uint8_t>(i + 1);
+    touched.push_back(seeds[i]);
+    queues[i].push_back(seeds[i]);
+  }
+
+  // Expand one cell per search in turn. Searches that meet are in the same
+  // part; a group whose searches have all run out is a part of its own.
+  int open = count;
+  while (open > 1) {
+    for (int i = 0; i < count; ++i) {
+      if (heads[i] == queues[i].size())
+        continue;
+      maze.forEachNeighbor(queues[i][heads[i]++], [&](CellIndex neighbor,
+                                                      Direction) {
+        if (owners[neighbor] == 0) {
+          owners[neighbor] = static_cast<std::uint8_t>(i + 1);
+          touched.push_back(neighbor);
+          queues[i].push_back(neighbor);
+          return;
+        }
+        const int a = group(i);
+        const int b = group(owners[neighbor] - 1);
+        if (a != b) {
+          groups[std::max(a, b)] = std::min(a, b);
+          --open;
+        }
+      });
+    }
+
+    for (int g = 0; g < count && open > 1; ++g) {
+      if (done[g] || group(g) != g)
+        continue;
+      bool exhausted = true;
+      for (int i = 0; i < count; ++i) {
+        if (group(i) == g && heads[i] != queues[i].size())
+          exhausted = false;
+      }
+      if (!exhausted)
+        continue;
+      // Split this part off under a new label
+      const std::uint32_t part = newLabel();
+      for (CellIndex cell : touched) {
+        if (group(owners[cell] - 1) == g) {
+          labels[cell] = part;
+          ++sizes[part];
+        }
+      }
+      sizes[label] -= sizes[part];
+      done[g] = true;
+      --open;
+    }
+  }
+
+  for (CellIndex cell : touched)
+    owners[cell] = 0;
+  touched.clear();
+}
@@ -0,0 +1,131 @@
+#ifndef COMPONENT_INDEX_H
+#define COMPONENT_INDEX_H
+
+#include "Maze.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Connected-component labels of a maze's open cells, for rejecting
+ * queries between unconnected cells without a search.
+ *
+ * Every open cell carries the 32-bit label of its 4-connected region, and
+ * walls carry NO_LABEL. Two open cells are connected exactly if their
+ * labels are equal. A search from one region to another would otherwise
+ * flood the whole start region before giving up. Set the index on a
+ * SearchContext (SearchContext::setComponents()) and every pathfinder
+ * returns no path for such queries at once.
+ *
+ * Labels are built in two row-major scans with union-find over provisional
+ * labels, then numbered 1 to getComponentCount(). After a single wall
+ * change, update() relabels only what changed. Opening a cell merges the
+ * regions around it, relabeling all but the largest. Closing one runs
+ * breadth-first searches from its open neighbors, in turn, until they meet
+ * or one runs out; a region that ran out is split off under a new label.
+ * Either way the work is proportional to the smaller regions involved, not
+ * to the maze.
+ */
+class ComponentIndex {
+public:
+  /**
+   * @brief Label of wall cells.
+   */
+  static constexpr std::uint32_t NO_LABEL = 0;
+
+  /**
+   * @brief Construct an empty index; see build().
+   */
+  ComponentIndex();
+
+  /**
+   * @brief Construct the index of a maze.
+   * @param maze The maze to label.
+   */
+  explicit ComponentIndex(const Maze &maze);
+
+  /**
+   * @brief Label a maze, replacing any labels held. Takes O(cells).
+   * @param maze The maze to label.
+   */
+  void build(const Maze &maze);
+
+  /**
+   * @brief Bring the labels up to date after the wall of one cell changed.
+   * Does nothing if the cell's wall matches its label.
+   * @param maze The maze, with the cell already changed.
+   * @param x The x-coordinate of the cell.
+   * @param y The y-coordinate of the cell.
+   * @throws std::invalid_argument if the index was built for a maze of a
+   * different size.
+   */
+  void update(const Maze &maze, int x, int y);
+
+  /**
+   * @brief Check whether the index was built for a maze of this size. The
+   * walls are not compared.
+   */
+  bool matches(const Maze &maze) const {
+    return maze.getWidth() == width && maze.getHeight() == height;
+  }
+
+  /**
+   * @brief Get the label of a cell.
+   * @param cell The cell index (must be a cell of the index's maze).
+   * @return The label of its region, or NO_LABEL for a wall.
+   */
+  std::uint32_t getLabel(CellIndex cell) const { return labels[cell]; }
+
+  /**
+   * @brief Check whether two open cells are connected.
+   * @param a The cell index of an open cell.
+   * @param b The cell index of an open cell.
+   */
+  bool connected(CellIndex a, CellIndex b) const {
+    return labels[a] == labels[b];
+  }
+
+  /**
+   * @brief Get the number of regions of open cells.
+   */
+  std::uint64_t getComponentCount() const { return componentCount; }
+
+  /**
+   * @brief Get the number of cells in a region.
+   * @param label A label in use.
+   */
+  std::uint64_t getComponentSize(std::uint32_t label) const {
+    return sizes[label];
+  }
+
+  /**
+   * @brief Get the size of the labels in bytes.
+   */
+  std::size_t getMemoryBytes() const {
+    return labels.capacity() * sizeof(std::uint32_t) +
+           sizes.capacity() * sizeof(std::uint64_t);
+  }
+
+private:
+  // Take an unused label for a new region
+  std::uint32_t newLabel();
+
+  // Give every cell of a region, reached from a cell, a new label
+  void relabel(const Maze &maze, CellIndex from, std::uint32_t label);
+
+  // Split the region a cell was removed from, if it came apart
+  void split(const Maze &maze, CellIndex removed, std::uint32_t label);
+
+  int width;
+  int height;
+  std::uint64_t componentCount;
+  std::vector<std::uint32_t> labels;     // Per cell
+  std::vector<std::uint64_t> sizes;      // Cells per label, 0 if unused
+  std::vector<std::uint32_t> freeLabels; // Labels whose region vanished
+
+  // Scratch for update(): the search that reached each cell (0 if none)
+  // and the cells to clear afterwards
+  std::vector<std::uint8_t> owners;
+  std::vector<CellIndex> touched;
+};
+
+#endif // COMPONENT_INDEX_H
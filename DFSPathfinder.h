@@ -3,8 +3,6 @@
 
 #include "Maze.h"
 #include "PathFinder.h"
-#include <map>
-#include <stack>
 
 /**
  * @brief Depth-First Search pathfinding algorithm implementation.
@@ -14,18 +12,23 @@
  */
 class DFSPathfinder : public PathFinder {
 public:
+  using PathFinder::findPath;
+
   /**
    * @brief Find a path from start to goal using DFS.
    * @param maze The maze to search.
+   * @param context The per-query state to use.
    * @param start The starting cell.
    * @param goal The goal cell.
    * @param onVisit Optional callback for animation (default: nullptr).
    * @return A vector of cells representing the path, or empty if no path
    * exists.
    */
-  std::vector<Cell> findPath(
-      const Maze &maze, std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
-      std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr) override;
+  std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const override;
 };
 
 #endif // DFS_PATHFINDER_H
@@ -1,96 +1,129 @@
 #include "DijkstraPathfinder.h"
+
 #include <algorithm>
 #include <chrono>
-#include <set>
 
-std::vector<Cell> DijkstraPathfinder::findPath(
-    const Maze &maze, std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
-    std::function<void(std::shared_ptr<Cell>)> onVisit) {
-  auto startTime = std::chrono::high_resolution_clock::now();
+namespace {
 
-  // Initialize
-  path.clear();
-  stats = {};
-
-  if (!start || !goal) {
-    return path;
+// The cells a one-to-many search waits for. Expanded cells are first
+// checked against a 4096-bit filter on their low index bits, so most are
+// ruled out by one load; the rest by a binary search of the sorted targets.
+class TargetSet {
+public:
+  void add(CellIndex cell) {
+    cells.push_back(cell);
+    filter[(cell >> 6) & 63] |= std::uint64_t{1} << (cell & 63);
   }
 
-  // Priority queue for Dijkstra's (min-heap)
-  std::priority_queue<Node, std::vector<Node>, std::greater<Node>> pq;
-
-  // Map to track costs to reach each cell
-  std::map<std::shared_ptr<Cell>, double> cost;
-
-  // Map to track parent cells for path reconstruction
-  std::map<std::shared_ptr<Cell>, std::shared_ptr<Cell>> parent;
+  // Drop repeats; call once all targets are added
+  void seal() {
+    std::sort(cells.begin(), cells.end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+    remaining = cells.size();
+  }
 
-  // Set to track visited cells
-  std::set<std::shared_ptr<Cell>> visited;
+  bool empty() const { return cells.empty(); }
 
-  // Initialize start
-  cost[start] = 0.0;
-  parent[start] = nullptr;
-  pq.push({start, 0.0});
-  stats.nodesExplored = 0;
+  // Note a settled cell; true once every target is settled
+  bool settle(CellIndex cell) {
+    if (!((filter[(cell >> 6) & 63] >> (cell & 63)) & 1))
+      return false;
+    if (!std::binary_search(cells.begin(), cells.end(), cell))
+      return false;
+    return --remaining == 0;
+  }
 
-  bool found = false;
+private:
+  std::vector<CellIndex> cells;
+  std::uint64_t filter[64] = {};
+  std::size_t remaining = 0;
+};
+
+template <typename Policy>
+void sweepTo(const Maze &maze, SearchContext &context, CellIndex start,
+             TargetSet &targets) {
+  SearchEngine<Policy> engine;
+  engine.sweep(maze, context, start,
+               [&](CellIndex cell) { return targets.settle(cell); });
+}
 
-  // Dijkstra's main loop
-  while (!pq.empty() && !found) {
-    Node current = pq.top();
-    pq.pop();
+} // namespace
 
-    // Skip if already visited
-    if (visited.find(current.cell) != visited.end()) {
-      continue;
-    }
+DijkstraPathfinder::DijkstraPathfinder(OpenList openList)
+    : openList(openList) {}
 
-    visited.insert(current.cell);
-    current.cell->setVisited(true);
-    stats.nodesExplored++;
+std::vector<Cell> DijkstraPathfinder::findPath(
+    const Maze &maze, SearchContext &context, std::shared_ptr<Cell> start,
+    std::shared_ptr<Cell> goal,
+    std::function<void(std::shared_ptr<Cell>)> onVisit) const {
+  // Open list ordered by the cost from the start
+  if (openList == OpenList::BUCKETS) {
+    return runEngine<BucketPolicy<ZeroHeuristic>>(maze, context, start, goal,
+                                                  onVisit);
+  }
+  return runEngine<HeapPolicy<ZeroHeuristic>>(maze, context, start, goal,
+                                              onVisit);
+}
 
-    // Call animation callback if provided
-    if (onVisit) {
-      onVisit(current.cell);
-    }
+std::vector<PathCost> DijkstraPathfinder::distancesTo(
+    const Maze &maze, SearchContext &context,
+    const std::shared_ptr<Cell> &start,
+    const std::vector<std::shared_ptr<Cell>> &targets,
+    std::vector<std::vector<Cell>> *paths) const {
+  auto startTime = std::chrono::high_resolution_clock::now();
 
-    // Check if we reached the goal
-    if (*current.cell == *goal) {
-      found = true;
-      break;
+  context.begin(maze);
+  std::vector<PathCost> distances(targets.size(), NO_PATH);
+  if (paths)
+    paths->assign(targets.size(), std::vector<Cell>());
+
+  if (start) {
+    const CellIndex startIndex = maze.indexOf(start->getX(), start->getY());
+    TargetSet pending;
+    for (const auto &target : targets) {
+      if (!target)
+        continue;
+      const CellIndex index = maze.indexOf(target->getX(), target->getY());
+      if (!isUnreachable(maze, context, startIndex, index))
+        pending.add(index);
     }
-
-    // Explore neighbors
-    auto neighbors = maze.getNeighbors(current.cell);
-    for (auto &neighbor : neighbors) {
-      if (visited.find(neighbor) == visited.end()) {
-        double newCost = current.cost + 1.0; // Uniform cost of 1 per move
-
-        // If we found a better path to this neighbor
-        if (cost.find(neighbor) == cost.end() || newCost < cost[neighbor]) {
-          cost[neighbor] = newCost;
-          parent[neighbor] = current.cell;
-          pq.push({neighbor, newCost});
-        }
+    pending.seal();
+
+    if (!pending.empty()) {
+      if (openList == OpenList::BUCKETS) {
+        sweepTo<BucketPolicy<ZeroHeuristic>>(maze, context, startIndex,
+                                             pending);
+      } else {
+        sweepTo<HeapPolicy<ZeroHeuristic>>(maze, context, startIndex,
+                                           pending);
       }
     }
-  }
 
-  // Reconstruct path if found
-  if (found) {
-    auto current = goal;
-    while (current != nullptr) {
-      path.push_back(*current);
-      current = parent[current];
+    // The search ran until every target was settled, or it ran out of
+    // cells, so every target it reached has its final cost
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+      if (!targets[i])
+        continue;
+      const CellIndex index =
+          maze.indexOf(targets[i]->getX(), targets[i]->getY());
+      if (!context.isVisited(index))
+        continue;
+      distances[i] = context.getCost(index);
+      if (paths) {
+        context.getPath().clear();
+        reconstructPath(maze, context, startIndex, index);
+        (*paths)[i] = context.getPath();
+      }
     }
-    std::reverse(path.begin(), path.end());
-    stats.pathLength = path.size();
   }
 
+  context.getPath().clear();
+  PathStats &stats = context.getStats();
+  stats.pathLength = 0;
+  stats.pathCost = 0;
   auto endTime = std::chrono::high_resolution_clock::now();
   stats.executionTime =
       std::chrono::duration<double, std::milli>(endTime - startTime);
 
-  return path;
+  return distances;
 }
@@ -3,41 +3,75 @@
 
 #include "Maze.h"
 #include "PathFinder.h"
-#include <limits>
-#include <map>
-#include <queue>
 
 /**
  * @brief Dijkstra's pathfinding algorithm implementation.
  *
  * Dijkstra's algorithm finds the shortest path in a weighted graph.
  * For uniform cost (all edges have weight 1), it behaves similarly to BFS.
+ * Moves cost the terrain cost of the cell entered (Maze::getCost()).
+ *
+ * distancesTo() answers one-to-many queries: one search from the start
+ * settles cells in order of cost and stops once every target is settled,
+ * instead of one findPath() per target re-exploring the same region.
  */
 class DijkstraPathfinder : public PathFinder {
 public:
+  using PathFinder::findPath;
+
+  /**
+   * @brief Distance reported by distancesTo() for unreachable targets.
+   */
+  static constexpr PathCost NO_PATH = ~PathCost{0};
+
+  /**
+   * @brief Construct a Dijkstra pathfinder.
+   * @param openList The open list to use (default: binary heap). BUCKETS
+   * gives the same path costs with O(1) queue operations.
+   */
+  explicit DijkstraPathfinder(OpenList openList = OpenList::BINARY_HEAP);
+
   /**
    * @brief Find a path from start to goal using Dijkstra's algorithm.
    * @param maze The maze to search.
+   * @param context The per-query state to use.
    * @param start The starting cell.
    * @param goal The goal cell.
    * @param onVisit Optional callback for animation (default: nullptr).
    * @return A vector of cells representing the path, or empty if no path
    * exists.
    */
-  std::vector<Cell> findPath(
-      const Maze &maze, std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
-      std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr) override;
+  std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const override;
 
-private:
   /**
-   * @brief Node structure for priority queue.
+   * @brief Find the cost of the cheapest path from a start to each of
+   * several targets, in one search.
+   *
+   * The search stops as soon as every target is settled. Targets that the
+   * context's ComponentIndex (if any) places in another region are not
+   * waited for. stats.nodesExplored counts the cells expanded; the
+   * context's path is left empty.
+   *
+   * @param maze The maze to search.
+   * @param context The per-query state to use.
+   * @param start The starting cell.
+   * @param targets The target cells, in any order; repeats are allowed.
+   * @param paths If not nullptr, receives the path to each target, in the
+   * order of targets (empty if unreachable).
+   * @return The cost to each target, in the order of targets, or NO_PATH.
    */
-  struct Node {
-    std::shared_ptr<Cell> cell;
-    double cost;
+  std::vector<PathCost>
+  distancesTo(const Maze &maze, SearchContext &context,
+              const std::shared_ptr<Cell> &start,
+              const std::vector<std::shared_ptr<Cell>> &targets,
+              std::vector<std::vector<Cell>> *paths = nullptr) const;
 
-    bool operator>(const Node &other) const { return cost > other.cost; }
-  };
+private:
+  OpenList openList;
 };
 
 #endif // DIJKSTRA_PATHFINDER_H
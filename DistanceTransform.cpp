@@ -0,0 +1,192 @@
+#include "DistanceTransform.h"
+
+#include "ComponentIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// The multi-source search behind build() and nearestSource(). The state
+// stores what is reached: root(cell, number) seeds a source (false for a
+// repeat), relax(cell, from, step, cost) records a cheaper way to a cell,
+// cost(cell) reads it back, and settle(cell) is called for each expanded
+// cell and returns true to stop.
+//
+// The search walks edges backwards, from the sources out: a cell reached
+// from a neighbor pays for entering the neighbor.
+template <typename State>
+void spread(const Maze &maze, const std::vector<CellIndex> &sources,
+            State &state) {
+  const std::uint8_t *costs = maze.getCostPlane();
+  std::vector<CellIndex> queue;
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    const Coordinate coords = maze.coordsOf(sources[i]);
+    if (!maze.isWall(coords.x, coords.y) &&
+        state.root(sources[i], static_cast<std::uint32_t>(i)))
+      queue.push_back(sources[i]);
+  }
+
+  if (!costs) {
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      const CellIndex cell = queue[head];
+      if (state.settle(cell))
+        return;
+      const PathCost next = state.cost(cell) + 1;
+      maze.forEachNeighbor(cell, [&](CellIndex neighbor, Direction step) {
+        if (state.relax(neighbor, cell, step, next))
+          queue.push_back(neighbor);
+      });
+    }
+    return;
+  }
+
+  using Entry = std::pair<PathCost, CellIndex>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  for (CellIndex source : queue)
+    open.push({0, source});
+  while (!open.empty()) {
+    const Entry top = open.top();
+    open.pop();
+    if (top.first != state.cost(top.second))
+      continue;
+    if (state.settle(top.second))
+      return;
+    const PathCost next = top.first + costs[top.second];
+    maze.forEachNeighbor(top.second, [&](CellIndex neighbor, Direction step) {
+      if (state.relax(neighbor, top.second, step, next))
+        open.push({next, neighbor});
+    });
+  }
+}
+
+} // namespace
+
+DistanceTransform::DistanceTransform() : width(0), height(0), maxDistance(0) {}
+
+DistanceTransform::DistanceTransform(const Maze &maze,
+                                     const std::vector<CellIndex> &sources)
+    : DistanceTransform() {
+  build(maze, sources);
+}
+
+void DistanceTransform::build(const Maze &maze,
+                              const std::vector<CellIndex> &sources) {
+  const std::size_t cellCount = static_cast<std::size_t>(maze.getCellCount());
+  width = maze.getWidth();
+  height = maze.getHeight();
+  maxDistance = 0;
+  nearest.assign(cellCount, NO_SOURCE);
+  distances.assign(cellCount, UNREACHABLE);
+
+  // A cell takes the source of the neighbor it is reached from
+  struct Arrays {
+    std::vector<std::uint32_t> &nearest;
+    std::vector<PathCost> &distances;
+    PathCost &maxDistance;
+
+    bool root(CellIndex cell, std::uint32_t number) {
+      if (distances[cell] == 0)
+        return false;
+      distances[cell] = 0;
+      nearest[cell] = number;
+      return true;
+    }
+    bool relax(CellIndex cell, CellIndex from, Direction, PathCost cost) {
+      if (cost >= distances[cell])
+        return false;
+      distances[cell] = cost;
+      nearest[cell] = nearest[from];
+      return true;
+    }
+    PathCost cost(CellIndex cell) const { return distances[cell]; }
+    bool settle(CellIndex cell) {
+      maxDistance = std::max(maxDistance, distances[cell]);
+      return false;
+    }
+  } state{nearest, distances, maxDistance};
+  spread(maze, sources, state);
+}
+
+std::uint32_t
+DistanceTransform::nearestSource(const Maze &maze, SearchContext &context,
+                                 const std::vector<CellIndex> &sources,
+                                 CellIndex start) {
+  if (context.getMovement().connectivity != Connectivity::FOUR) {
+    throw std::invalid_argument(
+        "Nearest-source search supports only 4-connected movement");
+  }
+  auto startTime = std::chrono::high_resolution_clock::now();
+
+  context.begin(maze);
+  context.reserveCosts();
+  std::uint32_t number = NO_SOURCE;
+  const Coordinate coords = maze.coordsOf(start);
+  bool reachable = !maze.isWall(coords.x, coords.y);
+
+  // With component labels, a start whose region holds no source is done
+  const ComponentIndex *components = context.getComponents();
+  if (reachable && components) {
+    if (!components->matches(maze)) {
+      throw std::invalid_argument(
+          "Component index was not built for this maze");
+    }
+    reachable = std::any_of(
+        sources.begin(), sources.end(), [&](CellIndex source) {
+          return components->getLabel(source) == components->getLabel(start);
+        });
+  }
+
+  if (reachable) {
+    // Parents point towards the source each cell was reached from
+    struct Marks {
+      SearchContext &context;
+      CellIndex start;
+
+      bool root(CellIndex cell, std::uint32_t) {
+        return context.relax(cell, 0, SearchContext::ROOT_PARENT);
+      }
+      bool relax(CellIndex cell, CellIndex, Direction step, PathCost cost) {
+        return context.relax(cell, cost,
+                             SearchContext::oppositeDirection(step));
+      }
+      PathCost cost(CellIndex cell) const { return context.getCost(cell); }
+      bool settle(CellIndex cell) {
+        ++context.getStats().nodesExplored;
+        return cell == start;
+      }
+    } state{context, start};
+    spread(maze, sources, state);
+  }
+
+  if (reachable && context.isVisited(start)) {
+    // Follow the parents from the start to its source
+    const int dx[] = {0, 0, -1, 1}; // In Direction order
+    const int dy[] = {-1, 1, 0, 0};
+    std::vector<Cell> &path = context.getPath();
+    Coordinate current = coords;
+    CellIndex index = start;
+    path.emplace_back(current.x, current.y);
+    context.markPath(index);
+    for (std::uint8_t dir = context.getParentDirection(index);
+         dir != SearchContext::ROOT_PARENT;
+         dir = context.getParentDirection(index)) {
+      current = {current.x + dx[dir], current.y + dy[dir]};
+      index = maze.indexOf(current.x, current.y);
+      path.emplace_back(current.x, current.y);
+      context.markPath(index);
+    }
+    number = static_cast<std::uint32_t>(
+        std::find(sources.begin(), sources.end(), index) - sources.begin());
+    context.getStats().pathLength = path.size();
+    context.getStats().pathCost = context.getCost(start);
+  }
+
+  auto endTime = std::chrono::high_resolution_clock::now();
+  context.getStats().executionTime =
+      std::chrono::duration<double, std::milli>(endTime - startTime);
+  return number;
+}
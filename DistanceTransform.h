@@ -0,0 +1,127 @@
+#ifndef DISTANCE_TRANSFORM_H
+#define DISTANCE_TRANSFORM_H
+
+#include "Maze.h"
+#include "SearchContext.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Distance from every cell to the nearest of many sources (exits,
+ * goals), and which source that is.
+ *
+ * Built by one multi-source search: every source is seeded at distance 0
+ * and the searches spread together, breadth-first (Dijkstra's algorithm
+ * with terrain costs), so each cell is claimed by the source that reaches
+ * it first. A cell's distance is the cost of its cheapest 4-connected path
+ * to any source, counted like a path from the cell: the costs of the cells
+ * entered, the source's included. Between sources at the same distance,
+ * the one claimed first by the search wins.
+ *
+ * The transform holds a 32-bit source number and a 64-bit distance per
+ * cell. build() reuses both arrays, so rebuilding for another set of
+ * sources allocates nothing. For a single start, nearestSource() stops as
+ * soon as the start is reached and keeps its state in a SearchContext.
+ */
+class DistanceTransform {
+public:
+  /**
+   * @brief Source number of cells no source reaches, including walls.
+   */
+  static constexpr std::uint32_t NO_SOURCE = ~std::uint32_t{0};
+
+  /**
+   * @brief Distance of cells no source reaches.
+   */
+  static constexpr PathCost UNREACHABLE = ~PathCost{0};
+
+  /**
+   * @brief Construct an empty transform; see build().
+   */
+  DistanceTransform();
+
+  /**
+   * @brief Construct the transform of a set of sources.
+   * @param maze The maze.
+   * @param sources Indexes of the source cells. Walls are ignored.
+   */
+  DistanceTransform(const Maze &maze, const std::vector<CellIndex> &sources);
+
+  /**
+   * @brief Compute the nearest source and its distance for every cell,
+   * replacing any transform held. Takes O(cells), or O(cells log cells)
+   * with terrain costs.
+   * @param maze The maze.
+   * @param sources Indexes of the source cells. Walls are ignored; a
+   * repeated source keeps its first number.
+   */
+  void build(const Maze &maze, const std::vector<CellIndex> &sources);
+
+  /**
+   * @brief Check whether the transform was built for a maze of this size.
+   * The walls and costs are not compared.
+   */
+  bool matches(const Maze &maze) const {
+    return maze.getWidth() == width && maze.getHeight() == height;
+  }
+
+  /**
+   * @brief Get the nearest source of a cell.
+   * @param cell The cell index (must be a cell of the transform's maze).
+   * @return The source's position in the list given to build(), or
+   * NO_SOURCE.
+   */
+  std::uint32_t getNearest(CellIndex cell) const { return nearest[cell]; }
+
+  /**
+   * @brief Get the cost of the cheapest path from a cell to any source.
+   * @param cell The cell index (must be a cell of the transform's maze).
+   * @return The cost, 0 for a source, or UNREACHABLE.
+   */
+  PathCost getDistance(CellIndex cell) const { return distances[cell]; }
+
+  /**
+   * @brief Get the largest distance of a reached cell (0 if none).
+   */
+  PathCost getMaxDistance() const { return maxDistance; }
+
+  /**
+   * @brief Get the size of the transform in bytes.
+   */
+  std::size_t getMemoryBytes() const {
+    return nearest.capacity() * sizeof(std::uint32_t) +
+           distances.capacity() * sizeof(PathCost);
+  }
+
+  /**
+   * @brief Find the nearest source of one start, stopping as soon as the
+   * start is reached.
+   *
+   * Runs the same multi-source search as build(), on the context's dense
+   * tables. On success the context holds the path from the start to the
+   * source (stats.pathLength, stats.pathCost), and stats.nodesExplored
+   * counts the cells expanded.
+   *
+   * @param maze The maze.
+   * @param context The per-query state to use; its movement must be
+   * 4-connected.
+   * @param sources Indexes of the source cells. Walls are ignored.
+   * @param start Index of the start cell.
+   * @return The source's position in sources, or NO_SOURCE.
+   * @throws std::invalid_argument if the context's movement is not
+   * 4-connected, or if its component labels were built for a maze of a
+   * different size.
+   */
+  static std::uint32_t nearestSource(const Maze &maze, SearchContext &context,
+                                     const std::vector<CellIndex> &sources,
+                                     CellIndex start);
+
+private:
+  int width;
+  int height;
+  PathCost maxDistance;
+  std::vector<std::uint32_t> nearest; // Source number per cell
+  std::vector<PathCost> distances;    // Per cell
+};
+
+#endif // DISTANCE_TRANSFORM_H
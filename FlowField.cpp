@@ -0,0 +1,106 @@
+#include "FlowField.h"
+
+#include "SearchContext.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace {
+
+// Dijkstra's algorithm from the goal over distances of any width, with the
+// goal's entry already 0 and every other UNREACHABLE (all bits set)
+template <typename Distance, typename Reach>
+std::uint64_t relaxAll(const Maze &maze, const std::uint8_t *costs,
+                       CellIndex goal, std::vector<Distance> &distances,
+                       Reach &reach) {
+  using Entry = std::pair<Distance, CellIndex>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  open.push({0, goal});
+  std::uint64_t reached = 0;
+  while (!open.empty()) {
+    const Entry top = open.top();
+    open.pop();
+    if (top.first != distances[top.second])
+      continue;
+    ++reached;
+    const Distance next = static_cast<Distance>(top.first + costs[top.second]);
+    maze.forEachNeighbor(top.second, [&](CellIndex neighbor, Direction dir) {
+      if (next < distances[neighbor]) {
+        distances[neighbor] = next;
+        reach(neighbor, dir);
+        open.push({next, neighbor});
+      }
+    });
+  }
+  return reached;
+}
+
+} // namespace
+
+FlowField::FlowField()
+    : width(0), height(0), goal(0), walls{0, 0}, costs{0, 0} {}
+
+FlowField::FlowField(const Maze &maze, CellIndex goal) : FlowField() {
+  build(maze, goal);
+}
+
+std::uint64_t FlowField::build(const Maze &maze, CellIndex target) {
+  const std::size_t cellCount = static_cast<std::size_t>(maze.getCellCount());
+  width = maze.getWidth();
+  height = maze.getHeight();
+  goal = target;
+  walls = maze.getWallVersion();
+  costs = maze.getCostVersion();
+  distances.assign(cellCount, UNREACHABLE);
+  steps.assign((cellCount + 3) / 4, 0);
+  const Coordinate coords = maze.coordsOf(goal);
+  if (maze.isWall(coords.x, coords.y))
+    return 0;
+
+  // Walking backwards from a cell to a neighbor, the neighbor's step is
+  // the way back, and its path pays for entering the cell
+  auto reach = [&](CellIndex neighbor, Direction dir) {
+    const unsigned shift = static_cast<unsigned>(neighbor % 4 * 2);
+    steps[neighbor / 4] = static_cast<std::uint8_t>(
+        (steps[neighbor / 4] & ~(3u << shift)) |
+        (static_cast<unsigned>(SearchContext::oppositeDirection(dir))
+         << shift));
+  };
+  distances[goal] = 0;
+
+  const std::uint8_t *costs = maze.getCostPlane();
+  if (!costs) {
+    std::vector<CellIndex> queue{goal};
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      const CellIndex cell = queue[head];
+      const std::uint32_t next = distances[cell] + 1;
+      maze.forEachNeighbor(cell, [&](CellIndex neighbor, Direction dir) {
+        if (distances[neighbor] == UNREACHABLE) {
+          distances[neighbor] = next;
+          reach(neighbor, dir);
+          queue.push_back(neighbor);
+        }
+      });
+    }
+    return queue.size();
+  }
+
+  // Paths through more than 16M cells of cost 255 can pass 32 bits. Then
+  // the search runs on 64-bit scratch distances, so the steps still follow
+  // the cheapest paths, and only the stored distances saturate
+  const std::uint64_t bound =
+      maze.getCellCount() * static_cast<std::uint64_t>(maze.getMaxCost());
+  if (bound < SATURATED)
+    return relaxAll(maze, costs, goal, distances, reach);
+
+  std::vector<PathCost> wide(cellCount, ~PathCost{0});
+  wide[goal] = 0;
+  const std::uint64_t reached = relaxAll(maze, costs, goal, wide, reach);
+  for (std::size_t i = 0; i < cellCount; ++i) {
+    if (wide[i] != ~PathCost{0})
+      distances[i] = static_cast<std::uint32_t>(
+          std::min<PathCost>(wide[i], SATURATED));
+  }
+  return reached;
+}
@@ -0,0 +1,117 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include "Maze.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Distances to one goal and the next step towards it, for every
+ * cell of a maze.
+ *
+ * Built by one breadth-first search from the goal (Dijkstra's algorithm
+ * with terrain costs), walking edges backwards: a cell's distance is the
+ * cost of its cheapest 4-connected path to the goal, and its step is the
+ * first move of that path. Any number of agents heading for the goal can
+ * then follow the steps from where they stand, in O(path length) each and
+ * without a search (see FlowFieldPathfinder).
+ *
+ * Steps are 4-connected and stored in 2 bits per cell, distances in 32
+ * bits, so a field takes 4.25 bytes per cell. Costs that do not fit are
+ * stored as SATURATED. A field describes the walls and costs it was built
+ * with and must be rebuilt after any change. It records their versions
+ * (Maze::getWallVersion() and getCostVersion()), so isCurrent() tells in
+ * O(1) whether either has changed since.
+ */
+class FlowField {
+public:
+  /**
+   * @brief Distance of cells with no path to the goal, including walls.
+   */
+  static constexpr std::uint32_t UNREACHABLE = ~std::uint32_t{0};
+
+  /**
+   * @brief Distance stored for cells whose cost does not fit 32 bits. Their
+   * steps still follow the cheapest path.
+   */
+  static constexpr std::uint32_t SATURATED = UNREACHABLE - 1;
+
+  /**
+   * @brief Construct an empty field; see build().
+   */
+  FlowField();
+
+  /**
+   * @brief Construct the field of a goal.
+   * @param maze The maze.
+   * @param goal Index of the goal cell.
+   */
+  FlowField(const Maze &maze, CellIndex goal);
+
+  /**
+   * @brief Compute the distances and steps to a goal, replacing any field
+   * held. If the goal is a wall, no cell reaches it. Takes O(cells), or
+   * O(cells log cells) with terrain costs.
+   * @param maze The maze.
+   * @param goal Index of the goal cell.
+   * @return The number of cells that reach the goal.
+   */
+  std::uint64_t build(const Maze &maze, CellIndex goal);
+
+  /**
+   * @brief Check whether the field was built for a maze of this size. The
+   * walls and costs are not compared.
+   */
+  bool matches(const Maze &maze) const {
+    return maze.getWidth() == width && maze.getHeight() == height;
+  }
+
+  /**
+   * @brief Check whether the field was built for this maze and its walls
+   * and costs have not been edited since.
+   */
+  bool isCurrent(const Maze &maze) const {
+    return matches(maze) && maze.getWallVersion() == walls &&
+           maze.getCostVersion() == costs;
+  }
+
+  /**
+   * @brief Get the goal the field leads to.
+   */
+  CellIndex getGoal() const { return goal; }
+
+  /**
+   * @brief Get the cost of the cheapest path from a cell to the goal: the
+   * sum of the costs of the cells entered, the goal's included.
+   * @param cell The cell index (must be a cell of the field's maze).
+   * @return The cost, 0 for the goal, SATURATED if the cost does not fit,
+   * or UNREACHABLE.
+   */
+  std::uint32_t getDistance(CellIndex cell) const { return distances[cell]; }
+
+  /**
+   * @brief Get the first step of the cheapest path from a cell to the goal.
+   * @param cell A cell that reaches the goal and is not the goal.
+   */
+  Direction getStep(CellIndex cell) const {
+    return static_cast<Direction>((steps[cell / 4] >> (cell % 4 * 2)) & 3);
+  }
+
+  /**
+   * @brief Get the size of the field in bytes.
+   */
+  std::size_t getMemoryBytes() const {
+    return distances.capacity() * sizeof(std::uint32_t) + steps.capacity();
+  }
+
+private:
+  int width;
+  int height;
+  CellIndex goal;
+  Maze::WallVersion walls;              // Maze::getWallVersion() at build
+  Maze::WallVersion costs;              // Maze::getCostVersion() at build
+  std::vector<std::uint32_t> distances; // Per cell
+  std::vector<std::uint8_t> steps;      // 2-bit Direction per cell
+};
+
+#endif // FLOW_FIELD_H
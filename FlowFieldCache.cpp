@@ -0,0 +1,113 @@
+#include "FlowFieldCache.h"
+
+FlowFieldCache::FlowFieldCache(std::size_t capacityBytes)
+    : capacityBytes(capacityBytes), memoryBytes(0), hits(0), misses(0),
+      evictions(0), clears(0) {}
+
+std::shared_ptr<const FlowField> FlowFieldCache::get(const Maze &maze,
+                                                     CellIndex goal) {
+  std::promise<std::shared_ptr<const FlowField>> promise;
+  PendingField pending;
+  std::uint64_t clearsBefore;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = byGoal.find(goal);
+    if (found != byGoal.end()) {
+      entries.splice(entries.begin(), entries, found->second);
+      if (found->second->field->isCurrent(maze)) {
+        ++hits;
+        return found->second->field;
+      }
+      // Built before an edit, or for a maze of another size
+      memoryBytes -= found->second->field->getMemoryBytes();
+      entries.erase(found->second);
+      byGoal.erase(found);
+    }
+
+    auto inFlight = building.find(goal);
+    if (inFlight != building.end()) {
+      ++hits;
+      pending = inFlight->second;
+    } else {
+      ++misses;
+      building.emplace(goal, promise.get_future().share());
+    }
+    clearsBefore = clears;
+  }
+
+  if (pending.valid()) {
+    // Another caller is building the field; one that does not describe
+    // this maze is looked up again, which replaces it
+    std::shared_ptr<const FlowField> field = pending.get();
+    return field->isCurrent(maze) ? field : get(maze, goal);
+  }
+
+  std::shared_ptr<const FlowField> field;
+  try {
+    field = std::make_shared<FlowField>(maze, goal);
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (clears == clearsBefore)
+        building.erase(goal);
+    }
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    // A clear() during the build dropped everything held: the field still
+    // answers the callers that asked before it, but is not kept
+    if (clears == clearsBefore) {
+      building.erase(goal);
+      memoryBytes += field->getMemoryBytes();
+      entries.push_front({goal, field});
+      byGoal[goal] = entries.begin();
+
+      while (memoryBytes > capacityBytes && entries.size() > 1) {
+        const Entry &oldest = entries.back();
+        memoryBytes -= oldest.field->getMemoryBytes();
+        byGoal.erase(oldest.goal);
+        entries.pop_back();
+        ++evictions;
+      }
+    }
+  }
+  promise.set_value(field);
+  return field;
+}
+
+void FlowFieldCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  entries.clear();
+  byGoal.clear();
+  building.clear();
+  memoryBytes = 0;
+  ++clears;
+}
+
+std::size_t FlowFieldCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return entries.size();
+}
+
+std::size_t FlowFieldCache::getMemoryBytes() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return memoryBytes;
+}
+
+std::uint64_t FlowFieldCache::getHits() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return hits;
+}
+
+std::uint64_t FlowFieldCache::getMisses() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return misses;
+}
+
+std::uint64_t FlowFieldCache::getEvictions() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return evictions;
+}
@@ -0,0 +1,104 @@
+#ifndef FLOW_FIELD_CACHE_H
+#define FLOW_FIELD_CACHE_H
+
+#include "FlowField.h"
+#include "Maze.h"
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @brief Flow fields of one maze, by goal, within a memory budget.
+ *
+ * get() returns the field of a goal, building it on first use. When the
+ * fields held exceed the budget, the least recently used are dropped; a
+ * field still held by a caller stays alive until released. The newest
+ * field is always kept, even if it alone exceeds the budget.
+ *
+ * A field built before a wall or cost edit (see FlowField::isCurrent()), or
+ * for a maze of another size, counts as a miss and is rebuilt, so editing
+ * the maze needs no clear().
+ *
+ * Every member function may be called from several threads at once: get(),
+ * clear() and the size and counter getters all take the cache's lock. The
+ * fields returned are never modified, so callers read them without it.
+ * Fields are built outside the lock, so a build does not hold up callers
+ * whose goals are held. Callers asking for a goal that is being built wait
+ * for that build (and count as hits) instead of starting another. A build
+ * reads the maze, so the maze must not be edited while get() runs.
+ */
+class FlowFieldCache {
+public:
+  /**
+   * @brief Construct an empty cache.
+   * @param capacityBytes The budget for the fields held
+   * (FlowField::getMemoryBytes()).
+   */
+  explicit FlowFieldCache(std::size_t capacityBytes);
+
+  /**
+   * @brief Get the flow field of a goal, building it if it is not held.
+   * @param maze The maze.
+   * @param goal Index of the goal cell.
+   */
+  std::shared_ptr<const FlowField> get(const Maze &maze, CellIndex goal);
+
+  /**
+   * @brief Drop every field, to release their memory. Builds in progress
+   * still answer their callers, but are not kept.
+   */
+  void clear();
+
+  /**
+   * @brief Get the number of fields held.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Get the size of the fields held in bytes.
+   */
+  std::size_t getMemoryBytes() const;
+
+  /**
+   * @brief Get the budget given at construction.
+   */
+  std::size_t getCapacityBytes() const { return capacityBytes; }
+
+  /**
+   * @brief Get the number of get() calls answered from a field held.
+   */
+  std::uint64_t getHits() const;
+
+  /**
+   * @brief Get the number of fields built.
+   */
+  std::uint64_t getMisses() const;
+
+  /**
+   * @brief Get the number of fields dropped to stay within the budget.
+   */
+  std::uint64_t getEvictions() const;
+
+private:
+  struct Entry {
+    CellIndex goal;
+    std::shared_ptr<const FlowField> field;
+  };
+  using PendingField = std::shared_future<std::shared_ptr<const FlowField>>;
+
+  std::size_t capacityBytes;
+  std::size_t memoryBytes;
+  std::uint64_t hits;
+  std::uint64_t misses;
+  std::uint64_t evictions;
+  std::list<Entry> entries; // Most recently used first
+  std::unordered_map<CellIndex, std::list<Entry>::iterator> byGoal;
+  std::unordered_map<CellIndex, PendingField> building; // Goals in flight
+  std::uint64_t clears; // clear() calls, to drop builds they overtook
+  mutable std::mutex mutex;
+};
+
+#endif // FLOW_FIELD_CACHE_H
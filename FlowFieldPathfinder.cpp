@@ -0,0 +1,52 @@
+#include "FlowFieldPathfinder.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+FlowFieldPathfinder::FlowFieldPathfinder(std::shared_ptr<FlowFieldCache> cache)
+    : cache(std::move(cache)) {}
+
+std::vector<Cell> FlowFieldPathfinder::findPath(
+    const Maze &maze, SearchContext &context, std::shared_ptr<Cell> start,
+    std::shared_ptr<Cell> goal,
+    std::function<void(std::shared_ptr<Cell>)> onVisit) const {
+  if (!cache) {
+    throw std::invalid_argument("Flow field search needs a cache");
+  }
+  requireFourConnected(context, "Flow field search");
+  auto startTime = std::chrono::high_resolution_clock::now();
+
+  context.begin(maze);
+  if (!start || !goal || maze.isWall(start->getX(), start->getY()) ||
+      maze.isWall(goal->getX(), goal->getY())) {
+    return context.getPath();
+  }
+
+  const CellIndex startIndex = maze.indexOf(start->getX(), start->getY());
+  const CellIndex goalIndex = maze.indexOf(goal->getX(), goal->getY());
+  if (!isUnreachable(maze, context, startIndex, goalIndex)) {
+    const std::shared_ptr<const FlowField> field =
+        cache->get(maze, goalIndex);
+    if (field->getDistance(startIndex) != FlowField::UNREACHABLE) {
+      // Each step's parent on the path is the cell it was taken from
+      context.markVisited(startIndex, SearchContext::ROOT_PARENT);
+      for (CellIndex cell = startIndex; cell != goalIndex;) {
+        const Direction step = field->getStep(cell);
+        cell = maze.neighborIndex(cell, step);
+        context.markVisited(cell, SearchContext::oppositeDirection(step));
+      }
+      reconstructPath(maze, context, startIndex, goalIndex);
+      if (onVisit) {
+        for (const Cell &cell : context.getPath())
+          onVisit(maze.getCell(cell.getX(), cell.getY()));
+      }
+    }
+  }
+
+  auto endTime = std::chrono::high_resolution_clock::now();
+  context.getStats().executionTime =
+      std::chrono::duration<double, std::milli>(endTime - startTime);
+
+  return context.getPath();
+}
@@ -0,0 +1,62 @@
+#ifndef FLOW_FIELD_PATHFINDER_H
+#define FLOW_FIELD_PATHFINDER_H
+
+#include "FlowFieldCache.h"
+#include "Maze.h"
+#include "PathFinder.h"
+#include <memory>
+
+/**
+ * @brief Path queries read from the goal's flow field, for many agents
+ * heading for the same few goals.
+ *
+ * The first query to a goal builds its FlowField, one breadth-first search
+ * (Dijkstra's algorithm with terrain costs) over the whole maze, and keeps
+ * it in a FlowFieldCache. Every later query to that goal follows the steps
+ * from the start, in O(path length). The path is a cheapest one, so it has
+ * the same cost as an A* path.
+ *
+ * Movement must be 4-connected. stats.nodesExplored is 0: no cell is
+ * expanded by the query itself, and field builds are counted by the cache.
+ * There is no path from or to a wall cell.
+ *
+ * Unlike the precomputed tables of the other searches, the cache changes
+ * during queries, as fields are built and evicted. It locks itself (see
+ * FlowFieldCache), so pathfinders on several threads, each with its own
+ * context, may share one cache.
+ */
+class FlowFieldPathfinder : public PathFinder {
+public:
+  using PathFinder::findPath;
+
+  /**
+   * @brief Construct a pathfinder that reads flow fields from a cache.
+   * @param cache The cache of the mazes that will be searched.
+   */
+  explicit FlowFieldPathfinder(std::shared_ptr<FlowFieldCache> cache);
+
+  /**
+   * @brief Find the path from start to goal by following the goal's flow
+   * field, building the field first if the cache does not hold it.
+   * @param maze The maze to search.
+   * @param context The per-query state to use.
+   * @param start The starting cell.
+   * @param goal The goal cell.
+   * @param onVisit Optional callback for animation, called for each path
+   * cell (default: nullptr).
+   * @return A vector of cells representing the path, or empty if no path
+   * exists.
+   * @throws std::invalid_argument if the pathfinder has no cache, or if the
+   * context's movement is not 4-connected.
+   */
+  std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const override;
+
+private:
+  std::shared_ptr<FlowFieldCache> cache;
+};
+
+#endif // FLOW_FIELD_PATHFINDER_H
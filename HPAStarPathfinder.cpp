@@ -0,0 +1,255 @@
+#include "HPAStarPathfinder.h"
+
+#include "AStarPathfinder.h"
+#include <algorithm>
+#include <chrono>
+#include <queue>
+#include <stdexcept>
+
+namespace {
+
+struct Node {
+  CellIndex cell;
+  std::size_t node;   // Number of the abstract node (see searchAbstract)
+  PathCost fScore;    // f = g + h
+  std::size_t parent; // Position of the parent's entry in the trail
+
+  bool operator>(const Node &other) const { return fScore > other.fScore; }
+};
+
+// An expanded abstract node and the position of its parent's entry
+struct TrailEntry {
+  CellIndex cell;
+  std::size_t parent;
+};
+
+// Direction of the step from one cell to an adjacent one
+Direction stepBetween(Coordinate from, Coordinate to) {
+  if (to.y != from.y)
+    return to.y < from.y ? Direction::UP : Direction::DOWN;
+  return to.x < from.x ? Direction::LEFT : Direction::RIGHT;
+}
+
+} // namespace
+
+HPAStarPathfinder::HPAStarPathfinder(
+    std::shared_ptr<const ClusterGraph> graph)
+    : graph(std::move(graph)) {}
+
+template <typename Visitor>
+bool HPAStarPathfinder::searchAbstract(const Maze &maze,
+                                       SearchContext &context,
+                                       ClusterSearch &search, CellIndex start,
+                                       CellIndex goal, Visitor &visit,
+                                       std::vector<CellIndex> &route,
+                                       std::uint64_t &expanded) const {
+  const Coordinate startCoords = maze.coordsOf(start);
+  const Coordinate goalCoords = maze.coordsOf(goal);
+  const std::size_t startCluster =
+      graph->clusterOf(startCoords.x, startCoords.y);
+  const std::size_t goalCluster = graph->clusterOf(goalCoords.x, goalCoords.y);
+  const std::vector<CellIndex> &startNodes = graph->getNodes(startCluster);
+  const std::vector<CellIndex> &goalNodes = graph->getNodes(goalCluster);
+  const std::uint8_t *cellCosts = maze.getCostPlane();
+  auto costOf = [&](CellIndex index) -> PathCost {
+    return cellCosts ? cellCosts[index] : 1;
+  };
+
+  // Edges from the start to its cluster's nodes (and to the goal if they
+  // share the cluster), and from the goal cluster's nodes to the goal
+  search.run(maze, graph->getBounds(startCluster), start, false);
+  std::vector<PathCost> fromStart(startNodes.size());
+  for (std::size_t i = 0; i < startNodes.size(); ++i)
+    fromStart[i] = search.cost(maze, startNodes[i]);
+  const PathCost direct = startCluster == goalCluster
+                              ? search.cost(maze, goal)
+                              : ClusterGraph::NO_PATH;
+  search.run(maze, graph->getBounds(goalCluster), goal, true);
+  std::vector<PathCost> toGoal(goalNodes.size());
+  for (std::size_t i = 0; i < goalNodes.size(); ++i)
+    toGoal[i] = search.cost(maze, goalNodes[i]);
+
+  // Abstract nodes are numbered as in the graph, with the start and goal
+  // after them unless they are nodes already. Nodes are distinct cells, so
+  // the numbers stay below the cell count and the reverse context can hold
+  // their marks and costs, indexed by number. Parents are kept in a trail
+  // of expanded nodes instead of the marks, as they are not adjacent.
+  std::size_t nextNumber = graph->getNodeCount();
+  auto numberOf = [&](std::size_t cluster, CellIndex cell) {
+    const int node = graph->findNode(cluster, cell);
+    return node >= 0 ? graph->getFirstNode(cluster) +
+                           static_cast<std::size_t>(node)
+                     : nextNumber++;
+  };
+  const std::size_t startNumber = numberOf(startCluster, start);
+  const std::size_t goalNumber =
+      goal == start ? startNumber : numberOf(goalCluster, goal);
+
+  SearchContext &abstract = context.getReverse();
+  abstract.begin(maze);
+  abstract.reserveCosts();
+  std::vector<TrailEntry> trail;
+  std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
+  const PathCost minCost = maze.getMinCost();
+  auto estimate = [&](CellIndex cell) {
+    return AStarPathfinder::heuristic(maze.coordsOf(cell), goalCoords) *
+           minCost;
+  };
+
+  PathCost g = 0;
+  std::size_t entry = 0; // Trail entry of the node being expanded
+  auto relax = [&](CellIndex cell, std::size_t number, PathCost edge) {
+    if (edge == ClusterGraph::NO_PATH || !abstract.relax(number, g + edge, 0))
+      return;
+    open.push({cell, number, g + edge + estimate(cell), entry});
+  };
+
+  abstract.relax(startNumber, 0, SearchContext::ROOT_PARENT);
+  open.push({start, startNumber, estimate(start), 0});
+  bool found = false;
+  while (!open.empty()) {
+    const Node top = open.top();
+    open.pop();
+    if (abstract.isClosed(top.node))
+      continue;
+    abstract.markClosed(top.node);
+    entry = trail.size();
+    trail.push_back({top.cell, top.parent});
+    visit(top.cell);
+    ++expanded;
+    if (top.node == goalNumber) {
+      found = true;
+      break;
+    }
+    g = abstract.getCost(top.node);
+
+    if (top.node == startNumber) {
+      for (std::size_t i = 0; i < startNodes.size(); ++i)
+        relax(startNodes[i], graph->getFirstNode(startCluster) + i,
+              fromStart[i]);
+      relax(goal, goalNumber, direct);
+    }
+    const Coordinate coords = maze.coordsOf(top.cell);
+    const std::size_t cluster = graph->clusterOf(coords.x, coords.y);
+    const std::size_t first = graph->getFirstNode(cluster);
+    if (top.node < first || top.node >= graph->getFirstNode(cluster + 1))
+      continue;
+    const int node = static_cast<int>(top.node - first);
+
+    // Leaving a node pays for the cells after it, not for the node itself
+    const std::vector<CellIndex> &nodes = graph->getNodes(cluster);
+    const PathCost own = costOf(top.cell);
+    for (std::size_t j = 0; j < nodes.size(); ++j) {
+      const PathCost d = graph->distance(cluster, node, static_cast<int>(j));
+      if (static_cast<int>(j) != node && d != ClusterGraph::NO_PATH)
+        relax(nodes[j], first + j, d - own);
+    }
+    maze.forEachNeighbor(top.cell, [&](CellIndex neighbor, Direction) {
+      const Coordinate across = maze.coordsOf(neighbor);
+      const std::size_t other = graph->clusterOf(across.x, across.y);
+      if (other == cluster)
+        return;
+      const int acrossNode = graph->findNode(other, neighbor);
+      if (acrossNode >= 0)
+        relax(neighbor,
+              graph->getFirstNode(other) + static_cast<std::size_t>(acrossNode),
+              costOf(neighbor));
+    });
+    if (cluster == goalCluster)
+      relax(goal, goalNumber, toGoal[static_cast<std::size_t>(node)]);
+  }
+  if (!found)
+    return false;
+
+  // The start's entry is the first and its own parent
+  for (std::size_t i = entry; i != 0; i = trail[i].parent)
+    route.push_back(trail[i].cell);
+  route.push_back(start);
+  std::reverse(route.begin(), route.end());
+  return true;
+}
+
+std::vector<Cell> HPAStarPathfinder::findPath(
+    const Maze &maze, SearchContext &context, std::shared_ptr<Cell> start,
+    std::shared_ptr<Cell> goal,
+    std::function<void(std::shared_ptr<Cell>)> onVisit) const {
+  if (!graph || !graph->matches(maze)) {
+    throw std::invalid_argument("Cluster graph was not built for this maze");
+  }
+  requireFourConnected(context, "HPA*");
+  abstractNodes.store(0);
+  if (!graph->isCurrent(maze))
+    return fallback.findPath(maze, context, start, goal, onVisit);
+  auto startTime = std::chrono::high_resolution_clock::now();
+
+  context.begin(maze);
+  if (!start || !goal || maze.isWall(start->getX(), start->getY()) ||
+      maze.isWall(goal->getX(), goal->getY())) {
+    return context.getPath();
+  }
+
+  const CellIndex startIndex = maze.indexOf(start->getX(), start->getY());
+  const CellIndex goalIndex = maze.indexOf(goal->getX(), goal->getY());
+
+  ClusterSearch search;
+  std::vector<CellIndex> route;
+  std::uint64_t expanded = 0; // Abstract nodes
+  bool found;
+  if (isUnreachable(maze, context, startIndex, goalIndex)) {
+    found = false;
+  } else if (onVisit) {
+    CellCallbackVisitor visitor(maze, onVisit);
+    found = searchAbstract(maze, context, search, startIndex, goalIndex,
+                           visitor, route, expanded);
+  } else {
+    NullVisitor visitor;
+    found = searchAbstract(maze, context, search, startIndex, goalIndex,
+                           visitor, route, expanded);
+  }
+
+  std::vector<CellIndex> cells;
+  if (found) {
+    // Refine the abstract path: edges inside a cluster by a search in it,
+    // steps between clusters as they are
+    cells.push_back(startIndex);
+    for (std::size_t i = 1; i < route.size(); ++i) {
+      const Coordinate from = maze.coordsOf(route[i - 1]);
+      const Coordinate to = maze.coordsOf(route[i]);
+      const std::size_t cluster = graph->clusterOf(from.x, from.y);
+      if (cluster == graph->clusterOf(to.x, to.y)) {
+        search.run(maze, graph->getBounds(cluster), route[i - 1], false,
+                   route[i]);
+        search.appendPath(maze, route[i], cells);
+      } else {
+        cells.push_back(route[i]);
+      }
+    }
+
+    // The parents are followed from the goal without checks, so a refined
+    // path that fell short of it is no path
+    found = cells.back() == goalIndex;
+  }
+
+  if (found) {
+    // A cell the refined path passes twice keeps its first parent, which
+    // cuts out the loop in between
+    context.markVisited(startIndex, SearchContext::ROOT_PARENT);
+    for (std::size_t i = 1; i < cells.size(); ++i) {
+      if (context.isVisited(cells[i]))
+        continue;
+      const Direction step =
+          stepBetween(maze.coordsOf(cells[i - 1]), maze.coordsOf(cells[i]));
+      context.markVisited(cells[i], SearchContext::oppositeDirection(step));
+    }
+    reconstructPath(maze, context, startIndex, goalIndex);
+  }
+
+  abstractNodes.store(expanded);
+  PathStats &stats = context.getStats();
+  stats.nodesExplored = expanded + search.getExpanded();
+  auto endTime = std::chrono::high_resolution_clock::now();
+  stats.executionTime =
+      std::chrono::duration<double, std::milli>(endTime - startTime);
+
+  return context.getPath();
+}
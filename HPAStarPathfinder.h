@@ -0,0 +1,95 @@
+#ifndef HPASTAR_PATHFINDER_H
+#define HPASTAR_PATHFINDER_H
+
+#include "AStarPathfinder.h"
+#include "ClusterGraph.h"
+#include "Maze.h"
+#include "PathFinder.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief HPA* (hierarchical A*) over a precomputed ClusterGraph.
+ *
+ * A query first connects the start to the nodes of its cluster and the
+ * nodes of the goal's cluster to the goal, with one search inside each of
+ * the two clusters. A* then runs on the abstract graph, whose edges are the
+ * cached distances inside clusters and the steps between adjacent nodes of
+ * different clusters, with the Manhattan distance scaled by
+ * Maze::getMinCost() as heuristic. Finally each abstract edge inside a
+ * cluster is refined into cells by a search confined to that cluster, so
+ * only the clusters the path passes through are searched cell by cell.
+ *
+ * Paths are valid but not always shortest: the abstract graph only crosses
+ * cluster borders at its transitions. They cost the same as the path found
+ * on the abstract graph or less. The abstract search runs in the context's
+ * reverse context; the path is rebuilt from the forward parents as for the
+ * other searches. If the maze has changed since the graph was last built
+ * or updated, the query falls back to A*.
+ *
+ * Queries read the cluster graph but never change it; each query's own
+ * searches live in its SearchContext. Several threads may therefore query
+ * through one graph at once, but ClusterGraph::update() and build() change
+ * it and must wait until they are done.
+ *
+ * getAbstractNodes() counts the abstract nodes expanded; stats.nodesExplored
+ * adds the cells expanded by the searches inside clusters.
+ */
+class HPAStarPathfinder : public PathFinder {
+public:
+  using PathFinder::findPath;
+
+  /**
+   * @brief Construct a pathfinder that uses a precomputed graph.
+   * @param graph The abstract graph of the mazes that will be searched.
+   */
+  explicit HPAStarPathfinder(std::shared_ptr<const ClusterGraph> graph);
+
+  /**
+   * @brief Find a path from start to goal using HPA*.
+   * @param maze The maze to search; it must have the size of the maze the
+   * graph was built for.
+   * @param context The per-query state to use.
+   * @param start The starting cell.
+   * @param goal The goal cell.
+   * @param onVisit Optional callback for animation, called for each expanded
+   * abstract node (default: nullptr).
+   * @return A vector of cells representing the path, or empty if no path
+   * exists or the start or goal is a wall.
+   * @throws std::invalid_argument if the graph was built for a maze of a
+   * different size, or if the context's movement is not 4-connected.
+   */
+  std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const override;
+
+  /**
+   * @brief Get the number of abstract nodes expanded by the last query
+   * through this pathfinder (0 if it fell back to A*). Queries running at
+   * the same time overwrite each other's count.
+   */
+  std::uint64_t getAbstractNodes() const { return abstractNodes.load(); }
+
+private:
+  /**
+   * @brief Run A* on the abstract graph, extended by the start and goal.
+   * @param visit Called with every expanded abstract node.
+   * @param route Receives the abstract path from start to goal.
+   * @param expanded Incremented for each abstract node expanded.
+   * @return true if a path was found.
+   */
+  template <typename Visitor>
+  bool searchAbstract(const Maze &maze, SearchContext &context,
+                      ClusterSearch &search, CellIndex start, CellIndex goal,
+                      Visitor &visit, std::vector<CellIndex> &route,
+                      std::uint64_t &expanded) const;
+
+  std::shared_ptr<const ClusterGraph> graph;
+  AStarPathfinder fallback; // For mazes the graph does not describe
+  mutable std::atomic<std::uint64_t> abstractNodes{0};
+};
+
+#endif // HPASTAR_PATHFINDER_H
@@ -0,0 +1,18 @@
+#include "JPSPathfinder.h"
+
+#include "JumpPointPolicy.h"
+
+std::vector<Cell>
+JPSPathfinder::findPath(const Maze &maze, SearchContext &context,
+                        std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+                        std::function<void(std::shared_ptr<Cell>)> onVisit)
+    const {
+  requireFourConnected(context, "Jump point search");
+
+  // Min-heap of jump points ordered by f = g + h
+  std::uint64_t queued = 0;
+  std::vector<Cell> path = runEngine(maze, context, start, goal, onVisit,
+                                     JumpPointPolicy(nullptr, &queued));
+  jumpPoints.store(queued);
+  return path;
+}
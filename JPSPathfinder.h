@@ -0,0 +1,56 @@
+#ifndef JPS_PATHFINDER_H
+#define JPS_PATHFINDER_H
+
+#include "Maze.h"
+#include "PathFinder.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Jump Point Search pathfinding algorithm implementation.
+ *
+ * JPS is A* on a uniform-cost grid that skips the cells A* would queue only
+ * to reach the same place by one of many symmetric routes. It scans in
+ * straight lines and queues only jump points, the cells where an optimal
+ * path may turn (see JumpPointPolicy). Paths are as short as those of BFS.
+ * Large open areas are crossed with a few jumps instead of queueing every
+ * cell.
+ *
+ * stats.nodesExplored counts expanded jump points; getJumpPoints() gives
+ * the jump points queued.
+ */
+class JPSPathfinder : public PathFinder {
+public:
+  using PathFinder::findPath;
+
+  /**
+   * @brief Find a path from start to goal using Jump Point Search.
+   * @param maze The maze to search.
+   * @param context The per-query state to use.
+   * @param start The starting cell.
+   * @param goal The goal cell.
+   * @param onVisit Optional callback for animation, called for each expanded
+   * jump point (default: nullptr).
+   * @return A vector of cells representing the path, or empty if no path
+   * exists.
+   * @throws std::invalid_argument if the context's movement is not
+   * 4-connected.
+   */
+  std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const override;
+
+  /**
+   * @brief Get the number of jump points queued by the last query through
+   * this pathfinder. Queries running at the same time overwrite each
+   * other's count.
+   */
+  std::uint64_t getJumpPoints() const { return jumpPoints.load(); }
+
+private:
+  mutable std::atomic<std::uint64_t> jumpPoints{0};
+};
+
+#endif // JPS_PATHFINDER_H
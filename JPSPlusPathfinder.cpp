@@ -0,0 +1,28 @@
+#include "JPSPlusPathfinder.h"
+
+#include "JumpPointPolicy.h"
+#include <stdexcept>
+
+JPSPlusPathfinder::JPSPlusPathfinder(
+    std::shared_ptr<const JumpPointTable> table)
+    : table(std::move(table)) {}
+
+std::vector<Cell> JPSPlusPathfinder::findPath(
+    const Maze &maze, SearchContext &context, std::shared_ptr<Cell> start,
+    std::shared_ptr<Cell> goal,
+    std::function<void(std::shared_ptr<Cell>)> onVisit) const {
+  if (!table || !table->matches(maze)) {
+    throw std::invalid_argument("Jump table was not built for this maze");
+  }
+  requireFourConnected(context, "JPS+");
+
+  // Min-heap of jump points ordered by f = g + h, jumps read from the
+  // table, or scanned as in JPSPathfinder once the walls have changed
+  std::uint64_t queued = 0;
+  std::vector<Cell> path = runEngine(
+      maze, context, start, goal, onVisit,
+      JumpPointPolicy(table->isCurrent(maze) ? table.get() : nullptr,
+                      &queued));
+  jumpPoints.store(queued);
+  return path;
+}
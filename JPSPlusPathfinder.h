@@ -0,0 +1,69 @@
+#ifndef JPS_PLUS_PATHFINDER_H
+#define JPS_PLUS_PATHFINDER_H
+
+#include "JumpPointTable.h"
+#include "Maze.h"
+#include "PathFinder.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief JPS+ pathfinding: Jump Point Search over precomputed jump distances.
+ *
+ * Runs the same search as JPSPathfinder and returns paths of the same
+ * length, but each jump is a table lookup (see JumpPointTable) instead of a
+ * scan along the row or column. This suits static maps that are queried
+ * many times: the table is built once per maze, or loaded with it. If the
+ * walls have changed since, the query scans its jumps as JPSPathfinder does.
+ *
+ * Queries only read the table, so one table can back any number of
+ * pathfinders, and threads may query at once with their own contexts.
+ * Building or loading the table must not overlap with queries.
+ *
+ * stats.nodesExplored counts expanded jump points; getJumpPoints() gives
+ * the jump points queued.
+ */
+class JPSPlusPathfinder : public PathFinder {
+public:
+  using PathFinder::findPath;
+
+  /**
+   * @brief Construct a pathfinder that uses a precomputed table.
+   * @param table Jump distances for the mazes that will be searched.
+   */
+  explicit JPSPlusPathfinder(std::shared_ptr<const JumpPointTable> table);
+
+  /**
+   * @brief Find a path from start to goal using JPS+.
+   * @param maze The maze to search; it must have the size of the maze the
+   * table was built for.
+   * @param context The per-query state to use.
+   * @param start The starting cell.
+   * @param goal The goal cell.
+   * @param onVisit Optional callback for animation, called for each expanded
+   * jump point (default: nullptr).
+   * @return A vector of cells representing the path, or empty if no path
+   * exists.
+   * @throws std::invalid_argument if the table was built for a maze of a
+   * different size, or if the context's movement is not 4-connected.
+   */
+  std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const override;
+
+  /**
+   * @brief Get the number of jump points queued by the last query through
+   * this pathfinder. Queries running at the same time overwrite each
+   * other's count.
+   */
+  std::uint64_t getJumpPoints() const { return jumpPoints.load(); }
+
+private:
+  std::shared_ptr<const JumpPointTable> table;
+  mutable std::atomic<std::uint64_t> jumpPoints{0};
+};
+
+#endif // JPS_PLUS_PATHFINDER_H
@@ -0,0 +1,178 @@
+#include "JumpPointPolicy.h"
+
+#include <cstdlib>
+
+namespace {
+
+const int DX[] = {0, 0, -1, 1}; // UP, DOWN, LEFT, RIGHT
+const int DY[] = {-1, 1, 0, 0};
+
+} // namespace
+
+void JumpPointPolicy::seed(const Maze &maze, SearchContext &context,
+                           CellIndex start, CellIndex goal) {
+  goalCoords = maze.coordsOf(goal);
+  context.reserveCosts();
+  context.relax(start, 0, SearchContext::ROOT_PARENT);
+  open.push({start, estimate(maze.coordsOf(start)), 0});
+}
+
+bool JumpPointPolicy::pop(const Maze &maze, SearchContext &context,
+                          CellIndex &cell) {
+  const Node node = open.top();
+  open.pop();
+
+  // Skip outdated entries (the jump point was reached more cheaply since)
+  if (node.gScore > context.getCost(node.index))
+    return false;
+
+  cell = node.index;
+  currentG = node.gScore;
+  currentCoords = maze.coordsOf(cell);
+  return true;
+}
+
+void JumpPointPolicy::expand(const Maze &maze, SearchContext &context,
+                             CellIndex cell) {
+  const std::uint8_t parent = context.getParentDirection(cell);
+  const int x = currentCoords.x;
+  const int y = currentCoords.y;
+
+  for (int d = 0; d < 4; ++d) {
+    if (d == parent)
+      continue; // Going back can never be shorter
+
+    Coordinate found = currentCoords;
+    bool jumped;
+    if (table)
+      jumped = jumpFromTable(maze, cell, currentCoords,
+                             static_cast<Direction>(d), found);
+    else
+      jumped = DX[d] != 0 ? jumpHorizontal(maze, x, y, DX[d], found.x)
+                          : jumpVertical(maze, x, y, DY[d], found.y);
+    if (!jumped)
+      continue;
+
+    const PathCost g = currentG +
+                       static_cast<PathCost>(std::abs(found.x - x)) +
+                       static_cast<PathCost>(std::abs(found.y - y));
+    const CellIndex index = maze.indexOf(found.x, found.y);
+    if (context.relax(index, g, SearchContext::oppositeDirection(
+                                    static_cast<Direction>(d)))) {
+      open.push({index, g + estimate(found), g});
+      if (queued)
+        ++*queued;
+    }
+  }
+}
+
+void JumpPointPolicy::finish(const Maze &maze, SearchContext &context,
+                             CellIndex start, CellIndex goal) {
+  // Walk back from the goal one jump at a time. A jump ends at the first
+  // visited cell whose cost accounts for the distance covered: that is the
+  // jump point the jump started from, or another cell on an equally short
+  // path to it.
+  CellIndex index = goal;
+  while (index != start) {
+    const std::uint8_t dir = context.getParentDirection(index);
+    const Direction back = static_cast<Direction>(dir);
+    const PathCost cost = context.getCost(index);
+
+    CellIndex cell = maze.neighborIndex(index, back);
+    PathCost distance = 1;
+    while (!context.isVisited(cell) ||
+           context.getCost(cell) + distance != cost) {
+      // A skipped cell: it is reached from the next cell back along the jump
+      context.relax(cell, cost - distance, dir);
+      cell = maze.neighborIndex(cell, back);
+      ++distance;
+    }
+    index = cell;
+  }
+}
+
+bool JumpPointPolicy::jumpHorizontal(const Maze &maze, int x, int y, int dx,
+                                     int &jumpX) const {
+  const int width = maze.getWidth();
+
+  int behind = x;
+  for (int cx = x + dx; cx >= 0 && cx < width && !maze.isWall(cx, y);
+       behind = cx, cx += dx) {
+    // A vertical move is forced here if it was blocked one cell earlier
+    if (isForcedTurn(maze, cx, behind, y) ||
+        (cx == goalCoords.x && y == goalCoords.y)) {
+      jumpX = cx;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool JumpPointPolicy::jumpVertical(const Maze &maze, int x, int y, int dy,
+                                   int &jumpY) const {
+  const int height = maze.getHeight();
+
+  for (int cy = y + dy; cy >= 0 && cy < height && !maze.isWall(x, cy);
+       cy += dy) {
+    // A vertical run may turn anywhere, so look for jump points sideways
+    int unused;
+    if ((x == goalCoords.x && cy == goalCoords.y) ||
+        jumpHorizontal(maze, x, cy, -1, unused) ||
+        jumpHorizontal(maze, x, cy, 1, unused)) {
+      jumpY = cy;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool JumpPointPolicy::jumpFromTable(const Maze &maze, CellIndex index,
+                                    Coordinate coords, Direction dir,
+                                    Coordinate &found) const {
+  const int d = static_cast<int>(dir);
+  const std::int32_t distance = table->distance(index, dir);
+  const int reach = distance > 0 ? distance : -distance;
+
+  if (DX[d] != 0) {
+    // The goal is a jump point if the run passes it
+    const int toGoal = (goalCoords.x - coords.x) * DX[d];
+    if (goalCoords.y == coords.y && toGoal > 0 && toGoal <= reach) {
+      found = goalCoords;
+      return true;
+    }
+    if (distance <= 0)
+      return false;
+    found = {coords.x + DX[d] * distance, coords.y};
+    return true;
+  }
+
+  // The cell of the run in the goal's row is a jump point if a horizontal
+  // run from it passes the goal. Had that run found a jump point first, the
+  // cell would be in the table already.
+  const int toGoalRow = (goalCoords.y - coords.y) * DY[d];
+  if (toGoalRow > 0 && toGoalRow <= reach) {
+    const int toGoal = goalCoords.x - coords.x;
+    bool reachesGoal = toGoal == 0;
+    if (!reachesGoal) {
+      const std::int32_t sideways = table->distance(
+          maze.indexOf(coords.x, goalCoords.y),
+          toGoal > 0 ? Direction::RIGHT : Direction::LEFT);
+      reachesGoal = (toGoal > 0 ? toGoal : -toGoal) <=
+                    (sideways > 0 ? sideways : -sideways);
+    }
+    if (reachesGoal) {
+      found = {coords.x, goalCoords.y};
+      return true;
+    }
+  }
+  if (distance <= 0)
+    return false;
+  found = {coords.x, coords.y + DY[d] * distance};
+  return true;
+}
+
+PathCost JumpPointPolicy::estimate(Coordinate cell) const {
+  // Manhattan distance
+  return static_cast<PathCost>(std::abs(cell.x - goalCoords.x)) +
+         static_cast<PathCost>(std::abs(cell.y - goalCoords.y));
+}
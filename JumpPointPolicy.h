@@ -0,0 +1,128 @@
+#ifndef JUMP_POINT_POLICY_H
+#define JUMP_POINT_POLICY_H
+
+#include "JumpPointTable.h"
+#include "Maze.h"
+#include "SearchContext.h"
+#include <queue>
+#include <vector>
+
+/**
+ * @brief Open-list policy for SearchEngine implementing Jump Point Search on
+ * a 4-connected, uniform-cost grid.
+ *
+ * Instead of queueing every open neighbor, the search jumps in straight lines
+ * and only queues jump points: cells where an optimal path may have to turn.
+ * Paths are taken in a canonical form in which a horizontal run only turns
+ * vertical where that turn was blocked one cell earlier (a forced neighbor).
+ * Vertical runs may turn anywhere. A cell on a vertical run is therefore a
+ * jump point if a horizontal scan from it reaches a jump point. The goal is
+ * always a jump point.
+ *
+ * Jump points are ordered by f = g + h with the Manhattan distance as h, and
+ * ties on f go to the larger g, as in A*. Only jump points get visited marks
+ * and costs in the context. The cells skipped between them are filled in by
+ * finish(), so that the context holds the complete path for
+ * PathFinder::reconstructPath.
+ *
+ * Each jump point queued is counted in the counter given at construction.
+ *
+ * Given a JumpPointTable (JPS+), jumps are read from the table instead of
+ * scanned, and only the goal is checked at query time.
+ */
+class JumpPointPolicy {
+public:
+  /**
+   * @brief Construct a policy that scans for jump points, or reads them from
+   * a precomputed table.
+   * @param table Jump distances for the searched maze, or nullptr to scan.
+   * The table must outlive the search.
+   * @param queued Incremented for each jump point queued, or nullptr.
+   */
+  explicit JumpPointPolicy(const JumpPointTable *table = nullptr,
+                           std::uint64_t *queued = nullptr)
+      : table(table), queued(queued) {}
+
+  /**
+   * @brief Check whether a horizontal run entering (x, y) from (behind, y)
+   * is forced to consider turning there: a cell above or below is open while
+   * the one beside it, behind, is a wall.
+   * @param x The column being entered (must be valid).
+   * @param behind The column the run comes from (must be valid).
+   * @param y The row of the run.
+   */
+  static bool isForcedTurn(const Maze &maze, int x, int behind, int y) {
+    return (y > 0 && !maze.isWall(x, y - 1) && maze.isWall(behind, y - 1)) ||
+           (y + 1 < maze.getHeight() && !maze.isWall(x, y + 1) &&
+            maze.isWall(behind, y + 1));
+  }
+
+  void seed(const Maze &maze, SearchContext &context, CellIndex start,
+            CellIndex goal);
+
+  bool empty() const { return open.empty(); }
+
+  bool pop(const Maze &maze, SearchContext &context, CellIndex &cell);
+
+  /**
+   * @brief Jump from a jump point in every direction except back to its
+   * parent and queue the jump points found.
+   */
+  void expand(const Maze &maze, SearchContext &context, CellIndex cell);
+
+  /**
+   * @brief Record parent directions for the cells skipped by the jumps on
+   * the path from start to goal.
+   */
+  void finish(const Maze &maze, SearchContext &context, CellIndex start,
+              CellIndex goal);
+
+private:
+  struct Node {
+    CellIndex index;
+    PathCost fScore; // f = g + h
+    PathCost gScore; // Cost from start when the node was queued
+
+    bool operator>(const Node &other) const {
+      return fScore > other.fScore ||
+             (fScore == other.fScore && gScore < other.gScore);
+    }
+  };
+
+  /**
+   * @brief Scan along a row from (x, y), excluding (x, y) itself.
+   * @param dx -1 to scan left, 1 to scan right.
+   * @param jumpX Set to the column of the jump point, if one is found.
+   * @return true if a jump point was found before a wall or the border.
+   */
+  bool jumpHorizontal(const Maze &maze, int x, int y, int dx,
+                      int &jumpX) const;
+
+  /**
+   * @brief Scan along a column from (x, y), excluding (x, y) itself.
+   * @param dy -1 to scan up, 1 to scan down.
+   * @param jumpY Set to the row of the jump point, if one is found.
+   * @return true if a jump point was found before a wall or the border.
+   */
+  bool jumpVertical(const Maze &maze, int x, int y, int dy, int &jumpY) const;
+
+  /**
+   * @brief Jump from a cell using the precomputed table.
+   * @param dir The direction of the jump.
+   * @param found Set to the jump point, if one is found.
+   * @return true if a jump point (or the goal) was found.
+   */
+  bool jumpFromTable(const Maze &maze, CellIndex index, Coordinate coords,
+                     Direction dir, Coordinate &found) const;
+
+  PathCost estimate(Coordinate cell) const;
+
+  const JumpPointTable *table; // nullptr to scan for jump points
+  std::uint64_t *queued;       // Jump points queued, or nullptr
+  std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
+  Coordinate goalCoords;
+  Coordinate currentCoords; // Jump point being expanded
+  PathCost currentG = 0;    // g-score of the jump point being expanded
+};
+
+#endif // JUMP_POINT_POLICY_H
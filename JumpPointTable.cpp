@@ -0,0 +1,207 @@
+#include "JumpPointTable.h"
+
+#include "JumpPointPolicy.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+// Header of a jump table file (see JumpPointTable::saveToFile). Fields are
+// little-endian and the layout has no padding, so it is read in place.
+struct TableHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t headerSize;
+  std::uint32_t width;
+  std::uint32_t height;
+  std::uint64_t wallChecksum;
+  std::uint64_t reserved[4];
+};
+static_assert(sizeof(TableHeader) == 64, "header must be 64 bytes");
+
+constexpr char TABLE_MAGIC[8] = {'M', 'A', 'Z', 'E', 'J', 'P', 'S', '\0'};
+constexpr std::uint32_t TABLE_VERSION = 1;
+
+// The distances are written and mapped as raw host values
+bool isLittleEndian() {
+  const std::uint16_t probe = 1;
+  unsigned char low;
+  std::memcpy(&low, &probe, 1);
+  return low == 1;
+}
+
+// Distance from a cell given the one of the next cell along the jump: a
+// jump point next to the cell is 1 away, otherwise the next cell's outcome
+// is one step further
+std::int32_t extend(bool nextIsJumpPoint, std::int32_t next) {
+  if (nextIsJumpPoint)
+    return 1;
+  return next > 0 ? next + 1 : next - 1;
+}
+
+} // namespace
+
+JumpPointTable::JumpPointTable()
+    : width(0), height(0), wallChecksum(0), walls{0, 0}, distances(nullptr) {}
+
+JumpPointTable::JumpPointTable(const Maze &maze) : JumpPointTable() {
+  build(maze);
+}
+
+JumpPointTable::~JumpPointTable() = default;
+
+void JumpPointTable::build(const Maze &maze) {
+  const int w = maze.getWidth();
+  const int h = maze.getHeight();
+  const CellIndex cellCount = maze.getCellCount();
+  std::vector<std::int32_t> table(static_cast<std::size_t>(cellCount) * 4);
+
+  auto at = [&](int x, int y, Direction dir) -> std::int32_t & {
+    const CellIndex index =
+        static_cast<CellIndex>(y) * static_cast<CellIndex>(w) +
+        static_cast<CellIndex>(x);
+    return table[index * 4 + static_cast<unsigned>(dir)];
+  };
+
+  // Horizontal jumps stop at forced turns, so each row is swept once per
+  // direction, reusing the result of the neighbor further along
+  for (int y = 0; y < h; ++y) {
+    for (int x = w - 1; x >= 0; --x) {
+      const int next = x + 1;
+      at(x, y, Direction::RIGHT) =
+          next >= w || maze.isWall(next, y)
+              ? 0
+              : extend(JumpPointPolicy::isForcedTurn(maze, next, x, y),
+                       at(next, y, Direction::RIGHT));
+    }
+    for (int x = 0; x < w; ++x) {
+      const int next = x - 1;
+      at(x, y, Direction::LEFT) =
+          next < 0 || maze.isWall(next, y)
+              ? 0
+              : extend(JumpPointPolicy::isForcedTurn(maze, next, x, y),
+                       at(next, y, Direction::LEFT));
+    }
+  }
+
+  // A cell on a vertical run is a jump point if a horizontal jump from it
+  // finds one. Columns are swept a row at a time to stay cache friendly.
+  auto turns = [&](int x, int y) {
+    return at(x, y, Direction::LEFT) > 0 || at(x, y, Direction::RIGHT) > 0;
+  };
+  for (int y = h - 1; y >= 0; --y) {
+    for (int x = 0; x < w; ++x) {
+      const int next = y + 1;
+      at(x, y, Direction::DOWN) =
+          next >= h || maze.isWall(x, next)
+              ? 0
+              : extend(turns(x, next), at(x, next, Direction::DOWN));
+    }
+  }
+  for (int y = 0; y < h; ++y) {
+    for (int x = 0; x < w; ++x) {
+      const int next = y - 1;
+      at(x, y, Direction::UP) =
+          next < 0 || maze.isWall(x, next)
+              ? 0
+              : extend(turns(x, next), at(x, next, Direction::UP));
+    }
+  }
+
+  width = w;
+  height = h;
+  wallChecksum = maze.getWallChecksum();
+  walls = maze.getWallVersion();
+  owned.swap(table);
+  mapping.reset();
+  distances = owned.data();
+}
+
+bool JumpPointTable::saveToFile(const std::string &filename) const {
+  if (!isLittleEndian()) {
+    std::cerr << "Error: Jump table files need a little-endian host"
+              << std::endl;
+    return false;
+  }
+  if (!distances) {
+    std::cerr << "Error: No jump table to save" << std::endl;
+    return false;
+  }
+
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << "Error: Could not create file " << filename << std::endl;
+    return false;
+  }
+
+  TableHeader header{};
+  std::memcpy(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+  header.version = TABLE_VERSION;
+  header.headerSize = sizeof(header);
+  header.width = static_cast<std::uint32_t>(width);
+  header.height = static_cast<std::uint32_t>(height);
+  header.wallChecksum = wallChecksum;
+
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(distances),
+             static_cast<std::streamsize>(getMemoryBytes()));
+  return static_cast<bool>(file);
+}
+
+bool JumpPointTable::loadFromFile(const std::string &filename,
+                                  const Maze &maze) {
+  if (!isLittleEndian()) {
+    std::cerr << "Error: Jump table files need a little-endian host"
+              << std::endl;
+    return false;
+  }
+
+  auto file = std::make_shared<MappedFile>();
+  if (!file->open(filename)) {
+    std::cerr << "Error: Could not open file " << filename << std::endl;
+    return false;
+  }
+
+  TableHeader header;
+  if (file->size() < sizeof(header) ||
+      std::memcmp(file->data(), TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0) {
+    std::cerr << "Error: " << filename << " is not a jump table file"
+              << std::endl;
+    return false;
+  }
+  std::memcpy(&header, file->data(), sizeof(header));
+
+  if (header.version != TABLE_VERSION || header.headerSize != sizeof(header)) {
+    std::cerr << "Error: Unsupported jump table version " << header.version
+              << std::endl;
+    return false;
+  }
+
+  if (header.width != static_cast<std::uint32_t>(maze.getWidth()) ||
+      header.height != static_cast<std::uint32_t>(maze.getHeight()) ||
+      header.wallChecksum != maze.getWallChecksum()) {
+    std::cerr << "Error: " << filename << " was built for a different maze"
+              << std::endl;
+    return false;
+  }
+
+  const std::size_t bytes = static_cast<std::size_t>(maze.getCellCount()) * 4 *
+                            sizeof(std::int32_t);
+  if (file->size() - sizeof(header) < bytes) {
+    std::cerr << "Error: Truncated jump table in " << filename << std::endl;
+    return false;
+  }
+
+  width = maze.getWidth();
+  height = maze.getHeight();
+  wallChecksum = header.wallChecksum;
+  walls = maze.getWallVersion();
+  std::vector<std::int32_t>().swap(owned);
+  // The header is 64 bytes and the mapping is page aligned
+  distances =
+      reinterpret_cast<const std::int32_t *>(file->data() + sizeof(header));
+  mapping = std::move(file);
+  return true;
+}
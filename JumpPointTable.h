@@ -0,0 +1,126 @@
+#ifndef JUMP_POINT_TABLE_H
+#define JUMP_POINT_TABLE_H
+
+#include "Maze.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class MappedFile;
+
+/**
+ * @brief Precomputed jump distances for JPS+ (see JPSPlusPathfinder).
+ *
+ * For every cell and each of the four Directions the table holds how far a
+ * jump in that direction goes, using the rules of JumpPointPolicy:
+ * - a positive value d means the jump stops at a jump point d cells away;
+ * - zero or a negative value -d means there is no jump point before the
+ *   wall or border, which is d + 1 cells away (d open cells to cross).
+ *
+ * Goals are not part of the table; JumpPointPolicy checks at query time
+ * whether a jump passes the goal. The table depends only on the walls, so it
+ * is built once per maze and must be rebuilt after any wall changes. It
+ * records the wall version (Maze::getWallVersion()) it was built or loaded
+ * for, so isCurrent() tells in O(1) whether the walls have changed since.
+ *
+ * Entries are 32-bit and stored per cell in Direction order, so an expansion
+ * reads one 16-byte block. The table takes 16 bytes per cell.
+ *
+ * Tables can be saved next to the maze they were built for and loaded
+ * without recomputation. Like Maze::loadFromBinaryFile(), loading maps the
+ * file and reads the distances in place.
+ */
+class JumpPointTable {
+public:
+  /**
+   * @brief Construct an empty table; see build() and loadFromFile().
+   */
+  JumpPointTable();
+
+  /**
+   * @brief Construct a table for a maze.
+   * @param maze The maze to preprocess.
+   */
+  explicit JumpPointTable(const Maze &maze);
+
+  ~JumpPointTable();
+
+  /**
+   * @brief Compute the jump distances of a maze, replacing any table held.
+   * Takes four passes over the wall bitmap, O(cells) in total.
+   * @param maze The maze to preprocess.
+   */
+  void build(const Maze &maze);
+
+  /**
+   * @brief Save the table to a file.
+   *
+   * File format (version 1, little-endian): a 64-byte header with the magic
+   * "MAZEJPS\0", version, header size, width, height, the wall checksum of
+   * the maze (Maze::getWallChecksum()) and reserved bytes, followed by the
+   * distances as int32 values, four per cell in cell index order.
+   *
+   * @param filename Path to the file to create or overwrite.
+   * @return true if the file was written successfully, false otherwise.
+   */
+  bool saveToFile(const std::string &filename) const;
+
+  /**
+   * @brief Load a table saved by saveToFile() for a given maze.
+   * @param filename Path to the table file.
+   * @param maze The maze the table will be used with; its size and wall
+   * checksum must match those the table was built for.
+   * @return true if the table was loaded successfully, false otherwise (the
+   * table is left unchanged).
+   */
+  bool loadFromFile(const std::string &filename, const Maze &maze);
+
+  /**
+   * @brief Check whether the table was built or loaded for a maze of this
+   * size. The walls are not compared.
+   */
+  bool matches(const Maze &maze) const {
+    return maze.getWidth() == width && maze.getHeight() == height;
+  }
+
+  /**
+   * @brief Check whether the table was built or loaded for this maze and
+   * its walls have not been edited since.
+   */
+  bool isCurrent(const Maze &maze) const {
+    return matches(maze) && maze.getWallVersion() == walls;
+  }
+
+  /**
+   * @brief Get the jump distance from a cell in a direction.
+   * @param index The cell index (must be a cell of the table's maze).
+   * @param dir The direction of the jump.
+   * @return A positive distance to a jump point, or minus the number of open
+   * cells before the wall.
+   */
+  std::int32_t distance(CellIndex index, Direction dir) const {
+    return distances[index * 4 + static_cast<unsigned>(dir)];
+  }
+
+  /**
+   * @brief Get the size of the distance table in bytes.
+   */
+  std::size_t getMemoryBytes() const {
+    return static_cast<std::size_t>(width) * static_cast<std::size_t>(height) *
+           4 * sizeof(std::int32_t);
+  }
+
+private:
+  int width;
+  int height;
+  std::uint64_t wallChecksum;      // Maze::getWallChecksum() of the maze
+  Maze::WallVersion walls;         // Maze::getWallVersion() at build or load
+  std::vector<std::int32_t> owned; // Distances, when built in memory
+
+  // Distances of a loaded table, read in place from the mapping
+  std::shared_ptr<const MappedFile> mapping;
+  const std::int32_t *distances; // owned.data() or into the mapping
+};
+
+#endif // JUMP_POINT_TABLE_H
@@ -0,0 +1,107 @@
+#include "JunctionGraph.h"
+
+#include <algorithm>
+
+JunctionGraph::JunctionGraph()
+    : width(0), height(0), walls{0, 0}, costs{0, 0}, firstEdges(1, 0) {}
+
+JunctionGraph::JunctionGraph(const Maze &maze) : JunctionGraph() {
+  build(maze);
+}
+
+void JunctionGraph::build(const Maze &maze) {
+  width = maze.getWidth();
+  height = maze.getHeight();
+  walls = maze.getWallVersion();
+  costs = maze.getCostVersion();
+  nodes.clear();
+  edges.clear();
+
+  auto openAt = [&](CellIndex cell) {
+    const Coordinate coords = maze.coordsOf(cell);
+    return maze.openDirections(coords.x, coords.y);
+  };
+
+  // Every open cell that is not part of a corridor is a node
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      if (!maze.isWall(x, y) && countOpen(maze.openDirections(x, y)) != 2)
+        nodes.push_back(maze.indexOf(x, y));
+    }
+  }
+
+  // Corridors reached from those nodes; any other corridor cell lies on a
+  // loop without junctions, which gets its first cell as a node
+  std::vector<bool> covered(static_cast<std::size_t>(maze.getCellCount()));
+  auto cover = [&](CellIndex cell, Direction) {
+    covered[cell] = true;
+    return false;
+  };
+  for (CellIndex node : nodes) {
+    const std::uint8_t open = openAt(node);
+    for (unsigned d = 0; d < 4; ++d) {
+      if (open & (1u << d))
+        walkCorridor(maze, node, static_cast<Direction>(d), cover);
+    }
+  }
+  const std::size_t junctionCount = nodes.size();
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const CellIndex cell = maze.indexOf(x, y);
+      if (maze.isWall(x, y) || covered[cell] ||
+          countOpen(maze.openDirections(x, y)) != 2)
+        continue;
+      nodes.push_back(cell);
+      covered[cell] = true;
+      const std::uint8_t open = openAt(cell);
+      unsigned d = 0;
+      while (!(open & (1u << d)))
+        ++d;
+      walkCorridor(maze, cell, static_cast<Direction>(d),
+                   [&](CellIndex next, Direction) {
+                     covered[next] = true;
+                     return next == cell;
+                   });
+    }
+  }
+  if (nodes.size() > junctionCount)
+    std::sort(nodes.begin(), nodes.end());
+
+  // One edge per corridor end, in node order
+  const std::uint8_t *cellCosts = maze.getCostPlane();
+  firstEdges.assign(nodes.size() + 1, 0);
+  for (std::uint64_t node = 0; node < nodes.size(); ++node) {
+    firstEdges[node] = edges.size();
+    const std::uint8_t open = openAt(nodes[node]);
+    for (unsigned d = 0; d < 4; ++d) {
+      if (!(open & (1u << d)))
+        continue;
+      PathCost cost = 0;
+      const CellIndex end = walkCorridor(
+          maze, nodes[node], static_cast<Direction>(d),
+          [&](CellIndex cell, Direction) {
+            cost += cellCosts ? cellCosts[cell] : 1;
+            return nodes.size() > junctionCount &&
+                   std::binary_search(nodes.begin(), nodes.end(), cell);
+          });
+      const std::uint64_t target = findNode(end);
+      if (target != node)
+        edges.push_back({target, cost, static_cast<Direction>(d)});
+    }
+  }
+  firstEdges[nodes.size()] = edges.size();
+  edges.shrink_to_fit();
+}
+
+std::uint64_t JunctionGraph::findNode(CellIndex cell) const {
+  auto it = std::lower_bound(nodes.begin(), nodes.end(), cell);
+  if (it == nodes.end() || *it != cell)
+    return NO_NODE;
+  return static_cast<std::uint64_t>(it - nodes.begin());
+}
+
+std::size_t JunctionGraph::getMemoryBytes() const {
+  return nodes.capacity() * sizeof(CellIndex) +
+         firstEdges.capacity() * sizeof(std::uint64_t) +
+         edges.capacity() * sizeof(Edge);
+}
@@ -0,0 +1,181 @@
+#ifndef JUNCTION_GRAPH_H
+#define JUNCTION_GRAPH_H
+
+#include "Maze.h"
+#include "SearchContext.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The open cells of a maze with every corridor contracted into one
+ * edge (see JunctionPathfinder).
+ *
+ * The nodes are the open cells that do not have exactly two open
+ * neighbors: junctions, dead ends and isolated cells. A corridor is a chain
+ * of cells with two open neighbors each; it becomes one edge between the
+ * nodes at its ends, weighted by the terrain costs of the cells a walk along
+ * it enters. A loop of corridor cells without any junction gets one of its
+ * cells as a node, so that every open cell lies on a corridor between nodes
+ * or is a node. Corridors that lead back to the node they start from are
+ * dropped.
+ *
+ * Mazes carved by RECURSIVE_BACKTRACKING and RANDOMIZED_PRIMS are mostly
+ * corridors, so the graph has far fewer nodes than the maze has open cells.
+ * Edges do not store their cells: a path is rebuilt by walking each
+ * corridor again from its first step (see walkCorridor()). Nodes take 16
+ * bytes and edges 16 bytes each, so on open areas, where most cells have
+ * more than two open neighbors, the graph outgrows the maze.
+ *
+ * The graph depends on the walls and costs, so it is built once per maze
+ * and must be rebuilt after any change. It records their versions
+ * (Maze::getWallVersion() and getCostVersion()), so isCurrent() tells in
+ * O(1) whether either has changed since. It is 4-connected.
+ */
+class JunctionGraph {
+public:
+  /**
+   * @brief Node number returned by findNode() for cells that are not nodes.
+   */
+  static constexpr std::uint64_t NO_NODE = ~std::uint64_t{0};
+
+  /**
+   * @brief A corridor leaving a node.
+   */
+  struct Edge {
+    std::uint64_t target; // Node at the other end
+    PathCost cost;        // Terrain cost of the cells entered, target included
+    Direction direction;  // First step from the node into the corridor
+  };
+
+  /**
+   * @brief Construct an empty graph; see build().
+   */
+  JunctionGraph();
+
+  /**
+   * @brief Construct the graph of a maze.
+   * @param maze The maze to contract.
+   */
+  explicit JunctionGraph(const Maze &maze);
+
+  /**
+   * @brief Contract the corridors of a maze, replacing any graph held.
+   * Walks every corridor from both ends, O(cells) in total.
+   * @param maze The maze to contract.
+   */
+  void build(const Maze &maze);
+
+  /**
+   * @brief Check whether the graph was built for a maze of this size. The
+   * walls are not compared.
+   */
+  bool matches(const Maze &maze) const {
+    return maze.getWidth() == width && maze.getHeight() == height;
+  }
+
+  /**
+   * @brief Check whether the graph was built for this maze and its walls
+   * and costs have not been edited since.
+   */
+  bool isCurrent(const Maze &maze) const {
+    return matches(maze) && maze.getWallVersion() == walls &&
+           maze.getCostVersion() == costs;
+  }
+
+  /**
+   * @brief Get the number of nodes.
+   */
+  std::uint64_t getNodeCount() const { return nodes.size(); }
+
+  /**
+   * @brief Get the number of edges; each corridor counts once per
+   * direction.
+   */
+  std::uint64_t getEdgeCount() const { return edges.size(); }
+
+  /**
+   * @brief Get the cell of a node.
+   * @param node The node number, below getNodeCount().
+   */
+  CellIndex getNodeCell(std::uint64_t node) const { return nodes[node]; }
+
+  /**
+   * @brief Find the node of a cell.
+   * @param cell The cell index.
+   * @return The node number, or NO_NODE if the cell is not a node.
+   */
+  std::uint64_t findNode(CellIndex cell) const;
+
+  /**
+   * @brief Get the corridors leaving a node, as [begin, end).
+   * @param node The node number, below getNodeCount().
+   */
+  const Edge *edgesBegin(std::uint64_t node) const {
+    return edges.data() + firstEdges[node];
+  }
+  const Edge *edgesEnd(std::uint64_t node) const {
+    return edges.data() + firstEdges[node + 1];
+  }
+
+  /**
+   * @brief Get the memory held by the graph in bytes.
+   */
+  std::size_t getMemoryBytes() const;
+
+  /**
+   * @brief Walk along a corridor.
+   *
+   * Steps from a cell in a direction, then on through cells with exactly
+   * two open neighbors without turning back.
+   *
+   * @param maze The maze.
+   * @param from The cell to walk from.
+   * @param dir The first step (its target must be open).
+   * @param stop Callable invoked as stop(CellIndex cell, Direction step) for
+   * every cell entered, where step is the move into it. The walk ends when
+   * it returns true or at a cell without exactly two open neighbors.
+   * @return The last cell entered.
+   */
+  template <typename Stop>
+  static CellIndex walkCorridor(const Maze &maze, CellIndex from,
+                                Direction dir, Stop &&stop);
+
+private:
+  // Number of open neighbors from an open-direction mask
+  static int countOpen(std::uint8_t open) {
+    return (open & 1) + ((open >> 1) & 1) + ((open >> 2) & 1) +
+           ((open >> 3) & 1);
+  }
+
+  int width;
+  int height;
+  Maze::WallVersion walls;                // Maze::getWallVersion() at build
+  Maze::WallVersion costs;                // Maze::getCostVersion() at build
+  std::vector<CellIndex> nodes;           // Node cells, ascending
+  std::vector<std::uint64_t> firstEdges;  // Per node, then the edge count
+  std::vector<Edge> edges;                // Grouped by node
+};
+
+template <typename Stop>
+CellIndex JunctionGraph::walkCorridor(const Maze &maze, CellIndex from,
+                                      Direction dir, Stop &&stop) {
+  CellIndex cell = maze.neighborIndex(from, dir);
+  Direction step = dir;
+  while (!stop(cell, step)) {
+    const Coordinate coords = maze.coordsOf(cell);
+    std::uint8_t open = maze.openDirections(coords.x, coords.y);
+    if (countOpen(open) != 2)
+      break;
+    // Leave by the other open side
+    open &= static_cast<std::uint8_t>(
+        ~(1u << SearchContext::oppositeDirection(step)));
+    unsigned next = 0;
+    while (!(open & (1u << next)))
+      ++next;
+    step = static_cast<Direction>(next);
+    cell = maze.neighborIndex(cell, step);
+  }
+  return cell;
+}
+
+#endif // JUNCTION_GRAPH_H
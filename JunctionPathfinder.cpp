@@ -0,0 +1,239 @@
+#include "JunctionPathfinder.h"
+
+#include "AStarPathfinder.h"
+#include <algorithm>
+#include <chrono>
+#include <queue>
+#include <stdexcept>
+
+namespace {
+
+struct Node {
+  CellIndex cell;
+  std::uint64_t number; // Node number, or the start's or goal's
+  PathCost fScore;      // f = g + h
+  std::size_t parent;   // Position of the parent's entry in the trail
+  Direction direction;  // First step from the parent into the corridor
+
+  bool operator>(const Node &other) const { return fScore > other.fScore; }
+};
+
+// An expanded node and how it was reached
+struct TrailEntry {
+  CellIndex cell;
+  std::size_t parent;
+  Direction direction;
+};
+
+// A corridor between a start or goal inside it and one of its ends
+struct Attachment {
+  CellIndex end;
+  PathCost cost;
+  Direction direction; // First step of the walk
+};
+
+} // namespace
+
+JunctionPathfinder::JunctionPathfinder(
+    std::shared_ptr<const JunctionGraph> graph)
+    : graph(std::move(graph)) {}
+
+template <typename Visitor>
+bool JunctionPathfinder::searchGraph(const Maze &maze, SearchContext &context,
+                                     CellIndex start, CellIndex goal,
+                                     Visitor &visit,
+                                     std::vector<Hop> &hops) const {
+  const std::uint8_t *cellCosts = maze.getCostPlane();
+  auto costOf = [&](CellIndex index) -> PathCost {
+    return cellCosts ? cellCosts[index] : 1;
+  };
+  auto isNode = [&](CellIndex cell) {
+    return graph->findNode(cell) != JunctionGraph::NO_NODE;
+  };
+  auto openAt = [&](CellIndex cell) {
+    const Coordinate coords = maze.coordsOf(cell);
+    return maze.openDirections(coords.x, coords.y);
+  };
+
+  // A start inside a corridor leads to both its ends, or to the goal if it
+  // lies on the way
+  const std::uint64_t startNode = graph->findNode(start);
+  std::vector<Attachment> fromStart;
+  if (startNode == JunctionGraph::NO_NODE) {
+    const std::uint8_t open = openAt(start);
+    for (unsigned d = 0; d < 4; ++d) {
+      if (!(open & (1u << d)))
+        continue;
+      PathCost cost = 0;
+      const CellIndex end = JunctionGraph::walkCorridor(
+          maze, start, static_cast<Direction>(d),
+          [&](CellIndex cell, Direction) {
+            cost += costOf(cell);
+            return cell == goal || isNode(cell);
+          });
+      fromStart.push_back({end, cost, static_cast<Direction>(d)});
+    }
+  }
+
+  // A goal inside a corridor is reached from both its ends; the walks run
+  // from the goal, so their last step is reversed
+  const std::uint64_t goalNode = graph->findNode(goal);
+  std::vector<Attachment> toGoal;
+  if (goalNode == JunctionGraph::NO_NODE) {
+    const std::uint8_t open = openAt(goal);
+    for (unsigned d = 0; d < 4; ++d) {
+      if (!(open & (1u << d)))
+        continue;
+      PathCost cost = costOf(goal);
+      Direction last = static_cast<Direction>(d);
+      const CellIndex end = JunctionGraph::walkCorridor(
+          maze, goal, static_cast<Direction>(d),
+          [&](CellIndex cell, Direction step) {
+            last = step;
+            if (isNode(cell))
+              return true;
+            cost += costOf(cell);
+            return false;
+          });
+      toGoal.push_back({end, cost,
+                        static_cast<Direction>(
+                            SearchContext::oppositeDirection(last))});
+    }
+  }
+
+  // The start and goal are numbered after the nodes unless they are nodes.
+  // Nodes are distinct open cells, so the numbers stay below the cell count
+  // and the reverse context can hold their marks and costs.
+  std::uint64_t nextNumber = graph->getNodeCount();
+  const std::uint64_t startNumber =
+      startNode != JunctionGraph::NO_NODE ? startNode : nextNumber++;
+  const std::uint64_t goalNumber =
+      goal == start ? startNumber
+                    : (goalNode != JunctionGraph::NO_NODE ? goalNode
+                                                          : nextNumber++);
+
+  SearchContext &reverse = context.getReverse();
+  reverse.begin(maze);
+  reverse.reserveCosts();
+  std::vector<TrailEntry> trail;
+  std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
+  const Coordinate goalCoords = maze.coordsOf(goal);
+  const PathCost minCost = maze.getMinCost();
+  auto estimate = [&](CellIndex cell) {
+    return AStarPathfinder::heuristic(maze.coordsOf(cell), goalCoords) *
+           minCost;
+  };
+
+  PathCost g = 0;
+  std::size_t entry = 0; // Trail entry of the node being expanded
+  auto relax = [&](CellIndex cell, std::uint64_t number, PathCost edge,
+                   Direction direction) {
+    if (!reverse.relax(number, g + edge, 0))
+      return;
+    open.push({cell, number, g + edge + estimate(cell), entry, direction});
+  };
+
+  PathStats &stats = context.getStats();
+  reverse.relax(startNumber, 0, SearchContext::ROOT_PARENT);
+  open.push({start, startNumber, estimate(start), 0, Direction::UP});
+  bool found = false;
+  while (!open.empty()) {
+    const Node top = open.top();
+    open.pop();
+    if (reverse.isClosed(top.number))
+      continue;
+    reverse.markClosed(top.number);
+    entry = trail.size();
+    trail.push_back({top.cell, top.parent, top.direction});
+    visit(top.cell);
+    ++stats.nodesExplored;
+    if (top.number == goalNumber) {
+      found = true;
+      break;
+    }
+    g = reverse.getCost(top.number);
+
+    if (top.number == startNumber) {
+      for (const Attachment &corridor : fromStart) {
+        relax(corridor.end,
+              corridor.end == goal ? goalNumber
+                                   : graph->findNode(corridor.end),
+              corridor.cost, corridor.direction);
+      }
+    }
+    if (top.number >= graph->getNodeCount())
+      continue;
+    for (const JunctionGraph::Edge *edge = graph->edgesBegin(top.number);
+         edge != graph->edgesEnd(top.number); ++edge) {
+      relax(graph->getNodeCell(edge->target), edge->target, edge->cost,
+            edge->direction);
+    }
+    for (const Attachment &corridor : toGoal) {
+      if (corridor.end == top.cell)
+        relax(goal, goalNumber, corridor.cost, corridor.direction);
+    }
+  }
+  if (!found)
+    return false;
+
+  // The start's entry is the first and its own parent
+  for (std::size_t i = entry; i != 0; i = trail[i].parent)
+    hops.push_back({trail[i].cell, trail[i].direction});
+  std::reverse(hops.begin(), hops.end());
+  return true;
+}
+
+std::vector<Cell> JunctionPathfinder::findPath(
+    const Maze &maze, SearchContext &context, std::shared_ptr<Cell> start,
+    std::shared_ptr<Cell> goal,
+    std::function<void(std::shared_ptr<Cell>)> onVisit) const {
+  if (!graph || !graph->matches(maze)) {
+    throw std::invalid_argument("Junction graph was not built for this maze");
+  }
+  requireFourConnected(context, "Junction graph search");
+  if (!graph->isCurrent(maze))
+    return fallback.findPath(maze, context, start, goal, onVisit);
+  auto startTime = std::chrono::high_resolution_clock::now();
+
+  context.begin(maze);
+  if (!start || !goal || maze.isWall(start->getX(), start->getY()) ||
+      maze.isWall(goal->getX(), goal->getY())) {
+    return context.getPath();
+  }
+
+  const CellIndex startIndex = maze.indexOf(start->getX(), start->getY());
+  const CellIndex goalIndex = maze.indexOf(goal->getX(), goal->getY());
+
+  std::vector<Hop> hops;
+  bool found;
+  if (isUnreachable(maze, context, startIndex, goalIndex)) {
+    found = false;
+  } else if (onVisit) {
+    CellCallbackVisitor visitor(maze, onVisit);
+    found = searchGraph(maze, context, startIndex, goalIndex, visitor, hops);
+  } else {
+    NullVisitor visitor;
+    found = searchGraph(maze, context, startIndex, goalIndex, visitor, hops);
+  }
+
+  if (found) {
+    // Walk each corridor of the path again to recover its cells
+    context.markVisited(startIndex, SearchContext::ROOT_PARENT);
+    CellIndex from = startIndex;
+    for (const Hop &hop : hops) {
+      JunctionGraph::walkCorridor(
+          maze, from, hop.direction, [&](CellIndex cell, Direction step) {
+            context.markVisited(cell, SearchContext::oppositeDirection(step));
+            return cell == hop.cell;
+          });
+      from = hop.cell;
+    }
+    reconstructPath(maze, context, startIndex, goalIndex);
+  }
+
+  auto endTime = std::chrono::high_resolution_clock::now();
+  context.getStats().executionTime =
+      std::chrono::duration<double, std::milli>(endTime - startTime);
+
+  return context.getPath();
+}
@@ -0,0 +1,85 @@
+#ifndef JUNCTION_PATHFINDER_H
+#define JUNCTION_PATHFINDER_H
+
+#include "AStarPathfinder.h"
+#include "JunctionGraph.h"
+#include "Maze.h"
+#include "PathFinder.h"
+#include <memory>
+
+/**
+ * @brief A* over a JunctionGraph, with corridors as single edges.
+ *
+ * A start or goal inside a corridor is attached to the nodes at the
+ * corridor's ends (and directly to the other one if both lie on the same
+ * corridor) by walking the corridor. A* then runs over the nodes with the
+ * Manhattan distance scaled by Maze::getMinCost(), which no corridor can
+ * beat, and the path is expanded back into cells by walking each corridor
+ * it uses. Paths are as cheap as those of AStarPathfinder. If the walls or
+ * costs have changed since the graph was built, the query falls back to A*.
+ *
+ * The search's marks and costs are kept in the context's reverse context,
+ * indexed by node number; stats.nodesExplored counts the expanded nodes.
+ * There is no path from or to a wall cell.
+ *
+ * Corridors are walked on the maze and nodes searched in the context, so
+ * the graph stays constant during queries: threads with their own
+ * contexts may search through one graph together. JunctionGraph::build()
+ * is the only call that must not run alongside them.
+ */
+class JunctionPathfinder : public PathFinder {
+public:
+  using PathFinder::findPath;
+
+  /**
+   * @brief Construct a pathfinder that uses a precomputed graph.
+   * @param graph The junction graph of the mazes that will be searched.
+   */
+  explicit JunctionPathfinder(std::shared_ptr<const JunctionGraph> graph);
+
+  /**
+   * @brief Find a path from start to goal on the junction graph.
+   * @param maze The maze to search; it must have the size of the maze the
+   * graph was built for.
+   * @param context The per-query state to use.
+   * @param start The starting cell.
+   * @param goal The goal cell.
+   * @param onVisit Optional callback for animation, called for the cell of
+   * each expanded node (default: nullptr).
+   * @return A vector of cells representing the path, or empty if no path
+   * exists.
+   * @throws std::invalid_argument if the graph was built for a maze of a
+   * different size, or if the context's movement is not 4-connected.
+   */
+  std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const override;
+
+private:
+  /**
+   * @brief One step of a path over the graph: the corridor walked from the
+   * previous cell, and the cell it ends at.
+   */
+  struct Hop {
+    CellIndex cell;
+    Direction direction;
+  };
+
+  /**
+   * @brief Run A* over the graph, extended by the start and goal.
+   * @param visit Called with the cell of every expanded node.
+   * @param hops Receives the hops from the start to the goal.
+   * @return true if a path was found.
+   */
+  template <typename Visitor>
+  bool searchGraph(const Maze &maze, SearchContext &context, CellIndex start,
+                   CellIndex goal, Visitor &visit,
+                   std::vector<Hop> &hops) const;
+
+  std::shared_ptr<const JunctionGraph> graph;
+  AStarPathfinder fallback; // For mazes the graph does not describe
+};
+
+#endif // JUNCTION_PATHFINDER_H
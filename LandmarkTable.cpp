@@ -0,0 +1,301 @@
+#include "LandmarkTable.h"
+
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Header of a landmark table file (see LandmarkTable::saveToFile). Fields
+// are little-endian and the layout has no padding, so it is read in place.
+struct TableHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t headerSize;
+  std::uint32_t width;
+  std::uint32_t height;
+  std::uint32_t landmarkCount;
+  std::uint32_t reserved32;
+  std::uint64_t wallChecksum;
+  std::uint64_t costChecksum;
+  std::uint64_t reserved[2];
+};
+static_assert(sizeof(TableHeader) == 64, "header must be 64 bytes");
+
+constexpr char TABLE_MAGIC[8] = {'M', 'A', 'Z', 'E', 'A', 'L', 'T', '\0'};
+constexpr std::uint32_t TABLE_VERSION = 1;
+
+// The distances are written and mapped as raw host values
+bool isLittleEndian() {
+  const std::uint16_t probe = 1;
+  unsigned char low;
+  std::memcpy(&low, &probe, 1);
+  return low == 1;
+}
+
+// 64-bit FNV-1a of the cost plane, 0 if every cell costs 1
+std::uint64_t costChecksumOf(const Maze &maze) {
+  const std::uint8_t *costs = maze.getCostPlane();
+  if (!costs)
+    return 0;
+  std::uint64_t hash = 14695981039346656037ull;
+  for (CellIndex i = 0; i < maze.getCellCount(); ++i) {
+    hash ^= costs[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// Cost of the cheapest path from a cell to every cell, UNREACHABLE if none:
+// breadth-first without costs, Dijkstra's algorithm with them. Costs that
+// do not fit the 32-bit entries are stored as SATURATED.
+void distancesFrom(const Maze &maze, CellIndex source,
+                   std::vector<std::uint32_t> &distance) {
+  distance.assign(static_cast<std::size_t>(maze.getCellCount()),
+                  LandmarkTable::UNREACHABLE);
+  distance[source] = 0;
+
+  const std::uint8_t *costs = maze.getCostPlane();
+  if (!costs) {
+    std::vector<CellIndex> queue{source};
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      const CellIndex cell = queue[head];
+      const std::uint32_t next = static_cast<std::uint32_t>(
+          std::min<std::uint64_t>(distance[cell] + std::uint64_t{1},
+                                  LandmarkTable::SATURATED));
+      maze.forEachNeighbor(cell, [&](CellIndex neighbor, Direction) {
+        if (distance[neighbor] == LandmarkTable::UNREACHABLE) {
+          distance[neighbor] = next;
+          queue.push_back(neighbor);
+        }
+      });
+    }
+    return;
+  }
+
+  using Entry = std::pair<std::uint32_t, CellIndex>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  open.push({0, source});
+  while (!open.empty()) {
+    const Entry top = open.top();
+    open.pop();
+    if (top.first != distance[top.second])
+      continue;
+    maze.forEachNeighbor(top.second, [&](CellIndex neighbor, Direction) {
+      const std::uint32_t next = static_cast<std::uint32_t>(
+          std::min<std::uint64_t>(top.first + std::uint64_t{costs[neighbor]},
+                                  LandmarkTable::SATURATED));
+      if (next < distance[neighbor]) {
+        distance[neighbor] = next;
+        open.push({next, neighbor});
+      }
+    });
+  }
+}
+
+} // namespace
+
+LandmarkTable::LandmarkTable()
+    : width(0), height(0), wallChecksum(0), costChecksum(0), walls{0, 0},
+      costVersion{0, 0}, distances(nullptr) {}
+
+LandmarkTable::LandmarkTable(const Maze &maze, int count) : LandmarkTable() {
+  build(maze, count);
+}
+
+LandmarkTable::~LandmarkTable() = default;
+
+void LandmarkTable::build(const Maze &maze, int count) {
+  if (count < 1 || count > MAX_LANDMARKS) {
+    throw std::invalid_argument("Landmark count must be 1 to " +
+                                std::to_string(MAX_LANDMARKS));
+  }
+
+  const std::size_t cellCount = static_cast<std::size_t>(maze.getCellCount());
+  std::vector<CellIndex> chosen;
+  std::vector<std::uint32_t> table;
+
+  // Seed the farthest-point selection at the start, or the first open cell
+  CellIndex seed = maze.getCellCount();
+  const std::shared_ptr<Cell> start = maze.getStart();
+  if (start && !maze.isWall(start->getX(), start->getY()))
+    seed = maze.indexOf(start->getX(), start->getY());
+  for (CellIndex i = 0; seed == maze.getCellCount() && i < cellCount; ++i) {
+    const Coordinate coords = maze.coordsOf(i);
+    if (!maze.isWall(coords.x, coords.y))
+      seed = i;
+  }
+
+  if (seed != maze.getCellCount()) {
+    // The first landmark is the cell farthest from the seed; each next one
+    // the cell farthest from its nearest landmark
+    std::vector<std::uint32_t> distance;
+    distancesFrom(maze, seed, distance);
+    std::vector<std::uint32_t> nearest(cellCount, 0);
+    for (std::size_t i = 0; i < cellCount; ++i) {
+      if (distance[i] != UNREACHABLE)
+        nearest[i] = distance[i];
+    }
+    const std::size_t stride = static_cast<std::size_t>(count);
+    table.assign(cellCount * stride, UNREACHABLE);
+    while (chosen.size() < stride) {
+      CellIndex farthest = seed;
+      for (std::size_t i = 0; i < cellCount; ++i) {
+        if (nearest[i] > nearest[farthest])
+          farthest = i;
+      }
+      if (!chosen.empty() && nearest[farthest] == 0)
+        break; // Every cell of the region is a landmark
+      const std::size_t column = chosen.size();
+      chosen.push_back(farthest);
+      distancesFrom(maze, farthest, distance);
+      for (std::size_t i = 0; i < cellCount; ++i) {
+        table[i * stride + column] = distance[i];
+        // Distances from the seed only serve to find the first landmark
+        if (column == 0 && distance[i] != UNREACHABLE)
+          nearest[i] = distance[i];
+        else
+          nearest[i] = std::min(nearest[i], distance[i]);
+      }
+    }
+
+    // Close the gaps left by landmarks that were not needed
+    const std::size_t k = chosen.size();
+    if (k < stride) {
+      for (std::size_t i = 0; i < cellCount; ++i) {
+        for (std::size_t l = 0; l < k; ++l)
+          table[i * k + l] = table[i * stride + l];
+      }
+      table.resize(cellCount * k);
+      table.shrink_to_fit();
+    }
+  }
+
+  width = maze.getWidth();
+  height = maze.getHeight();
+  wallChecksum = maze.getWallChecksum();
+  costChecksum = costChecksumOf(maze);
+  walls = maze.getWallVersion();
+  costVersion = maze.getCostVersion();
+  landmarks.swap(chosen);
+  owned.swap(table);
+  mapping.reset();
+  distances = owned.data();
+}
+
+bool LandmarkTable::saveToFile(const std::string &filename) const {
+  if (!isLittleEndian()) {
+    std::cerr << "Error: Landmark table files need a little-endian host"
+              << std::endl;
+    return false;
+  }
+  if (!distances) {
+    std::cerr << "Error: No landmark table to save" << std::endl;
+    return false;
+  }
+
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << "Error: Could not create file " << filename << std::endl;
+    return false;
+  }
+
+  TableHeader header{};
+  std::memcpy(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+  header.version = TABLE_VERSION;
+  header.headerSize = sizeof(header);
+  header.width = static_cast<std::uint32_t>(width);
+  header.height = static_cast<std::uint32_t>(height);
+  header.landmarkCount = static_cast<std::uint32_t>(landmarks.size());
+  header.wallChecksum = wallChecksum;
+  header.costChecksum = costChecksum;
+
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(
+      reinterpret_cast<const char *>(landmarks.data()),
+      static_cast<std::streamsize>(landmarks.size() * sizeof(CellIndex)));
+  file.write(reinterpret_cast<const char *>(distances),
+             static_cast<std::streamsize>(getMemoryBytes()));
+  return static_cast<bool>(file);
+}
+
+bool LandmarkTable::loadFromFile(const std::string &filename,
+                                 const Maze &maze) {
+  if (!isLittleEndian()) {
+    std::cerr << "Error: Landmark table files need a little-endian host"
+              << std::endl;
+    return false;
+  }
+
+  auto file = std::make_shared<MappedFile>();
+  if (!file->open(filename)) {
+    std::cerr << "Error: Could not open file " << filename << std::endl;
+    return false;
+  }
+
+  TableHeader header;
+  if (file->size() < sizeof(header) ||
+      std::memcmp(file->data(), TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0) {
+    std::cerr << "Error: " << filename << " is not a landmark table file"
+              << std::endl;
+    return false;
+  }
+  std::memcpy(&header, file->data(), sizeof(header));
+
+  if (header.version != TABLE_VERSION || header.headerSize != sizeof(header)) {
+    std::cerr << "Error: Unsupported landmark table version "
+              << header.version << std::endl;
+    return false;
+  }
+  if (header.landmarkCount > static_cast<std::uint32_t>(MAX_LANDMARKS)) {
+    std::cerr << "Error: Too many landmarks in " << filename << std::endl;
+    return false;
+  }
+
+  if (header.width != static_cast<std::uint32_t>(maze.getWidth()) ||
+      header.height != static_cast<std::uint32_t>(maze.getHeight()) ||
+      header.wallChecksum != maze.getWallChecksum() ||
+      header.costChecksum != costChecksumOf(maze)) {
+    std::cerr << "Error: " << filename << " was built for a different maze"
+              << std::endl;
+    return false;
+  }
+
+  const std::size_t landmarkBytes = header.landmarkCount * sizeof(CellIndex);
+  const std::size_t bytes = static_cast<std::size_t>(maze.getCellCount()) *
+                            header.landmarkCount * sizeof(std::uint32_t);
+  if (file->size() - sizeof(header) < landmarkBytes + bytes) {
+    std::cerr << "Error: Truncated landmark table in " << filename
+              << std::endl;
+    return false;
+  }
+
+  std::vector<CellIndex> cells(header.landmarkCount);
+  std::memcpy(cells.data(), file->data() + sizeof(header), landmarkBytes);
+  for (CellIndex cell : cells) {
+    if (cell >= maze.getCellCount()) {
+      std::cerr << "Error: Invalid landmark in " << filename << std::endl;
+      return false;
+    }
+  }
+
+  width = maze.getWidth();
+  height = maze.getHeight();
+  wallChecksum = header.wallChecksum;
+  costChecksum = header.costChecksum;
+  walls = maze.getWallVersion();
+  costVersion = maze.getCostVersion();
+  landmarks.swap(cells);
+  std::vector<std::uint32_t>().swap(owned);
+  // The header and landmark cells keep the distances 8-byte aligned
+  distances = reinterpret_cast<const std::uint32_t *>(
+      file->data() + sizeof(header) + landmarkBytes);
+  mapping = std::move(file);
+  return true;
+}
@@ -0,0 +1,202 @@
+#ifndef LANDMARK_TABLE_H
+#define LANDMARK_TABLE_H
+
+#include "Maze.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class MappedFile;
+
+/**
+ * @brief Precomputed distances from landmark cells, for the ALT (A*,
+ * landmarks, triangle inequality) heuristic of AStarPathfinder.
+ *
+ * The table holds, for every cell, the cost of the cheapest 4-connected path
+ * from each landmark to it (UNREACHABLE if there is none). By the triangle
+ * inequality, d(L, goal) - d(L, n) is a lower bound on the cost from n to
+ * the goal, and so is the reverse difference, adjusted for the cost of
+ * entering n and the goal (see lowerBound()). In mazes, where the
+ * Manhattan distance is a poor estimate, the best of these bounds is often
+ * close to the true distance.
+ *
+ * Landmarks are chosen farthest-point first: the first is the cell farthest
+ * from the maze's start (or its first open cell), and each next one the
+ * cell farthest from all landmarks chosen so far. Each takes one
+ * breadth-first search (Dijkstra's algorithm with terrain costs), so
+ * building takes O(cells * landmarks).
+ *
+ * Distances are 32-bit and stored per cell in landmark order, so a lookup
+ * reads one block. The table takes 4 bytes per cell and landmark. Costs
+ * too large for an entry are stored as SATURATED and give no bound.
+ *
+ * Tables can be saved next to the maze they were built for and loaded
+ * without recomputation. Like JumpPointTable, loading maps the file and
+ * reads the distances in place. The table depends on the walls and costs,
+ * so it must be rebuilt after any change. It records their versions
+ * (Maze::getWallVersion() and getCostVersion()), so isCurrent() tells in
+ * O(1) whether either has changed since.
+ */
+class LandmarkTable {
+public:
+  /**
+   * @brief Distance stored for cells a landmark cannot reach.
+   */
+  static constexpr std::uint32_t UNREACHABLE = ~std::uint32_t{0};
+
+  /**
+   * @brief Distance stored for cells whose cost does not fit 32 bits.
+   */
+  static constexpr std::uint32_t SATURATED = UNREACHABLE - 1;
+
+  /**
+   * @brief The largest number of landmarks a table can hold.
+   */
+  static constexpr int MAX_LANDMARKS = 64;
+
+  /**
+   * @brief Construct an empty table; see build() and loadFromFile().
+   */
+  LandmarkTable();
+
+  /**
+   * @brief Construct a table for a maze.
+   * @param maze The maze to preprocess.
+   * @param count The number of landmarks.
+   * @throws std::invalid_argument if count is not 1 to MAX_LANDMARKS.
+   */
+  explicit LandmarkTable(const Maze &maze, int count = 8);
+
+  ~LandmarkTable();
+
+  /**
+   * @brief Choose landmarks and compute their distances, replacing any
+   * table held. Fewer landmarks are chosen if the start's region has fewer
+   * open cells.
+   * @param maze The maze to preprocess.
+   * @param count The number of landmarks.
+   * @throws std::invalid_argument if count is not 1 to MAX_LANDMARKS.
+   */
+  void build(const Maze &maze, int count = 8);
+
+  /**
+   * @brief Save the table to a file.
+   *
+   * File format (version 1, little-endian): a 64-byte header with the magic
+   * "MAZEALT\0", version, header size, width, height, landmark count, 4
+   * reserved bytes, the wall checksum of the maze (Maze::getWallChecksum()),
+   * an FNV-1a checksum of its cost plane (0 without one) and reserved
+   * bytes; then the landmark cell indices as uint64 values, followed by the
+   * distances as uint32 values, one per landmark for each cell in cell index
+   * order.
+   *
+   * @param filename Path to the file to create or overwrite.
+   * @return true if the file was written successfully, false otherwise.
+   */
+  bool saveToFile(const std::string &filename) const;
+
+  /**
+   * @brief Load a table saved by saveToFile() for a given maze.
+   * @param filename Path to the table file.
+   * @param maze The maze the table will be used with; its size, walls and
+   * costs must match those the table was built for.
+   * @return true if the table was loaded successfully, false otherwise (the
+   * table is left unchanged).
+   */
+  bool loadFromFile(const std::string &filename, const Maze &maze);
+
+  /**
+   * @brief Check whether the table was built or loaded for a maze of this
+   * size. The walls are not compared.
+   */
+  bool matches(const Maze &maze) const {
+    return maze.getWidth() == width && maze.getHeight() == height;
+  }
+
+  /**
+   * @brief Check whether the table was built or loaded for this maze and
+   * its walls and costs have not been edited since.
+   */
+  bool isCurrent(const Maze &maze) const {
+    return matches(maze) && maze.getWallVersion() == walls &&
+           maze.getCostVersion() == costVersion;
+  }
+
+  /**
+   * @brief Get the number of landmarks.
+   */
+  int getLandmarkCount() const { return static_cast<int>(landmarks.size()); }
+
+  /**
+   * @brief Get the cell of a landmark.
+   * @param landmark The landmark, below getLandmarkCount().
+   */
+  CellIndex getLandmark(int landmark) const { return landmarks[landmark]; }
+
+  /**
+   * @brief Get the distance from a landmark to a cell.
+   * @param index The cell index (must be a cell of the table's maze).
+   * @param landmark The landmark, below getLandmarkCount().
+   * @return The cost of the cheapest path, or UNREACHABLE.
+   */
+  std::uint32_t distance(CellIndex index, int landmark) const {
+    return distances[index * landmarks.size() +
+                     static_cast<std::size_t>(landmark)];
+  }
+
+  /**
+   * @brief Get the best landmark bound on the cost of moving between cells.
+   *
+   * For each landmark L that reaches both cells this is the larger of
+   * d(L, to) - d(L, from) and d(L, from) - d(L, to) - cost(from) +
+   * cost(to), where the second uses that reversing a path swaps which end
+   * is paid for. Landmarks that reach only one of the cells are skipped.
+   *
+   * @param from The cell index to estimate from.
+   * @param to The cell index to estimate to.
+   * @param costs The maze's cost plane (Maze::getCostPlane()), or nullptr.
+   * @return A lower bound on the cost of any path from one to the other.
+   */
+  PathCost lowerBound(CellIndex from, CellIndex to,
+                      const std::uint8_t *costs) const {
+    const std::size_t count = landmarks.size();
+    const std::uint32_t *a = distances + from * count;
+    const std::uint32_t *b = distances + to * count;
+    const std::int64_t entry =
+        costs ? std::int64_t{costs[to]} - std::int64_t{costs[from]} : 0;
+    std::int64_t best = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      if (a[i] >= SATURATED || b[i] >= SATURATED)
+        continue;
+      const std::int64_t difference = std::int64_t{b[i]} - std::int64_t{a[i]};
+      best = std::max(best, std::max(difference, -difference + entry));
+    }
+    return static_cast<PathCost>(best);
+  }
+
+  /**
+   * @brief Get the size of the distance table in bytes.
+   */
+  std::size_t getMemoryBytes() const {
+    return static_cast<std::size_t>(width) * static_cast<std::size_t>(height) *
+           landmarks.size() * sizeof(std::uint32_t);
+  }
+
+private:
+  int width;
+  int height;
+  std::uint64_t wallChecksum;       // Maze::getWallChecksum() of the maze
+  std::uint64_t costChecksum;       // Checksum of its cost plane, or 0
+  Maze::WallVersion walls;          // Maze::getWallVersion() at build or load
+  Maze::WallVersion costVersion;    // Maze::getCostVersion() at build or load
+  std::vector<CellIndex> landmarks; // Landmark cells
+  std::vector<std::uint32_t> owned; // Distances, when built in memory
+
+  // Distances of a loaded table, read in place from the mapping
+  std::shared_ptr<const MappedFile> mapping;
+  const std::uint32_t *distances; // owned.data() or into the mapping
+};
+
+#endif // LANDMARK_TABLE_H
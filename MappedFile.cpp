@@ -0,0 +1,73 @@
+#include "MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_HAVE_MMAP 1
+#else
+#include <fstream>
+#endif
+
+MappedFile::MappedFile() : bytes(nullptr), length(0), mapped(false) {}
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::open(const std::string &filename) {
+  close();
+
+#ifdef MAPPED_FILE_HAVE_MMAP
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat info {};
+  if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+
+  void *address = mmap(nullptr, static_cast<std::size_t>(info.st_size),
+                       PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  ::close(fd);
+  if (address == MAP_FAILED)
+    return false;
+
+  bytes = static_cast<const std::uint8_t *>(address);
+  length = static_cast<std::size_t>(info.st_size);
+  mapped = true;
+  return true;
+#else
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file.is_open())
+    return false;
+
+  const std::streamoff size = file.tellg();
+  if (size <= 0)
+    return false;
+
+  buffer.resize((static_cast<std::size_t>(size) + 7) / 8);
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char *>(buffer.data()), size)) {
+    std::vector<std::uint64_t>().swap(buffer);
+    return false;
+  }
+
+  bytes = reinterpret_cast<const std::uint8_t *>(buffer.data());
+  length = static_cast<std::size_t>(size);
+  return true;
+#endif
+}
+
+void MappedFile::close() {
+#ifdef MAPPED_FILE_HAVE_MMAP
+  if (mapped)
+    munmap(const_cast<std::uint8_t *>(bytes), length);
+#endif
+  std::vector<std::uint64_t>().swap(buffer);
+  bytes = nullptr;
+  length = 0;
+  mapped = false;
+}
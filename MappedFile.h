@@ -0,0 +1,62 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Read-only view of a whole file.
+ *
+ * On POSIX systems the file is mapped with mmap, so opening it costs no
+ * reading or copying: pages are faulted in from the page cache as they are
+ * first touched, and unused parts of the file are never read. Elsewhere the
+ * file is read into a heap buffer, which behaves the same but is not
+ * zero-copy.
+ *
+ * The view stays valid until close() or destruction; it is not copyable.
+ */
+class MappedFile {
+public:
+  MappedFile();
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /**
+   * @brief Map a file, replacing any file mapped before.
+   * @param filename Path to the file.
+   * @return true if the file was opened and mapped, false otherwise.
+   */
+  bool open(const std::string &filename);
+
+  /**
+   * @brief Unmap the file (no-op if none is mapped).
+   */
+  void close();
+
+  /**
+   * @brief Check whether a file is mapped.
+   */
+  bool isOpen() const { return bytes != nullptr; }
+
+  /**
+   * @brief Get the first byte of the file (page aligned when mapped).
+   */
+  const std::uint8_t *data() const { return bytes; }
+
+  /**
+   * @brief Get the size of the file in bytes.
+   */
+  std::size_t size() const { return length; }
+
+private:
+  const std::uint8_t *bytes;
+  std::size_t length;
+  bool mapped;                      // Whether bytes must be munmap()ed
+  std::vector<std::uint64_t> buffer; // Fallback storage (8-byte aligned)
+};
+
+#endif // MAPPED_FILE_H
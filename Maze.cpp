@@ -1,13 +1,333 @@
 #include "Maze.h"
 
+#include "MappedFile.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
 #include <fstream>
-#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Header of a binary maze file (see Maze::loadFromBinaryFile). Fields are
+// little-endian and the layout has no padding, so it is read in place.
+struct BinaryHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t headerSize;
+  std::uint32_t width;
+  std::uint32_t height;
+  std::uint64_t wordsPerRow;
+  std::uint64_t start; // Cell index, or Maze::NO_CELL
+  std::uint64_t goal;  // Cell index, or Maze::NO_CELL
+  std::uint64_t checksum;
+  std::uint8_t minCost; // Lowest cell cost (version 2), otherwise 0
+  std::uint8_t maxCost; // Highest cell cost (version 2), otherwise 0
+  std::uint8_t reserved[6];
+};
+static_assert(sizeof(BinaryHeader) == 64, "header must be 64 bytes");
+
+constexpr char BINARY_MAGIC[8] = {'M', 'A', 'Z', 'E', 'B', 'I', 'N', '\0'};
+constexpr std::uint32_t BINARY_VERSION = 1;
+constexpr std::uint32_t BINARY_VERSION_COSTS = 2; // Cost plane follows walls
+
+// 64-bit FNV-1a, one word at a time
+std::uint64_t wallChecksum(const std::uint64_t *words, std::size_t count) {
+  std::uint64_t hash = 14695981039346656037ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    hash ^= words[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// The wall bitmap is written and mapped as raw host words
+bool isLittleEndian() {
+  const std::uint16_t probe = 1;
+  unsigned char low;
+  std::memcpy(&low, &probe, 1);
+  return low == 1;
+}
+
+// A range of whole lines of a text maze, parsed by one worker
+struct TextChunk {
+  const char *begin = nullptr;
+  const char *end = nullptr;
+  std::size_t lineCount = 0;       // Lines in [begin, end)
+  std::size_t firstRow = 0;        // Grid row of the first line
+  CellIndex start = Maze::NO_CELL; // Last 'S' in the chunk
+  CellIndex goal = Maze::NO_CELL;  // Last 'G' in the chunk
+  std::size_t errorLine = 0;       // File line of the first error
+  std::string error;               // Empty if the chunk is well formed
+};
+
+// Meaning of each character of a text maze row
+enum TextCell : std::uint8_t {
+  TEXT_OPEN,
+  TEXT_WALL,
+  TEXT_START,
+  TEXT_GOAL,
+  TEXT_INVALID
+};
+
+struct TextCellTable {
+  TextCell cells[256];
+
+  TextCellTable() {
+    std::fill(std::begin(cells), std::end(cells), TEXT_INVALID);
+    cells[static_cast<unsigned char>('.')] = TEXT_OPEN;
+    cells[static_cast<unsigned char>(' ')] = TEXT_OPEN;
+    cells[static_cast<unsigned char>('#')] = TEXT_WALL;
+    cells[static_cast<unsigned char>('1')] = TEXT_WALL;
+    cells[static_cast<unsigned char>('S')] = TEXT_START;
+    cells[static_cast<unsigned char>('G')] = TEXT_GOAL;
+  }
+};
+
+const TextCellTable TEXT_CELLS;
+
+// Wall bits of up to 64 cells of a text row. Sets special if any character
+// is not a plain wall or open cell ('S', 'G' or invalid).
+std::uint64_t parseWallBits(const char *cells, std::size_t count,
+                            bool &special) {
+  std::uint64_t word = 0;
+  for (std::size_t bit = 0; bit < count; ++bit) {
+    const TextCell cell =
+        TEXT_CELLS.cells[static_cast<unsigned char>(cells[bit])];
+    word |= static_cast<std::uint64_t>(cell == TEXT_WALL) << bit;
+    special |= cell > TEXT_WALL;
+  }
+  return word;
+}
+
+// parseWallBits() for exactly 64 cells, 16 at a time where SSE2 is available
+std::uint64_t parseWallWord(const char *cells, bool &special) {
+#ifdef __SSE2__
+  const __m128i hash = _mm_set1_epi8('#');
+  const __m128i one = _mm_set1_epi8('1');
+  const __m128i dot = _mm_set1_epi8('.');
+  const __m128i space = _mm_set1_epi8(' ');
+
+  std::uint64_t word = 0;
+  bool plain = true;
+  for (int i = 0; i < 4; ++i) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(cells + 16 * i));
+    const __m128i wall =
+        _mm_or_si128(_mm_cmpeq_epi8(v, hash), _mm_cmpeq_epi8(v, one));
+    const __m128i open =
+        _mm_or_si128(_mm_cmpeq_epi8(v, dot), _mm_cmpeq_epi8(v, space));
+    word |= static_cast<std::uint64_t>(_mm_movemask_epi8(wall)) << (16 * i);
+    plain &= _mm_movemask_epi8(_mm_or_si128(wall, open)) == 0xFFFF;
+  }
+  special |= !plain;
+  return word;
+#else
+  return parseWallBits(cells, 64, special);
+#endif
+}
+
+// Parse the rows of a chunk into a cleared wall plane. Lines past the last
+// grid row are ignored; a short line leaves the rest of its row open.
+void parseTextRows(TextChunk &chunk, int width, int height,
+                   std::size_t wordsPerRow, std::uint64_t *plane) {
+  const char *line = chunk.begin;
+  std::size_t row = chunk.firstRow;
+  while (line < chunk.end && row < static_cast<std::size_t>(height)) {
+    const void *newline =
+        std::memchr(line, '\n', static_cast<std::size_t>(chunk.end - line));
+    const char *eol = newline ? static_cast<const char *>(newline) : chunk.end;
+    const char *last = (eol > line && eol[-1] == '\r') ? eol - 1 : eol;
+    const std::size_t length = static_cast<std::size_t>(last - line);
+    const std::size_t fileLine = row + 2; // After the dimensions line
+
+    if (length > static_cast<std::size_t>(width)) {
+      chunk.errorLine = fileLine;
+      chunk.error = "row has " + std::to_string(length) + " cells, expected " +
+                    std::to_string(width);
+      return;
+    }
+
+    std::uint64_t *rowWords = plane + row * wordsPerRow;
+    const CellIndex rowIndex =
+        static_cast<CellIndex>(row) * static_cast<CellIndex>(width);
+    for (std::size_t x = 0; x < length; x += 64) {
+      const std::size_t count = std::min<std::size_t>(64, length - x);
+      bool special = false;
+      rowWords[x / 64] = count == 64 ? parseWallWord(line + x, special)
+                                     : parseWallBits(line + x, count, special);
+
+      if (!special)
+        continue;
+      for (std::size_t bit = 0; bit < count; ++bit) {
+        const char c = line[x + bit];
+        switch (TEXT_CELLS.cells[static_cast<unsigned char>(c)]) {
+        case TEXT_START:
+          chunk.start = rowIndex + x + bit;
+          break;
+        case TEXT_GOAL:
+          chunk.goal = rowIndex + x + bit;
+          break;
+        case TEXT_INVALID:
+          chunk.errorLine = fileLine;
+          chunk.error = std::string("unexpected character '") + c +
+                        "' in column " + std::to_string(x + bit + 1);
+          return;
+        default:
+          break;
+        }
+      }
+    }
+
+    line = eol + 1;
+    ++row;
+  }
+}
+
+// Parse the optional cost section of a text maze, starting at the line after
+// the grid. Without a "costs" line there, plane is left empty. Otherwise it
+// receives the costs, or errorLine and error are set for a malformed row.
+void parseTextCosts(const char *pos, const char *end, std::size_t fileLine,
+                    int width, int height, std::vector<std::uint8_t> &plane,
+                    std::size_t &errorLine, std::string &error) {
+  // Take the line at pos, without its line break, and move past it
+  const char *lineEnd = pos;
+  auto takeLine = [&]() {
+    const char *line = pos;
+    const void *newline =
+        std::memchr(pos, '\n', static_cast<std::size_t>(end - pos));
+    const char *eol = newline ? static_cast<const char *>(newline) : end;
+    pos = newline ? eol + 1 : end;
+    lineEnd = (eol > line && eol[-1] == '\r') ? eol - 1 : eol;
+    return line;
+  };
+
+  const char *line = takeLine();
+  if (std::string(line, lineEnd) != "costs")
+    return;
+
+  std::vector<std::uint8_t> costs(static_cast<std::size_t>(width) *
+                                  static_cast<std::size_t>(height));
+  for (std::size_t row = 0; row < static_cast<std::size_t>(height); ++row) {
+    ++fileLine;
+    line = takeLine();
+    std::uint8_t *rowCosts = costs.data() + row * static_cast<std::size_t>(width);
+    std::size_t x = 0;
+    for (const char *c = line;;) {
+      while (c < lineEnd && (*c == ' ' || *c == '\t'))
+        ++c;
+      if (c == lineEnd)
+        break;
+
+      const char *digits = c;
+      unsigned value = 0;
+      while (c < lineEnd && std::isdigit(static_cast<unsigned char>(*c)) &&
+             value <= 255)
+        value = value * 10 + static_cast<unsigned>(*c++ - '0');
+      const bool separated = c == lineEnd || *c == ' ' || *c == '\t';
+      if (c == digits || !separated || value == 0 || value > 255) {
+        errorLine = fileLine;
+        error = "expected a cost of 1-255 for column " + std::to_string(x + 1);
+        return;
+      }
+      if (x == static_cast<std::size_t>(width)) {
+        errorLine = fileLine;
+        error = "row has more than " + std::to_string(width) + " costs";
+        return;
+      }
+      rowCosts[x++] = static_cast<std::uint8_t>(value);
+    }
+    if (x != static_cast<std::size_t>(width)) {
+      errorLine = fileLine;
+      error = "row has " + std::to_string(x) + " costs, expected " +
+              std::to_string(width);
+      return;
+    }
+  }
+  plane.swap(costs);
+}
+
+// Reads the header tokens of a PBM/PGM image: unsigned decimal numbers
+// separated by whitespace, with '#' comments running to the end of a line
+class ImageHeaderReader {
+public:
+  ImageHeaderReader(const std::uint8_t *begin, const std::uint8_t *end)
+      : pos(begin), end(end) {}
+
+  bool readNumber(std::uint64_t &value) {
+    while (pos < end && (std::isspace(*pos) || *pos == '#')) {
+      if (*pos == '#') {
+        while (pos < end && *pos != '\n')
+          ++pos;
+      } else {
+        ++pos;
+      }
+    }
+    if (pos == end || !std::isdigit(*pos))
+      return false;
+    value = 0;
+    while (pos < end && std::isdigit(*pos) && value <= 0xFFFFFFFFull) {
+      value = value * 10 + static_cast<std::uint64_t>(*pos - '0');
+      ++pos;
+    }
+    return true;
+  }
+
+  // Position after the single whitespace character that ends the header
+  const std::uint8_t *raster() const {
+    return pos < end && std::isspace(*pos) ? pos + 1 : nullptr;
+  }
+
+private:
+  const std::uint8_t *pos;
+  const std::uint8_t *end;
+};
+
+// Reverse the bit order within each byte of a word. PBM rows are packed
+// most significant bit first, the wall bitmap least significant bit first.
+std::uint64_t reverseBitsInBytes(std::uint64_t v) {
+  v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+  v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+  v = ((v >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((v & 0x0F0F0F0F0F0F0F0Full) << 4);
+  return v;
+}
+
+// Load up to 8 bytes as a little-endian word
+std::uint64_t loadLittleEndian(const std::uint8_t *bytes, std::size_t count) {
+  std::uint64_t word = 0;
+  for (std::size_t i = 0; i < count; ++i)
+    word |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+  return word;
+}
+
+// Run task(0) .. task(count - 1) on separate threads, the first on the
+// calling thread, and wait for all of them
+template <typename Task> void runParallel(std::size_t count, Task task) {
+  std::vector<std::thread> workers;
+  workers.reserve(count - 1);
+  for (std::size_t i = 1; i < count; ++i)
+    workers.emplace_back(task, i);
+  task(0);
+  for (std::thread &worker : workers)
+    worker.join();
+}
+
+} // namespace
 
 Maze::Maze(int width, int height)
-    : width(width), height(height), start(nullptr), goal(nullptr) {
+    : width(width), height(height), wordsPerRow(0), minCost(1), maxCost(1),
+      start(NO_CELL), goal(NO_CELL), mappedWalls(nullptr),
+      mappedCosts(nullptr) {
   if (width > 0 && height > 0) {
     validateDimensions(width, height);
     initializeGrid();
@@ -15,68 +335,559 @@ Maze::Maze(int width, int height)
 }
 
 void Maze::initializeGrid() {
-  grid.clear();
-  grid.resize(height);
+  wordsPerRow = (static_cast<std::size_t>(width) + 63) / 64;
+
+  walls.assign(wordsPerRow * static_cast<std::size_t>(height), 0);
+  wallStamp.restart();
+  mapping.reset();
+  mappedWalls = nullptr;
+  std::vector<std::uint8_t>().swap(state);
+  adoptCosts({});
+  start = NO_CELL;
+  goal = NO_CELL;
+}
+
+std::shared_ptr<Cell> Maze::makeHandle(int x, int y) const {
+  return std::make_shared<Cell>(x, y, this);
+}
+
+std::shared_ptr<Cell> Maze::makeHandle(int x, int y) {
+  return std::make_shared<Cell>(x, y, this);
+}
+
+bool Maze::loadFromFile(const std::string &filename, unsigned threads) {
+  MappedFile file;
+  if (!file.open(filename)) {
+    std::cerr << "Error: Could not open file " << filename << std::endl;
+    return false;
+  }
+
+  const char *data = reinterpret_cast<const char *>(file.data());
+  const char *end = data + file.size();
+
+  // Read dimensions from the first line
+  const char *body = static_cast<const char *>(
+      std::memchr(data, '\n', file.size()));
+  body = body ? body + 1 : end;
+  int w = 0;
+  int h = 0;
+  std::istringstream(std::string(data, body)) >> w >> h;
+
+  if (w <= 0 || h <= 0) {
+    std::cerr << "Error: Invalid maze dimensions" << std::endl;
+    return false;
+  }
+
+  validateDimensions(w, h);
+
+  const std::size_t rowWords = (static_cast<std::size_t>(w) + 63) / 64;
+  std::vector<std::uint64_t> plane(rowWords * static_cast<std::size_t>(h), 0);
+
+  // Split the grid into chunks of whole lines, at least 1 MiB each
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  const std::size_t bodySize = static_cast<std::size_t>(end - body);
+  const std::size_t chunkCount = std::max<std::size_t>(
+      1, std::min<std::size_t>(threads, bodySize / (1 << 20)));
+
+  std::vector<TextChunk> chunks(chunkCount);
+  const char *chunkBegin = body;
+  for (std::size_t i = 0; i < chunkCount; ++i) {
+    const char *chunkEnd = end;
+    if (i + 1 < chunkCount) {
+      // Extend the chunk to the end of the line its nominal end falls in
+      const char *nominal = body + bodySize * (i + 1) / chunkCount;
+      const void *newline =
+          nominal > chunkBegin
+              ? std::memchr(nominal - 1, '\n',
+                            static_cast<std::size_t>(end - nominal) + 1)
+              : nullptr;
+      chunkEnd = nominal <= chunkBegin ? chunkBegin
+                 : newline             ? static_cast<const char *>(newline) + 1
+                                       : end;
+    }
+    chunks[i].begin = chunkBegin;
+    chunks[i].end = chunkEnd;
+    chunkBegin = chunkEnd;
+  }
+
+  // Number the rows: count the lines of every chunk, then take prefix sums
+  runParallel(chunkCount, [&](std::size_t i) {
+    TextChunk &chunk = chunks[i];
+    chunk.lineCount =
+        static_cast<std::size_t>(std::count(chunk.begin, chunk.end, '\n'));
+    if (chunk.end > chunk.begin && chunk.end[-1] != '\n')
+      ++chunk.lineCount; // Last line without a newline
+  });
+  std::size_t lineCount = 0;
+  for (TextChunk &chunk : chunks) {
+    chunk.firstRow = lineCount;
+    lineCount += chunk.lineCount;
+  }
+
+  // Chunks cover disjoint rows, and rows disjoint words of the plane
+  runParallel(chunkCount, [&](std::size_t i) {
+    parseTextRows(chunks[i], w, h, rowWords, plane.data());
+  });
+
+  // Report the first error in the file; a later 'S' or 'G' overrides an
+  // earlier one
+  CellIndex newStart = NO_CELL;
+  CellIndex newGoal = NO_CELL;
+  for (const TextChunk &chunk : chunks) {
+    if (!chunk.error.empty()) {
+      std::cerr << "Error: " << filename << ":" << chunk.errorLine << ": "
+                << chunk.error << std::endl;
+      return false;
+    }
+    if (chunk.start != NO_CELL)
+      newStart = chunk.start;
+    if (chunk.goal != NO_CELL)
+      newGoal = chunk.goal;
+  }
+
+  if (lineCount < static_cast<std::size_t>(h)) {
+    std::cerr << "Error: Unexpected end of file (" << lineCount << " of " << h
+              << " rows)" << std::endl;
+    return false;
+  }
+
+  // The cost section starts on the line after the grid; find it from the
+  // chunk holding that line
+  std::vector<std::uint8_t> costPlane;
+  for (const TextChunk &chunk : chunks) {
+    const std::size_t row = static_cast<std::size_t>(h);
+    if (row < chunk.firstRow || row >= chunk.firstRow + chunk.lineCount)
+      continue;
+    const char *line = chunk.begin;
+    for (std::size_t skip = row - chunk.firstRow; skip > 0; --skip)
+      line = static_cast<const char *>(std::memchr(
+                 line, '\n', static_cast<std::size_t>(end - line))) +
+             1;
+
+    std::size_t errorLine = 0;
+    std::string error;
+    parseTextCosts(line, end, row + 2, w, h, costPlane, errorLine, error);
+    if (!error.empty()) {
+      std::cerr << "Error: " << filename << ":" << errorLine << ": " << error
+                << std::endl;
+      return false;
+    }
+    break;
+  }
+
+  width = w;
+  height = h;
+  wordsPerRow = rowWords;
+  walls.swap(plane);
+  wallStamp.restart();
+  mapping.reset();
+  mappedWalls = nullptr;
+  std::vector<std::uint8_t>().swap(state);
+  adoptCosts(std::move(costPlane));
+  start = newStart;
+  goal = newGoal;
+
+  if (start == NO_CELL || goal == NO_CELL) {
+    std::cerr << "Warning: Start or goal position not found in maze file"
+              << std::endl;
+  }
+
+  return true;
+}
+
+bool Maze::saveToFile(const std::string &filename) const {
+  std::ofstream file(filename);
+  if (!file.is_open()) {
+    std::cerr << "Error: Could not create file " << filename << std::endl;
+    return false;
+  }
+
+  file << width << " " << height << "\n";
+  std::string line(static_cast<std::size_t>(width), ' ');
   for (int y = 0; y < height; ++y) {
-    grid[y].resize(width);
     for (int x = 0; x < width; ++x) {
-      grid[y][x] = std::make_shared<Cell>(x, y);
+      const CellIndex index = indexOf(x, y);
+      if (index == start) {
+        line[x] = 'S';
+      } else if (index == goal) {
+        line[x] = 'G';
+      } else {
+        line[x] = isWall(x, y) ? '#' : '.';
+      }
     }
+    file << line << "\n";
   }
+
+  if (hasCosts()) {
+    file << "costs\n";
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x)
+        file << (x ? " " : "") << static_cast<unsigned>(getCost(x, y));
+      file << "\n";
+    }
+  }
+  return static_cast<bool>(file);
 }
 
-bool Maze::loadFromFile(const std::string &filename) {
-  std::ifstream file(filename);
-  if (!file.is_open()) {
+bool Maze::loadFromBinaryFile(const std::string &filename,
+                              bool verifyChecksum) {
+  if (!isLittleEndian()) {
+    std::cerr << "Error: Binary maze files need a little-endian host"
+              << std::endl;
+    return false;
+  }
+
+  auto file = std::make_shared<MappedFile>();
+  if (!file->open(filename)) {
     std::cerr << "Error: Could not open file " << filename << std::endl;
     return false;
   }
 
-  // Read dimensions
-  file >> width >> height;
-  file.ignore(); // Ignore newline after dimensions
+  BinaryHeader header;
+  if (file->size() < sizeof(header)) {
+    std::cerr << "Error: " << filename << " is not a binary maze file"
+              << std::endl;
+    return false;
+  }
+  std::memcpy(&header, file->data(), sizeof(header));
+
+  if (std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+    std::cerr << "Error: " << filename << " is not a binary maze file"
+              << std::endl;
+    return false;
+  }
+  if ((header.version != BINARY_VERSION &&
+       header.version != BINARY_VERSION_COSTS) ||
+      header.headerSize != sizeof(header)) {
+    std::cerr << "Error: Unsupported binary maze version " << header.version
+              << std::endl;
+    return false;
+  }
+
+  const std::uint32_t maxSize = std::numeric_limits<int>::max();
+  if (header.width == 0 || header.height == 0 || header.width > maxSize ||
+      header.height > maxSize) {
+    std::cerr << "Error: Invalid maze dimensions" << std::endl;
+    return false;
+  }
+  const int w = static_cast<int>(header.width);
+  const int h = static_cast<int>(header.height);
+  validateDimensions(w, h);
+
+  const std::uint64_t cellCount =
+      static_cast<std::uint64_t>(w) * static_cast<std::uint64_t>(h);
+  const std::size_t rowWords = (static_cast<std::size_t>(w) + 63) / 64;
+  const std::size_t wordCount = rowWords * static_cast<std::size_t>(h);
+  if (header.wordsPerRow != rowWords ||
+      file->size() - sizeof(header) < wordCount * sizeof(std::uint64_t)) {
+    std::cerr << "Error: Truncated or malformed wall plane in " << filename
+              << std::endl;
+    return false;
+  }
+  if ((header.start != NO_CELL && header.start >= cellCount) ||
+      (header.goal != NO_CELL && header.goal >= cellCount)) {
+    std::cerr << "Error: Start or goal outside the maze" << std::endl;
+    return false;
+  }
+
+  const bool withCosts = header.version == BINARY_VERSION_COSTS;
+  const std::size_t wallBytes = wordCount * sizeof(std::uint64_t);
+  if (withCosts &&
+      (header.minCost == 0 || header.minCost > header.maxCost ||
+       file->size() - sizeof(header) - wallBytes < cellCount)) {
+    std::cerr << "Error: Truncated or malformed cost plane in " << filename
+              << std::endl;
+    return false;
+  }
+
+  // The header is 64 bytes and the mapping is page aligned, so the plane is
+  // suitably aligned to be read as words
+  const auto *plane =
+      reinterpret_cast<const std::uint64_t *>(file->data() + sizeof(header));
+  if (verifyChecksum && wallChecksum(plane, wordCount) != header.checksum) {
+    std::cerr << "Error: Checksum mismatch in " << filename << std::endl;
+    return false;
+  }
+
+  const std::uint8_t *costPlane =
+      withCosts ? file->data() + sizeof(header) + wallBytes : nullptr;
+  if (verifyChecksum && withCosts) {
+    const auto range = std::minmax_element(costPlane, costPlane + cellCount);
+    if (*range.first != header.minCost || *range.second != header.maxCost) {
+      std::cerr << "Error: Cost range mismatch in " << filename << std::endl;
+      return false;
+    }
+  }
 
+  width = w;
+  height = h;
+  wordsPerRow = rowWords;
+  std::vector<std::uint64_t>().swap(walls);
+  std::vector<std::uint8_t>().swap(state);
+  adoptCosts({});
+  mapping = std::move(file);
+  mappedWalls = plane;
+  wallStamp.restart();
+  if (withCosts) {
+    mappedCosts = costPlane;
+    minCost = header.minCost;
+    maxCost = header.maxCost;
+  }
+  start = header.start;
+  goal = header.goal;
+
+  if (start == NO_CELL || goal == NO_CELL) {
+    std::cerr << "Warning: Start or goal position not found in maze file"
+              << std::endl;
+  }
+
+  return true;
+}
+
+bool Maze::saveToBinaryFile(const std::string &filename) const {
+  if (!isLittleEndian()) {
+    std::cerr << "Error: Binary maze files need a little-endian host"
+              << std::endl;
+    return false;
+  }
   if (width <= 0 || height <= 0) {
     std::cerr << "Error: Invalid maze dimensions" << std::endl;
     return false;
   }
 
-  validateDimensions(width, height);
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << "Error: Could not create file " << filename << std::endl;
+    return false;
+  }
 
-  initializeGrid();
+  const std::size_t wordCount = wordsPerRow * static_cast<std::size_t>(height);
+
+  BinaryHeader header{};
+  std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+  header.version = hasCosts() ? BINARY_VERSION_COSTS : BINARY_VERSION;
+  header.headerSize = sizeof(header);
+  header.width = static_cast<std::uint32_t>(width);
+  header.height = static_cast<std::uint32_t>(height);
+  header.wordsPerRow = wordsPerRow;
+  header.start = start;
+  header.goal = goal;
+  header.checksum = wallChecksum(wallWords(), wordCount);
+  if (hasCosts()) {
+    header.minCost = minCost;
+    header.maxCost = maxCost;
+  }
 
-  // Read maze grid
-  for (int y = 0; y < height; ++y) {
-    std::string line;
-    if (!std::getline(file, line)) {
-      std::cerr << "Error: Unexpected end of file" << std::endl;
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(wallWords()),
+             static_cast<std::streamsize>(wordCount * sizeof(std::uint64_t)));
+  if (hasCosts())
+    file.write(reinterpret_cast<const char *>(getCostPlane()),
+               static_cast<std::streamsize>(getCellCount()));
+  return static_cast<bool>(file);
+}
+
+bool Maze::loadFromImageFile(const std::string &filename, int threshold) {
+  MappedFile file;
+  if (!file.open(filename)) {
+    std::cerr << "Error: Could not open file " << filename << std::endl;
+    return false;
+  }
+
+  const std::uint8_t *data = file.data();
+  const std::uint8_t *end = data + file.size();
+  const char format = file.size() >= 2 && data[0] == 'P' ? data[1] : 0;
+  if (format != '1' && format != '2' && format != '4' && format != '5') {
+    std::cerr << "Error: " << filename
+              << " is not a PBM (P1/P4) or PGM (P2/P5) image" << std::endl;
+    return false;
+  }
+  const bool bitmap = format == '1' || format == '4';
+  const bool ascii = format == '1' || format == '2';
+
+  ImageHeaderReader header(data + 2, end);
+  std::uint64_t imageWidth = 0;
+  std::uint64_t imageHeight = 0;
+  std::uint64_t maxValue = 1;
+  if (!header.readNumber(imageWidth) || !header.readNumber(imageHeight) ||
+      (!bitmap && !header.readNumber(maxValue))) {
+    std::cerr << "Error: Malformed image header in " << filename << std::endl;
+    return false;
+  }
+
+  const std::uint64_t maxSize = std::numeric_limits<int>::max();
+  if (imageWidth == 0 || imageHeight == 0 || imageWidth > maxSize ||
+      imageHeight > maxSize || maxValue == 0 || maxValue > 65535) {
+    std::cerr << "Error: Invalid image dimensions or maximum gray value"
+              << std::endl;
+    return false;
+  }
+  const int w = static_cast<int>(imageWidth);
+  const int h = static_cast<int>(imageHeight);
+  validateDimensions(w, h);
+
+  // PGM pixels darker than the threshold are walls; in a PBM 1 is black
+  const std::uint64_t wallBelow =
+      bitmap ? 1
+             : (threshold >= 0 ? static_cast<std::uint64_t>(threshold)
+                               : (maxValue + 1) / 2);
+
+  const std::size_t rowWords = (static_cast<std::size_t>(w) + 63) / 64;
+  std::vector<std::uint64_t> plane(rowWords * static_cast<std::size_t>(h), 0);
+  const std::uint8_t *raster = header.raster();
+  if (!raster) {
+    std::cerr << "Error: Malformed image header in " << filename << std::endl;
+    return false;
+  }
+
+  if (format == '4') {
+    // Rows are already bit-packed; copy them a word at a time
+    const std::size_t rowBytes = (static_cast<std::size_t>(w) + 7) / 8;
+    if (static_cast<std::size_t>(end - raster) / rowBytes <
+        static_cast<std::size_t>(h)) {
+      std::cerr << "Error: Truncated image data in " << filename << std::endl;
+      return false;
+    }
+    const int tailBits = w % 64;
+    const std::uint64_t tailMask =
+        tailBits ? (std::uint64_t{1} << tailBits) - 1 : ~std::uint64_t{0};
+    for (std::size_t y = 0; y < static_cast<std::size_t>(h); ++y) {
+      const std::uint8_t *source = raster + y * rowBytes;
+      std::uint64_t *row = plane.data() + y * rowWords;
+      for (std::size_t i = 0; i < rowWords; ++i) {
+        const std::size_t bytes = std::min<std::size_t>(8, rowBytes - 8 * i);
+        row[i] = reverseBitsInBytes(loadLittleEndian(source + 8 * i, bytes));
+      }
+      row[rowWords - 1] &= tailMask; // Clear the row's padding bits
+    }
+  } else {
+    // One value per pixel: ASCII digits (P1), ASCII numbers (P2), or one or
+    // two big-endian bytes (P5)
+    const std::size_t pixelBytes = maxValue < 256 ? 1 : 2;
+    const std::uint64_t cellCount =
+        static_cast<std::uint64_t>(w) * static_cast<std::uint64_t>(h);
+    if (!ascii && static_cast<std::uint64_t>(end - raster) / pixelBytes <
+                      cellCount) {
+      std::cerr << "Error: Truncated image data in " << filename << std::endl;
       return false;
     }
 
-    for (int x = 0; x < width && x < static_cast<int>(line.length()); ++x) {
-      char c = line[x];
+    ImageHeaderReader numbers(raster - 1, end);
+    const std::uint8_t *pixel = raster;
+    for (int y = 0; y < h; ++y) {
+      std::uint64_t *row =
+          plane.data() + static_cast<std::size_t>(y) * rowWords;
+      for (int x = 0; x < w; ++x) {
+        std::uint64_t value = 0;
+        bool ok = true;
+        if (format == '1') {
+          // Digits need not be separated
+          while (pixel < end && std::isspace(*pixel))
+            ++pixel;
+          ok = pixel < end && (*pixel == '0' || *pixel == '1');
+          value = ok ? static_cast<std::uint64_t>(*pixel++ - '0') : 0;
+        } else if (format == '2') {
+          ok = numbers.readNumber(value);
+        } else {
+          value = pixelBytes == 1 ? pixel[0] : (pixel[0] << 8 | pixel[1]);
+          pixel += pixelBytes;
+        }
+        if (!ok) {
+          std::cerr << "Error: Bad or missing pixel (" << x << ", " << y
+                    << ") in " << filename << std::endl;
+          return false;
+        }
 
-      if (c == '#' || c == '1') {
-        grid[y][x]->setWall(true);
-      } else if (c == 'S') {
-        start = grid[y][x];
-      } else if (c == 'G') {
-        goal = grid[y][x];
+        const bool wall = bitmap ? value == 1 : value < wallBelow;
+        row[x / 64] |= static_cast<std::uint64_t>(wall) << (x % 64);
       }
-      // '.' or ' ' are open cells (default)
     }
   }
 
-  file.close();
-
-  if (!start || !goal) {
-    std::cerr << "Warning: Start or goal position not found in maze file"
-              << std::endl;
+  width = w;
+  height = h;
+  wordsPerRow = rowWords;
+  walls.swap(plane);
+  wallStamp.restart();
+  mapping.reset();
+  mappedWalls = nullptr;
+  std::vector<std::uint8_t>().swap(state);
+  adoptCosts({});
+  start = NO_CELL;
+  goal = NO_CELL;
+
+  // Images carry no start or goal; take them from the sidecar if there is one
+  std::ifstream sidecar(filename + ".sg");
+  std::string key;
+  int x = 0;
+  int y = 0;
+  while (sidecar >> key >> x >> y) {
+    if ((key != "start" && key != "goal") || !isValid(x, y)) {
+      std::cerr << "Warning: Ignoring '" << key << " " << x << " " << y
+                << "' in " << filename << ".sg" << std::endl;
+    } else if (key == "start") {
+      start = indexOf(x, y);
+    } else {
+      goal = indexOf(x, y);
+    }
   }
 
   return true;
 }
 
+bool Maze::isMapped() const { return mappedWalls != nullptr; }
+
+std::uint64_t Maze::getWallChecksum() const {
+  return wallChecksum(wallWords(),
+                      wordsPerRow * static_cast<std::size_t>(height));
+}
+
+void Maze::WallStamp::restart() {
+  static std::atomic<std::uint64_t> nextOrigin{1};
+  version = {nextOrigin.fetch_add(1, std::memory_order_relaxed), 0};
+}
+
+void Maze::detachWalls() {
+  walls.assign(mappedWalls,
+               mappedWalls + wordsPerRow * static_cast<std::size_t>(height));
+  mappedWalls = nullptr;
+  if (!mappedCosts)
+    mapping.reset();
+}
+
+void Maze::detachCosts() {
+  adoptCosts(std::vector<std::uint8_t>(
+      mappedCosts, mappedCosts + static_cast<std::size_t>(getCellCount())));
+  if (!mappedWalls)
+    mapping.reset();
+}
+
+void Maze::adoptCosts(std::vector<std::uint8_t> plane) {
+  costs.swap(plane);
+  costStamp.edit();
+  mappedCosts = nullptr;
+  minCost = 1;
+  maxCost = 1;
+  if (costs.empty()) {
+    std::vector<CellIndex>().swap(costCounts);
+    return;
+  }
+
+  costCounts.assign(256, 0);
+  for (std::uint8_t cost : costs)
+    ++costCounts[cost];
+  minCost = static_cast<std::uint8_t>(
+      std::find_if(costCounts.begin() + 1, costCounts.end(),
+                   [](CellIndex count) { return count > 0; }) -
+      costCounts.begin());
+  maxCost = static_cast<std::uint8_t>(
+      costCounts.rend() -
+      std::find_if(costCounts.rbegin(), costCounts.rend() - 1,
+                   [](CellIndex count) { return count > 0; }) -
+      1);
+}
+
 void Maze::generate(int w, int h) {
   validateDimensions(w, h);
   width = w;
@@ -84,26 +895,19 @@ void Maze::generate(int w, int h) {
   initializeGrid();
 
   // Create border walls
-  for (int y = 0; y < height; ++y) {
-    grid[y][0]->setWall(true);
-    grid[y][width - 1]->setWall(true);
-  }
-  for (int x = 0; x < width; ++x) {
-    grid[0][x]->setWall(true);
-    grid[height - 1][x]->setWall(true);
-  }
+  addBorderWalls();
 
   // Add some internal walls for complexity
   for (int y = 2; y < height - 2; y += 2) {
     for (int x = 2; x < width - 2; x += 3) {
-      grid[y][x]->setWall(true);
+      setWall(x, y, true);
     }
   }
 
   // Set default start and goal
   if (width > 2 && height > 2) {
-    start = grid[1][1];
-    goal = grid[height - 2][width - 2];
+    start = indexOf(1, 1);
+    goal = indexOf(width - 2, height - 2);
   }
 }
 
@@ -111,66 +915,223 @@ std::shared_ptr<Cell> Maze::getCell(int x, int y) const {
   if (!isValid(x, y)) {
     throw std::out_of_range("Cell coordinates out of bounds");
   }
-  return grid[y][x];
+  return makeHandle(x, y);
+}
+
+std::shared_ptr<Cell> Maze::getCell(int x, int y) {
+  if (!isValid(x, y)) {
+    throw std::out_of_range("Cell coordinates out of bounds");
+  }
+  return makeHandle(x, y);
 }
 
+template <typename Self>
 std::vector<std::shared_ptr<Cell>>
-Maze::getNeighbors(std::shared_ptr<Cell> cell) const {
+Maze::neighborHandles(Self &self, const std::shared_ptr<Cell> &cell) {
   std::vector<std::shared_ptr<Cell>> neighbors;
-  if (!cell)
+  if (!cell || !self.isValid(cell->getX(), cell->getY()))
     return neighbors;
 
-  int x = cell->getX();
-  int y = cell->getY();
+  self.forEachNeighbor(self.indexOf(cell->getX(), cell->getY()),
+                       [&](CellIndex neighbor, Direction) {
+                         const Coordinate coords = self.coordsOf(neighbor);
+                         neighbors.push_back(
+                             self.makeHandle(coords.x, coords.y));
+                       });
 
-  // Check all four cardinal directions
-  const int dx[] = {0, 0, -1, 1}; // UP, DOWN, LEFT, RIGHT
-  const int dy[] = {-1, 1, 0, 0};
+  return neighbors;
+}
 
-  for (int i = 0; i < 4; ++i) {
-    int nx = x + dx[i];
-    int ny = y + dy[i];
+std::vector<std::shared_ptr<Cell>>
+Maze::getNeighbors(std::shared_ptr<Cell> cell) const {
+  return neighborHandles(*this, cell);
+}
 
-    if (isValid(nx, ny)) {
-      auto neighbor = grid[ny][nx];
-      if (!neighbor->isWall()) {
-        neighbors.push_back(neighbor);
-      }
-    }
+std::vector<std::shared_ptr<Cell>>
+Maze::getNeighbors(std::shared_ptr<Cell> cell) {
+  return neighborHandles(*this, cell);
+}
+
+std::uint8_t Maze::openDirections(int x, int y) const {
+  std::uint8_t open = 0;
+  if (y > 0 && !isWall(x, y - 1))
+    open |= directionBit(Direction::UP);
+  if (y + 1 < height && !isWall(x, y + 1))
+    open |= directionBit(Direction::DOWN);
+  if (x > 0 && !isWall(x - 1, y))
+    open |= directionBit(Direction::LEFT);
+  if (x + 1 < width && !isWall(x + 1, y))
+    open |= directionBit(Direction::RIGHT);
+  return open;
+}
+
+CellIndex Maze::neighborIndex(CellIndex index, Direction dir) const {
+  const CellIndex w = static_cast<CellIndex>(width);
+  switch (dir) {
+  case Direction::UP:
+    return index - w;
+  case Direction::DOWN:
+    return index + w;
+  case Direction::LEFT:
+    return index - 1;
+  case Direction::RIGHT:
+    return index + 1;
+  case Direction::UP_LEFT:
+    return index - w - 1;
+  case Direction::DOWN_RIGHT:
+    return index + w + 1;
+  case Direction::UP_RIGHT:
+    return index - w + 1;
+  case Direction::DOWN_LEFT:
+    break;
   }
+  return index + w - 1;
+}
 
-  return neighbors;
+CellIndex Maze::indexOf(int x, int y) const {
+  return static_cast<CellIndex>(y) * static_cast<CellIndex>(width) +
+         static_cast<CellIndex>(x);
 }
 
-bool Maze::isValid(int x, int y) const {
-  return x >= 0 && x < width && y >= 0 && y < height;
+Coordinate Maze::coordsOf(CellIndex index) const {
+  const CellIndex w = static_cast<CellIndex>(width);
+  return {static_cast<int>(index % w), static_cast<int>(index / w)};
 }
 
-void Maze::reset() {
-  for (int y = 0; y < height; ++y) {
-    for (int x = 0; x < width; ++x) {
-      grid[y][x]->reset();
-    }
+void Maze::setWall(int x, int y, bool wall) {
+  if (mappedWalls)
+    detachWalls();
+  std::uint64_t &word =
+      walls[static_cast<std::size_t>(y) * wordsPerRow + x / 64];
+  const std::uint64_t bit = std::uint64_t{1} << (x % 64);
+  word = wall ? (word | bit) : (word & ~bit);
+  wallStamp.edit();
+}
+
+std::uint8_t Maze::getCost(int x, int y) const {
+  const std::uint8_t *plane = getCostPlane();
+  return plane ? plane[indexOf(x, y)] : 1;
+}
+
+void Maze::setCost(int x, int y, std::uint8_t cost) {
+  if (cost == 0) {
+    throw std::invalid_argument("Cell costs must be between 1 and 255");
+  }
+  if (mappedCosts) {
+    detachCosts();
+  } else if (costs.empty()) {
+    if (cost == 1)
+      return; // Already the uniform cost
+    adoptCosts(std::vector<std::uint8_t>(
+        static_cast<std::size_t>(getCellCount()), 1));
   }
+
+  // Keep the cost counts, and from them the lowest and highest cost, current
+  std::uint8_t &cell = costs[indexOf(x, y)];
+  --costCounts[cell];
+  ++costCounts[cost];
+  cell = cost;
+  costStamp.edit();
+  if (cost < minCost)
+    minCost = cost;
+  while (costCounts[minCost] == 0)
+    ++minCost;
+  if (cost > maxCost)
+    maxCost = cost;
+  while (costCounts[maxCost] == 0)
+    --maxCost;
 }
 
+bool Maze::hasCosts() const { return getCostPlane() != nullptr; }
+
+void Maze::clearCosts() {
+  adoptCosts({});
+  if (!mappedWalls)
+    mapping.reset();
+}
+
+bool Maze::isVisited(int x, int y) const {
+  return !state.empty() && (state[indexOf(x, y)] & STATE_VISITED);
+}
+
+void Maze::setVisited(int x, int y, bool visited) {
+  setStateFlag(indexOf(x, y), STATE_VISITED, visited);
+}
+
+bool Maze::isPath(int x, int y) const {
+  return !state.empty() && (state[indexOf(x, y)] & STATE_PATH);
+}
+
+void Maze::setPath(int x, int y, bool path) {
+  setStateFlag(indexOf(x, y), STATE_PATH, path);
+}
+
+void Maze::setStateFlag(CellIndex index, std::uint8_t flag, bool value) {
+  if (value) {
+    allocateState();
+    state[index] |= flag;
+  } else if (!state.empty()) {
+    state[index] &= static_cast<std::uint8_t>(~flag);
+  }
+}
+
+void Maze::allocateState() {
+  if (state.empty()) {
+    state.assign(static_cast<std::size_t>(getCellCount()), 0);
+  }
+}
+
+bool Maze::isValid(int x, int y) const {
+  return x >= 0 && x < width && y >= 0 && y < height;
+}
+
+void Maze::reset() { std::vector<std::uint8_t>().swap(state); }
+
 int Maze::getWidth() const { return width; }
 
 int Maze::getHeight() const { return height; }
 
-std::shared_ptr<Cell> Maze::getStart() const { return start; }
+CellIndex Maze::getCellCount() const {
+  return static_cast<CellIndex>(width) * static_cast<CellIndex>(height);
+}
+
+std::shared_ptr<Cell> Maze::getStart() const {
+  if (start == NO_CELL)
+    return nullptr;
+  Coordinate c = coordsOf(start);
+  return makeHandle(c.x, c.y);
+}
+
+std::shared_ptr<Cell> Maze::getStart() {
+  if (start == NO_CELL)
+    return nullptr;
+  Coordinate c = coordsOf(start);
+  return makeHandle(c.x, c.y);
+}
 
-std::shared_ptr<Cell> Maze::getGoal() const { return goal; }
+std::shared_ptr<Cell> Maze::getGoal() const {
+  if (goal == NO_CELL)
+    return nullptr;
+  Coordinate c = coordsOf(goal);
+  return makeHandle(c.x, c.y);
+}
+
+std::shared_ptr<Cell> Maze::getGoal() {
+  if (goal == NO_CELL)
+    return nullptr;
+  Coordinate c = coordsOf(goal);
+  return makeHandle(c.x, c.y);
+}
 
 void Maze::setStart(int x, int y) {
   if (isValid(x, y)) {
-    start = grid[y][x];
+    start = indexOf(x, y);
   }
 }
 
 void Maze::setGoal(int x, int y) {
   if (isValid(x, y)) {
-    goal = grid[y][x];
+    goal = indexOf(x, y);
   }
 }
 
@@ -178,8 +1139,12 @@ void Maze::validateDimensions(int width, int height) const {
   if (width < 5 || height < 5) {
     throw std::invalid_argument("Maze dimensions must be at least 5x5");
   }
-  if (width > 100 || height > 100) {
-    throw std::invalid_argument("Maze dimensions must not exceed 100x100");
+  // Both dimensions fit in an int, so the 64-bit cell count cannot overflow;
+  // it must however be addressable by the storage planes on this platform.
+  const CellIndex cellCount =
+      static_cast<CellIndex>(width) * static_cast<CellIndex>(height);
+  if (cellCount > std::numeric_limits<std::size_t>::max()) {
+    throw std::invalid_argument("Maze dimensions exceed addressable memory");
   }
 }
 
@@ -187,17 +1152,17 @@ void Maze::printMaze() const {
   std::cout << std::endl;
   for (int y = 0; y < height; ++y) {
     for (int x = 0; x < width; ++x) {
-      auto cell = grid[y][x];
+      const CellIndex index = indexOf(x, y);
 
-      if (start && *cell == *start) {
+      if (index == start) {
         std::cout << 'S';
-      } else if (goal && *cell == *goal) {
+      } else if (index == goal) {
         std::cout << 'G';
-      } else if (cell->isWall()) {
+      } else if (isWall(x, y)) {
         std::cout << '#';
-      } else if (cell->isPath()) {
+      } else if (isPath(x, y)) {
         std::cout << '*';
-      } else if (cell->isVisited()) {
+      } else if (isVisited(x, y)) {
         std::cout << '.';
       } else {
         std::cout << ' ';
@@ -208,6 +1173,36 @@ void Maze::printMaze() const {
   std::cout << std::endl;
 }
 
+void Maze::fillWalls(bool wall) {
+  if (mappedWalls)
+    detachWalls();
+  std::fill(walls.begin(), walls.end(), 0);
+  wallStamp.edit();
+  if (!wall)
+    return;
+
+  // Only set the bits of real cells so row padding stays clear
+  const int tailBits = width % 64;
+  const std::uint64_t tailMask =
+      tailBits ? (std::uint64_t{1} << tailBits) - 1 : ~std::uint64_t{0};
+  for (int y = 0; y < height; ++y) {
+    std::uint64_t *row = &walls[static_cast<std::size_t>(y) * wordsPerRow];
+    std::fill(row, row + wordsPerRow - 1, ~std::uint64_t{0});
+    row[wordsPerRow - 1] = tailMask;
+  }
+}
+
+void Maze::addBorderWalls() {
+  for (int y = 0; y < height; ++y) {
+    setWall(0, y, true);
+    setWall(width - 1, y, true);
+  }
+  for (int x = 0; x < width; ++x) {
+    setWall(x, 0, true);
+    setWall(x, height - 1, true);
+  }
+}
+
 // ============================================================================
 // MAZE GENERATION ALGORITHMS
 // ============================================================================
@@ -226,11 +1221,7 @@ void Maze::generatePerfectMaze(int w, int h,
 
   // Set all cells as walls initially (except for recursive division)
   if (algorithm != MazeGenerationAlgorithm::RECURSIVE_DIVISION) {
-    for (int y = 0; y < height; ++y) {
-      for (int x = 0; x < width; ++x) {
-        grid[y][x]->setWall(true);
-      }
-    }
+    fillWalls(true);
   }
 
   // Call appropriate algorithm
@@ -246,268 +1237,229 @@ void Maze::generatePerfectMaze(int w, int h,
     break;
   }
 
-  // Set start and goal to valid passage cells (odd coordinates)
-  // This ensures they're on cells that were carved during generation
-  start = grid[1][1];
-  goal = grid[height - 2][width - 2];
-
-  // Make absolutely sure start and goal are not walls
-  start->setWall(false);
-  goal->setWall(false);
+  // Set start and goal to passage cells and make sure they are joined to
+  // the carved passages (with an even dimension the goal lies off the
+  // odd-coordinate lattice)
+  start = indexOf(1, 1);
+  goal = indexOf(width - 2, height - 2);
+  connectToLattice(1, 1);
+  connectToLattice(width - 2, height - 2);
 }
 
-// Helper: Get unvisited neighbors for maze generation
-std::vector<std::shared_ptr<Cell>>
-Maze::getUnvisitedNeighbors(std::shared_ptr<Cell> cell) const {
-  std::vector<std::shared_ptr<Cell>> neighbors;
-  if (!cell)
-    return neighbors;
-
-  int x = cell->getX();
-  int y = cell->getY();
-
-  // Check all four cardinal directions
-  const int dx[] = {0, 0, -1, 1};
-  const int dy[] = {-1, 1, 0, 0};
-
-  for (int i = 0; i < 4; ++i) {
-    int nx = x + dx[i];
-    int ny = y + dy[i];
-
-    if (isValid(nx, ny)) {
-      auto neighbor = grid[ny][nx];
-      if (!neighbor->isVisited()) {
-        neighbors.push_back(neighbor);
-      }
-    }
-  }
-
-  return neighbors;
+int Maze::lastOddCoordinate(int size) {
+  return (size - 2) % 2 == 1 ? size - 2 : size - 3;
 }
 
-// Helper: Remove wall between two adjacent cells
-void Maze::removeWallBetween(std::shared_ptr<Cell> cell1,
-                             std::shared_ptr<Cell> cell2) {
-  if (!cell1 || !cell2)
-    return;
-
-  cell1->setWall(false);
-  cell2->setWall(false);
-}
-
-// Helper: Add wall between two adjacent cells
-void Maze::addWallBetween(std::shared_ptr<Cell> cell1,
-                          std::shared_ptr<Cell> cell2) {
-  if (!cell1 || !cell2)
-    return;
-
-  cell1->setWall(true);
-  cell2->setWall(true);
+void Maze::connectToLattice(int x, int y) {
+  setWall(x, y, false);
+  if (x % 2 == 0) {
+    --x;
+    setWall(x, y, false);
+  }
+  if (y % 2 == 0) {
+    setWall(x, y - 1, false);
+  }
 }
 
 // Algorithm 1: Recursive Backtracking (DFS-based)
+//
+// The backtracking stack is kept implicitly: every carved cell records in the
+// state plane the direction back to the cell it was entered from, so memory
+// use does not grow with the length of the current passage.
 void Maze::generateRecursiveBacktracking() {
-  // Start from random odd position (to ensure proper maze structure)
-  std::uniform_int_distribution<> distX(0, (width - 3) / 2);
-  std::uniform_int_distribution<> distY(0, (height - 3) / 2);
-
-  int startX = 1 + distX(rng) * 2;
-  int startY = 1 + distY(rng) * 2;
+  const int maxX = lastOddCoordinate(width);
+  const int maxY = lastOddCoordinate(height);
 
-  auto current = grid[startY][startX];
-  current->setWall(false);
-  current->setVisited(true);
+  // Start from random odd position (to ensure proper maze structure)
+  std::uniform_int_distribution<> distX(0, (maxX - 1) / 2);
+  std::uniform_int_distribution<> distY(0, (maxY - 1) / 2);
 
-  // Stack for backtracking
-  std::vector<std::shared_ptr<Cell>> stack;
-  stack.push_back(current);
+  const int dx[] = {0, 0, -1, 1}; // UP, DOWN, LEFT, RIGHT
+  const int dy[] = {-1, 1, 0, 0};
+  const int opposite[] = {1, 0, 3, 2};
 
-  while (!stack.empty()) {
-    current = stack.back();
+  Coordinate current{1 + distX(rng) * 2, 1 + distY(rng) * 2};
+  const Coordinate origin = current;
+  allocateState();
+  setWall(current.x, current.y, false);
+  setVisited(current.x, current.y, true);
 
+  while (true) {
     // Get unvisited neighbors (2 cells away in cardinal directions)
-    std::vector<std::shared_ptr<Cell>> neighbors;
-    int x = current->getX();
-    int y = current->getY();
-
-    // Check all four directions (2 cells away)
-    const int dx[] = {0, 0, -2, 2};
-    const int dy[] = {-2, 2, 0, 0};
-
+    int choices[4];
+    int choiceCount = 0;
     for (int i = 0; i < 4; ++i) {
-      int nx = x + dx[i];
-      int ny = y + dy[i];
+      int nx = current.x + 2 * dx[i];
+      int ny = current.y + 2 * dy[i];
 
-      if (isValid(nx, ny) && !grid[ny][nx]->isVisited()) {
-        neighbors.push_back(grid[ny][nx]);
+      if (nx >= 1 && nx <= maxX && ny >= 1 && ny <= maxY &&
+          !isVisited(nx, ny)) {
+        choices[choiceCount++] = i;
       }
     }
 
-    if (!neighbors.empty()) {
+    if (choiceCount > 0) {
       // Choose random neighbor
-      std::uniform_int_distribution<> dist(0, neighbors.size() - 1);
-      auto chosen = neighbors[dist(rng)];
-
-      // Remove wall between current and chosen
-      chosen->setWall(false);
-      chosen->setVisited(true);
-
-      // Remove wall between them (the cell in between)
-      int mx = (current->getX() + chosen->getX()) / 2;
-      int my = (current->getY() + chosen->getY()) / 2;
-      grid[my][mx]->setWall(false);
-
-      stack.push_back(chosen);
+      std::uniform_int_distribution<> dist(0, choiceCount - 1);
+      const int dir = choices[dist(rng)];
+
+      // Remove the wall in between, then move to the chosen cell
+      setWall(current.x + dx[dir], current.y + dy[dir], false);
+      current = {current.x + 2 * dx[dir], current.y + 2 * dy[dir]};
+      setWall(current.x, current.y, false);
+      state[indexOf(current.x, current.y)] = static_cast<std::uint8_t>(
+          STATE_VISITED | (opposite[dir] << STATE_DIRECTION_SHIFT));
+    } else if (current == origin) {
+      break;
     } else {
-      stack.pop_back();
+      // Backtrack to the cell this one was entered from
+      const int back =
+          (state[indexOf(current.x, current.y)] >> STATE_DIRECTION_SHIFT) & 3;
+      current = {current.x + 2 * dx[back], current.y + 2 * dy[back]};
     }
   }
 
-  // Reset visited flags
-  for (int y = 0; y < height; ++y) {
-    for (int x = 0; x < width; ++x) {
-      grid[y][x]->setVisited(false);
-    }
-  }
+  // Release the scratch flags
+  reset();
 }
 
 // Algorithm 2: Randomized Prim's Algorithm
 void Maze::generateRandomizedPrims() {
-  // Start from random cell
-  std::uniform_int_distribution<> distX(1, width - 2);
-  std::uniform_int_distribution<> distY(1, height - 2);
-
-  auto start = grid[distY(rng)][distX(rng)];
-  start->setWall(false);
-  start->setVisited(true);
-
-  // Frontier list (walls adjacent to maze)
-  std::vector<std::shared_ptr<Cell>> frontier;
-
-  // Add neighbors of start to frontier
-  auto neighbors = getNeighbors(start);
-  for (auto &n : neighbors) {
-    if (n->isWall()) {
-      frontier.push_back(n);
-      n->setVisited(true);
-    }
-  }
+  const int maxX = lastOddCoordinate(width);
+  const int maxY = lastOddCoordinate(height);
 
-  while (!frontier.empty()) {
-    // Pick random wall from frontier
-    std::uniform_int_distribution<> dist(0, frontier.size() - 1);
-    int idx = dist(rng);
-    auto wall = frontier[idx];
-    frontier.erase(frontier.begin() + idx);
+  // Start from random odd position
+  std::uniform_int_distribution<> distX(0, (maxX - 1) / 2);
+  std::uniform_int_distribution<> distY(0, (maxY - 1) / 2);
 
-    // Count adjacent cells that are passages
-    int x = wall->getX();
-    int y = wall->getY();
-    int passageCount = 0;
+  const int dx[] = {0, 0, -1, 1};
+  const int dy[] = {-1, 1, 0, 0};
 
-    const int dx[] = {0, 0, -1, 1};
-    const int dy[] = {-1, 1, 0, 0};
+  auto inLattice = [&](int x, int y) {
+    return x >= 1 && x <= maxX && y >= 1 && y <= maxY;
+  };
 
+  // Frontier list: uncarved cells 2 steps away from the carved region.
+  // Cells are marked visited when they join the frontier.
+  std::vector<Coordinate> frontier;
+  auto addFrontier = [&](Coordinate cell) {
     for (int i = 0; i < 4; ++i) {
-      int nx = x + dx[i];
-      int ny = y + dy[i];
-      if (isValid(nx, ny) && !grid[ny][nx]->isWall()) {
-        passageCount++;
+      int nx = cell.x + 2 * dx[i];
+      int ny = cell.y + 2 * dy[i];
+      if (inLattice(nx, ny) && isWall(nx, ny) && !isVisited(nx, ny)) {
+        setVisited(nx, ny, true);
+        frontier.push_back({nx, ny});
       }
     }
+  };
 
-    // If exactly one adjacent cell is a passage, make this a passage
-    if (passageCount == 1) {
-      wall->setWall(false);
-
-      // Add unvisited neighbors to frontier
-      for (int i = 0; i < 4; ++i) {
-        int nx = x + dx[i];
-        int ny = y + dy[i];
-        if (isValid(nx, ny)) {
-          auto neighbor = grid[ny][nx];
-          if (neighbor->isWall() && !neighbor->isVisited()) {
-            frontier.push_back(neighbor);
-            neighbor->setVisited(true);
-          }
-        }
+  const Coordinate first{1 + distX(rng) * 2, 1 + distY(rng) * 2};
+  setWall(first.x, first.y, false);
+  addFrontier(first);
+
+  while (!frontier.empty()) {
+    // Pick random cell from frontier (swap-remove keeps this O(1))
+    std::uniform_int_distribution<std::size_t> dist(0, frontier.size() - 1);
+    const std::size_t idx = dist(rng);
+    const Coordinate cell = frontier[idx];
+    frontier[idx] = frontier.back();
+    frontier.pop_back();
+
+    // Connect it to a random neighbor that is already carved
+    int choices[4];
+    int choiceCount = 0;
+    for (int i = 0; i < 4; ++i) {
+      int nx = cell.x + 2 * dx[i];
+      int ny = cell.y + 2 * dy[i];
+      if (inLattice(nx, ny) && !isWall(nx, ny)) {
+        choices[choiceCount++] = i;
       }
     }
-  }
 
-  // Reset visited flags
-  for (int y = 0; y < height; ++y) {
-    for (int x = 0; x < width; ++x) {
-      grid[y][x]->setVisited(false);
-    }
+    std::uniform_int_distribution<> choice(0, choiceCount - 1);
+    const int dir = choices[choice(rng)];
+    setWall(cell.x + dx[dir], cell.y + dy[dir], false);
+    setWall(cell.x, cell.y, false);
+
+    addFrontier(cell);
   }
+
+  // Release the scratch flags
+  reset();
 }
 
 // Algorithm 3: Recursive Division
+//
+// Chambers are split by walls on even coordinates with a single gap on an
+// odd coordinate, which yields a perfect maze on the odd-coordinate lattice.
+// Pending chambers are kept on an explicit stack instead of the call stack.
 void Maze::generateRecursiveDivision() {
+  const int maxX = lastOddCoordinate(width);
+  const int maxY = lastOddCoordinate(height);
+
   // Start with empty grid
-  for (int y = 0; y < height; ++y) {
-    for (int x = 0; x < width; ++x) {
-      grid[y][x]->setWall(false);
-    }
-  }
+  fillWalls(false);
 
-  // Add border walls
-  for (int y = 0; y < height; ++y) {
-    grid[y][0]->setWall(true);
-    grid[y][width - 1]->setWall(true);
+  // Add border walls, plus the unused last row/column of even dimensions
+  addBorderWalls();
+  for (int x = 1; x < width - 1 && maxY < height - 2; ++x) {
+    setWall(x, height - 2, true);
   }
-  for (int x = 0; x < width; ++x) {
-    grid[0][x]->setWall(true);
-    grid[height - 1][x]->setWall(true);
+  for (int y = 1; y < height - 1 && maxX < width - 2; ++y) {
+    setWall(width - 2, y, true);
   }
 
-  // Recursive division helper
-  std::function<void(int, int, int, int)> divide = [&](int x, int y, int w,
-                                                       int h) {
-    if (w < 2 || h < 2)
-      return;
+  // Chamber of open cells; x/y/w/h are all odd
+  struct Chamber {
+    int x, y, w, h;
+  };
+  std::vector<Chamber> chambers;
+  chambers.push_back({1, 1, maxX, maxY});
+
+  while (!chambers.empty()) {
+    const Chamber c = chambers.back();
+    chambers.pop_back();
+
+    if (c.w < 3 && c.h < 3)
+      continue;
 
     // Choose orientation
-    bool horizontal = (h > w) || (h == w && (rng() % 2 == 0));
+    bool horizontal = (c.h > c.w) || (c.h == c.w && (rng() % 2 == 0));
 
     if (horizontal) {
-      // Draw horizontal wall
-      std::uniform_int_distribution<> wallDist(y, y + h - 1);
-      std::uniform_int_distribution<> gapDist(x, x + w - 1);
+      // Draw horizontal wall on an even row, leaving a gap on an odd column
+      std::uniform_int_distribution<> wallDist(0, (c.h - 3) / 2);
+      std::uniform_int_distribution<> gapDist(0, (c.w - 1) / 2);
 
-      int wallY = wallDist(rng);
-      int gapX = gapDist(rng);
+      int wallY = c.y + 1 + 2 * wallDist(rng);
+      int gapX = c.x + 2 * gapDist(rng);
 
-      for (int i = x; i < x + w; ++i) {
-        if (i != gapX && isValid(i, wallY)) {
-          grid[wallY][i]->setWall(true);
+      for (int i = c.x; i < c.x + c.w; ++i) {
+        if (i != gapX) {
+          setWall(i, wallY, true);
         }
       }
 
-      // Recursively divide sub-regions
-      divide(x, y, w, wallY - y);
-      divide(x, wallY + 1, w, y + h - wallY - 1);
+      // Divide sub-regions
+      chambers.push_back({c.x, c.y, c.w, wallY - c.y});
+      chambers.push_back({c.x, wallY + 1, c.w, c.y + c.h - wallY - 1});
     } else {
-      // Draw vertical wall
-      std::uniform_int_distribution<> wallDist(x, x + w - 1);
-      std::uniform_int_distribution<> gapDist(y, y + h - 1);
+      // Draw vertical wall on an even column, leaving a gap on an odd row
+      std::uniform_int_distribution<> wallDist(0, (c.w - 3) / 2);
+      std::uniform_int_distribution<> gapDist(0, (c.h - 1) / 2);
 
-      int wallX = wallDist(rng);
-      int gapY = gapDist(rng);
+      int wallX = c.x + 1 + 2 * wallDist(rng);
+      int gapY = c.y + 2 * gapDist(rng);
 
-      for (int i = y; i < y + h; ++i) {
-        if (i != gapY && isValid(wallX, i)) {
-          grid[i][wallX]->setWall(true);
+      for (int i = c.y; i < c.y + c.h; ++i) {
+        if (i != gapY) {
+          setWall(wallX, i, true);
         }
       }
 
-      // Recursively divide sub-regions
-      divide(x, y, wallX - x, h);
-      divide(wallX + 1, y, x + w - wallX - 1, h);
+      // Divide sub-regions
+      chambers.push_back({c.x, c.y, wallX - c.x, c.h});
+      chambers.push_back({wallX + 1, c.y, c.x + c.w - wallX - 1, c.h});
     }
-  };
-
-  // Start recursive division
-  divide(1, 1, width - 2, height - 2);
+  }
 }
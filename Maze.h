@@ -1,6 +1,7 @@
 #ifndef MAZE_H
 #define MAZE_H
 
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <string>
@@ -9,6 +10,8 @@
 
 #include "Cell.h"
 
+class MappedFile;
+
 /**
  * @brief Enum for maze generation algorithms.
  */
@@ -19,13 +22,93 @@ enum class MazeGenerationAlgorithm {
 };
 
 /**
- * @brief Represents a 2D maze grid composed of Cell objects.
+ * @brief Which neighbors a search may step to.
+ */
+enum class Connectivity {
+  FOUR, // Up, down, left and right
+  EIGHT // Also the four diagonals
+};
+
+/**
+ * @brief When a diagonal step may pass the corner of a wall. A diagonal
+ * step always needs its target cell open; the rule concerns the two cells
+ * it passes between (e.g. above and left of the cell for UP_LEFT).
+ */
+enum class CornerRule {
+  ALWAYS,           // Both passed cells may be walls
+  AT_MOST_ONE_WALL, // Blocked only if both passed cells are walls
+  NO_WALLS          // Both passed cells must be open (no corner cutting)
+};
+
+/**
+ * @brief How a search moves between cells; held by the SearchContext, so
+ * it is chosen per query.
+ *
+ * 4-connected steps cost 1. 8-connected steps are measured in tenths: 10
+ * for a straight step and 14 for a diagonal one (about 10 * sqrt(2)), so
+ * costs stay integral. Either is multiplied by the terrain cost of the
+ * cell entered (Maze::getCost()).
+ */
+struct Movement {
+  Connectivity connectivity = Connectivity::FOUR;
+  CornerRule corners = CornerRule::NO_WALLS;
+
+  static constexpr PathCost STRAIGHT_COST = 10; // 8-connected straight step
+  static constexpr PathCost DIAGONAL_COST = 14; // 8-connected diagonal step
+
+  /**
+   * @brief Check whether a step is diagonal.
+   */
+  static constexpr bool isDiagonal(Direction step) {
+    return static_cast<unsigned>(step) >= 4;
+  }
+
+  /**
+   * @brief Get the cost of a step into a cell of terrain cost 1.
+   */
+  PathCost stepCost(Direction step) const {
+    if (connectivity == Connectivity::FOUR)
+      return 1;
+    return isDiagonal(step) ? DIAGONAL_COST : STRAIGHT_COST;
+  }
+};
+
+/**
+ * @brief Represents a 2D maze grid.
  *
  * The Maze class manages the grid structure, provides methods to load/generate
  * mazes, and offers utilities to access cells and their neighbors.
+ *
+ * Cells are stored as flat, row-major planes rather than as individual
+ * objects: a wall bitmap (one bit per cell, rows padded to 64-bit words) and a
+ * visited/path annotation plane (one byte per cell). A cell is addressed by its
+ * index y * width + x, from which its coordinates are derived. The Cell
+ * objects handed out by getCell() and getNeighbors() are handles onto these
+ * planes; a const Maze hands out read-only handles.
+ *
+ * Searches do not write to the maze; their state lives in a SearchContext.
+ * The annotation plane is only for callers that flag cells themselves, so it
+ * is allocated on the first setVisited()/setPath() and released by reset().
+ *
+ * Index math is done in 64 bits (CellIndex), so there is no fixed size
+ * ceiling: each dimension is limited only by int, and the grid by available
+ * memory (about 0.13 bytes per cell without annotations or costs).
+ *
+ * Terrain costs are an optional third plane of one byte per cell (see
+ * getCost()), allocated only for mazes that use them.
+ *
+ * A maze loaded with loadFromBinaryFile() reads its wall bitmap (and cost
+ * plane) straight from the memory-mapped file. Such a maze is read-only until
+ * a wall or cost is changed, at which point that plane is copied into memory
+ * owned by the maze.
  */
 class Maze {
 public:
+  /**
+   * @brief Index value used when no cell is set (e.g. no start or goal).
+   */
+  static constexpr CellIndex NO_CELL = ~CellIndex{0};
+
   /**
    * @brief Construct a new Maze object with specified dimensions.
    * @param width The width of the maze (number of columns).
@@ -43,11 +126,130 @@ public:
    *   - '#' or '1' = wall
    *   - 'S' = start position
    *   - 'G' = goal position
+   * - Optionally, a line "costs" right after the grid, followed by one line
+   *   per row holding the cost of each cell (1-255, separated by spaces).
+   *   Without it every cell costs 1.
+   *
+   * Rows shorter than the width are padded with open cells. A longer row or
+   * any other character is an error, reported with its line number. Other
+   * lines after the grid are ignored.
+   *
+   * The file is mapped and read in one pass. Large files are split into
+   * chunks of whole rows that are parsed on parallel threads.
+   *
+   * @param filename Path to the maze file.
+   * @param threads Maximum number of parsing threads (0 = one per hardware
+   * thread). Files under 1 MiB per thread use fewer.
+   * @return true if the maze was loaded successfully, false otherwise (the
+   * maze is left unchanged).
+   */
+  bool loadFromFile(const std::string &filename, unsigned threads = 0);
+
+  /**
+   * @brief Save the maze in the text format read by loadFromFile().
+   * Walls are written as '#' and open cells as '.'. The costs section is
+   * written if the maze has a cost plane.
+   * @param filename Path to the file to create or overwrite.
+   * @return true if the file was written successfully, false otherwise.
+   */
+  bool saveToFile(const std::string &filename) const;
+
+  /**
+   * @brief Load a maze from a binary maze file, without parsing.
+   *
+   * The file is memory-mapped and the maze's wall bitmap is backed directly
+   * by the mapped pages, so loading takes constant time regardless of the
+   * maze size; pages are read from disk as searches first touch them.
+   *
+   * File format (version 1 or 2, little-endian):
+   * - A 64-byte header: the magic "MAZEBIN\0", version, header size, width,
+   *   height, 64-bit words per row, start and goal cell indices (NO_CELL if
+   *   unset), a checksum of the wall bitmap, the lowest and highest cell
+   *   cost (0 in version 1) and 6 reserved bytes.
+   * - The wall bitmap exactly as the Maze stores it: one bit per cell, bit
+   *   x % 64 of word x / 64 of each row, rows padded to whole 64-bit words.
+   * - Version 2 only: the cost plane, one byte per cell in cell index order.
+   *   The cost plane is mapped like the wall bitmap.
    *
    * @param filename Path to the maze file.
-   * @return true if the maze was loaded successfully, false otherwise.
+   * @param verifyChecksum Whether to check the wall bitmap against the
+   * header's checksum, and the costs against their lowest and highest. This
+   * reads the whole file, so it is off by default.
+   * @return true if the maze was loaded successfully, false otherwise (the
+   * maze is left unchanged).
    */
-  bool loadFromFile(const std::string &filename);
+  bool loadFromBinaryFile(const std::string &filename,
+                          bool verifyChecksum = false);
+
+  /**
+   * @brief Save the maze in the binary format read by loadFromBinaryFile().
+   * Mazes without a cost plane are written as version 1.
+   * @param filename Path to the file to create or overwrite.
+   * @return true if the file was written successfully, false otherwise.
+   */
+  bool saveToBinaryFile(const std::string &filename) const;
+
+  /**
+   * @brief Load the walls of a maze from a PBM or PGM image.
+   *
+   * Supported are PBM (P1 ASCII, P4 binary), where black (1) pixels are
+   * walls, and PGM (P2 ASCII, P5 binary), where pixels darker than the
+   * threshold are walls. P4 rows are bit-packed already and are copied into
+   * the wall bitmap a 64-bit word at a time.
+   *
+   * Images have no start or goal. They are read from the optional sidecar
+   * file filename + ".sg", which holds lines "start X Y" and "goal X Y";
+   * otherwise they are left unset for the caller to set with setStart() and
+   * setGoal().
+   *
+   * @param filename Path to the image file.
+   * @param threshold PGM gray value below which a pixel is a wall (default:
+   * half the image's maximum gray value). Ignored for PBM images.
+   * @return true if the maze was loaded successfully, false otherwise (the
+   * maze is left unchanged).
+   */
+  bool loadFromImageFile(const std::string &filename, int threshold = -1);
+
+  /**
+   * @brief Check whether the wall bitmap is backed by a mapped file.
+   * @return true after loadFromBinaryFile() until the walls are modified or
+   * the maze is regenerated.
+   */
+  bool isMapped() const;
+
+  /**
+   * @brief Get the FNV-1a checksum of the wall bitmap, as stored in binary
+   * maze files. Reads the whole bitmap.
+   * @return The checksum; equal for mazes with identical walls.
+   */
+  std::uint64_t getWallChecksum() const;
+
+  /**
+   * @brief Identifies the walls of a maze without reading them.
+   *
+   * The origin is unique in the process and is taken when the maze is
+   * constructed, copied, generated or loaded; each setWall() or fillWalls()
+   * after that counts as an edit. Equal versions mean equal walls, but a
+   * copy gets a new origin, so it differs from its original even while
+   * their walls agree.
+   */
+  struct WallVersion {
+    std::uint64_t origin;
+    std::uint64_t edits;
+
+    bool operator==(const WallVersion &other) const {
+      return origin == other.origin && edits == other.edits;
+    }
+    bool operator!=(const WallVersion &other) const {
+      return !(*this == other);
+    }
+  };
+
+  /**
+   * @brief Get the version of the walls (see WallVersion). O(1), so it
+   * suits checks made on every query, where getWallChecksum() does not.
+   */
+  WallVersion getWallVersion() const { return wallStamp.get(); }
 
   /**
    * @brief Generate a simple maze programmatically.
@@ -74,10 +276,12 @@ public:
    * @brief Get a reference to a cell at the specified coordinates.
    * @param x The x-coordinate.
    * @param y The y-coordinate.
-   * @return A shared pointer to the Cell at (x, y).
+   * @return A shared pointer to the Cell at (x, y), read-only if the maze
+   * is const.
    * @throws std::out_of_range if coordinates are invalid.
    */
   std::shared_ptr<Cell> getCell(int x, int y) const;
+  std::shared_ptr<Cell> getCell(int x, int y);
 
   /**
    * @brief Get all valid neighbors of a cell (not walls, within bounds).
@@ -86,6 +290,141 @@ public:
    */
   std::vector<std::shared_ptr<Cell>>
   getNeighbors(std::shared_ptr<Cell> cell) const;
+  std::vector<std::shared_ptr<Cell>> getNeighbors(std::shared_ptr<Cell> cell);
+
+  /**
+   * @brief Get the row-major index of a cell.
+   * @param x The x-coordinate (must be valid).
+   * @param y The y-coordinate (must be valid).
+   * @return The index y * width + x.
+   */
+  CellIndex indexOf(int x, int y) const;
+
+  /**
+   * @brief Get the coordinates of a cell from its row-major index.
+   * @param index The cell index (must be valid).
+   * @return The (x, y) coordinates of the cell.
+   */
+  Coordinate coordsOf(CellIndex index) const;
+
+  /**
+   * @brief Get the bit for a direction in an open-direction mask.
+   * @param dir The direction.
+   * @return 1 << dir.
+   */
+  static constexpr std::uint8_t directionBit(Direction dir) {
+    return static_cast<std::uint8_t>(1u << static_cast<unsigned>(dir));
+  }
+
+  /**
+   * @brief Get the directions in which a cell has an open neighbor.
+   * Allocation-free alternative to getNeighbors() for search inner loops.
+   * @param x The x-coordinate (must be valid).
+   * @param y The y-coordinate (must be valid).
+   * @return A 4-bit mask with directionBit(d) set if the neighbor in
+   * direction d is within bounds and not a wall.
+   */
+  std::uint8_t openDirections(int x, int y) const;
+
+  /**
+   * @brief Get the index of the adjacent cell in a direction.
+   * @param index The cell index.
+   * @param dir The direction to step in (the neighbor must be in bounds).
+   * @return The index of the neighbor.
+   */
+  CellIndex neighborIndex(CellIndex index, Direction dir) const;
+
+  /**
+   * @brief Call a visitor for every open neighbor of a cell.
+   * Neighbors are visited in Direction order (up, down, left, right), the
+   * same order getNeighbors() returns them in. Nothing is allocated.
+   * @param index The cell index.
+   * @param visit Callable invoked as visit(CellIndex neighbor, Direction dir),
+   * where dir is the step from the cell to the neighbor.
+   */
+  template <typename Visitor>
+  void forEachNeighbor(CellIndex index, Visitor &&visit) const;
+
+  /**
+   * @brief Call a visitor for every neighbor a search may step to.
+   * With 4-connected movement this is forEachNeighbor(index, visit). With
+   * 8-connected movement the diagonals allowed by the corner rule follow the
+   * cardinal neighbors, in Direction order. Nothing is allocated.
+   * @param index The cell index.
+   * @param movement The connectivity and corner rule of the search.
+   * @param visit Callable invoked as visit(CellIndex neighbor, Direction dir).
+   */
+  template <typename Visitor>
+  void forEachNeighbor(CellIndex index, const Movement &movement,
+                       Visitor &&visit) const;
+
+  // --- Per-cell state, addressed by (valid) coordinates ---
+  bool isWall(int x, int y) const;
+  void setWall(int x, int y, bool wall);
+  bool isVisited(int x, int y) const;
+  void setVisited(int x, int y, bool visited);
+  bool isPath(int x, int y) const;
+  void setPath(int x, int y, bool path);
+
+  // --- Terrain costs ---
+
+  /**
+   * @brief Get the cost of moving into a cell.
+   *
+   * Costs are 1-255 and held in an optional plane of one byte per cell,
+   * allocated on the first setCost(). Without it every cell costs 1. The
+   * cost of a path is the sum of the costs of its cells after the start;
+   * Dijkstra and A* minimize it, the other searches count steps only.
+   *
+   * @param x The x-coordinate (must be valid).
+   * @param y The y-coordinate (must be valid).
+   * @return The cost of the cell (1 if the maze has no cost plane).
+   */
+  std::uint8_t getCost(int x, int y) const;
+
+  /**
+   * @brief Set the cost of moving into a cell.
+   * @param x The x-coordinate (must be valid).
+   * @param y The y-coordinate (must be valid).
+   * @param cost The cost, 1-255.
+   * @throws std::invalid_argument if cost is 0.
+   */
+  void setCost(int x, int y, std::uint8_t cost);
+
+  /**
+   * @brief Check whether the maze has a cost plane (see getCost()).
+   */
+  bool hasCosts() const;
+
+  /**
+   * @brief Get the cost plane, one byte per cell in cell index order.
+   * @return The plane, or nullptr if every cell costs 1.
+   */
+  const std::uint8_t *getCostPlane() const {
+    return mappedCosts ? mappedCosts : (costs.empty() ? nullptr : costs.data());
+  }
+
+  /**
+   * @brief Get the lowest cost of any cell (walls included).
+   * Scaling a step-count heuristic by it keeps the heuristic admissible.
+   */
+  std::uint8_t getMinCost() const { return minCost; }
+
+  /**
+   * @brief Get the highest cost of any cell (walls included).
+   */
+  std::uint8_t getMaxCost() const { return maxCost; }
+
+  /**
+   * @brief Get the version of the cost plane, kept like getWallVersion():
+   * each setCost(), clearCosts() or load counts as an edit.
+   */
+  WallVersion getCostVersion() const { return costStamp.get(); }
+
+  /**
+   * @brief Release the cost plane, so that every cell costs 1 again.
+   */
+  void clearCosts();
 
   /**
    * @brief Check if coordinates are within the maze bounds.
@@ -97,7 +436,7 @@ public:
 
   /**
    * @brief Reset all cells in the maze to their initial state.
-   * Clears visited and path flags but preserves wall status.
+   * Releases the visited/path annotation plane but preserves the wall bitmap.
    */
   void reset();
 
@@ -113,17 +452,25 @@ public:
    */
   int getHeight() const;
 
+  /**
+   * @brief Get the number of cells in the maze.
+   * @return width * height.
+   */
+  CellIndex getCellCount() const;
+
   /**
    * @brief Get the start cell of the maze.
    * @return A shared pointer to the start cell.
    */
   std::shared_ptr<Cell> getStart() const;
+  std::shared_ptr<Cell> getStart();
 
   /**
    * @brief Get the goal cell of the maze.
    * @return A shared pointer to the goal cell.
    */
   std::shared_ptr<Cell> getGoal() const;
+  std::shared_ptr<Cell> getGoal();
 
   /**
    * @brief Set the start cell of the maze.
@@ -146,22 +493,117 @@ public:
   void printMaze() const;
 
 private:
+  // Bits of the per-cell state plane.
+  static constexpr std::uint8_t STATE_VISITED = 1 << 0;
+  static constexpr std::uint8_t STATE_PATH = 1 << 1;
+  // Two scratch bits used by the generators to record a backtrack direction.
+  static constexpr int STATE_DIRECTION_SHIFT = 2;
+
   int width;
   int height;
-  std::vector<std::vector<std::shared_ptr<Cell>>> grid;
-  std::shared_ptr<Cell> start;
-  std::shared_ptr<Cell> goal;
+  std::size_t wordsPerRow;          // 64-bit words per wall bitmap row
+  std::vector<std::uint64_t> walls; // Wall bitmap, one bit per cell
+  std::vector<std::uint8_t> state;  // Visited/path flags, allocated on demand
+  std::vector<std::uint8_t> costs;  // Terrain costs, allocated on demand
+  std::vector<CellIndex> costCounts; // Cells per cost value, with costs
+  std::uint8_t minCost;              // Lowest cell cost
+  std::uint8_t maxCost;              // Highest cell cost
+  CellIndex start;                  // Index of the start cell, or NO_CELL
+  CellIndex goal;                   // Index of the goal cell, or NO_CELL
+
+  // Version of the walls; a copy of the maze starts a new one
+  class WallStamp {
+  public:
+    WallStamp() { restart(); }
+    WallStamp(const WallStamp &) { restart(); }
+    WallStamp &operator=(const WallStamp &) {
+      restart();
+      return *this;
+    }
+    void restart(); // New origin, no edits
+    void edit() { ++version.edits; }
+    WallVersion get() const { return version; }
+
+  private:
+    WallVersion version;
+  };
+  WallStamp wallStamp;
+  WallStamp costStamp;
+
+  // Wall bitmap of a maze loaded from a binary file, read in place from the
+  // mapping (shared by copies of the maze); nullptr when walls are owned
+  std::shared_ptr<const MappedFile> mapping;
+  const std::uint64_t *mappedWalls;
+  const std::uint8_t *mappedCosts; // Cost plane in the mapping, or nullptr
 
   /**
-   * @brief Initialize the grid with Cell objects.
+   * @brief Allocate cleared storage planes for the current dimensions.
+   * Releases any mapped file.
    */
   void initializeGrid();
 
+  /**
+   * @brief Get the wall bitmap, wherever it is stored.
+   */
+  const std::uint64_t *wallWords() const {
+    return mappedWalls ? mappedWalls : walls.data();
+  }
+
+  /**
+   * @brief Copy a mapped wall bitmap into owned memory so it can be
+   * modified, and release the mapping.
+   */
+  void detachWalls();
+
+  /**
+   * @brief Copy a mapped cost plane into owned memory so it can be
+   * modified, releasing the mapping if the walls no longer use it.
+   */
+  void detachCosts();
+
+  /**
+   * @brief Take a cost plane (empty for uniform costs of 1) and count the
+   * cells of each cost, replacing any mapped plane.
+   * @param plane One cost per cell in cell index order, all nonzero.
+   */
+  void adoptCosts(std::vector<std::uint8_t> plane);
+
+  /**
+   * @brief Create a Cell handle for a cell of this maze, read-only unless
+   * the maze is non-const.
+   * @param x The x-coordinate (must be valid).
+   * @param y The y-coordinate (must be valid).
+   * @return A shared pointer to a handle viewing the cell.
+   */
+  std::shared_ptr<Cell> makeHandle(int x, int y) const;
+  std::shared_ptr<Cell> makeHandle(int x, int y);
+
+  /**
+   * @brief Shared body of the getNeighbors() overloads.
+   */
+  template <typename Self>
+  static std::vector<std::shared_ptr<Cell>>
+  neighborHandles(Self &self, const std::shared_ptr<Cell> &cell);
+
+  /**
+   * @brief Set or clear a state plane flag for a cell.
+   * @param index The cell index.
+   * @param flag The STATE_* bit to change.
+   * @param value Whether the flag should be set.
+   */
+  void setStateFlag(CellIndex index, std::uint8_t flag, bool value);
+
+  /**
+   * @brief Allocate the cleared state plane if it does not exist yet.
+   */
+  void allocateState();
+
   /**
    * @brief Validate maze dimensions.
    * @param width The width to validate.
    * @param height The height to validate.
-   * @throws std::invalid_argument if dimensions are out of range.
+   * @throws std::invalid_argument if dimensions are out of range or the grid
+   * would not be addressable.
    */
   void validateDimensions(int width, int height) const;
 
@@ -170,15 +612,100 @@ private:
   void generateRandomizedPrims();
   void generateRecursiveDivision();
 
-  // Helper methods for maze generation
-  std::vector<std::shared_ptr<Cell>>
-  getUnvisitedNeighbors(std::shared_ptr<Cell> cell) const;
-  void removeWallBetween(std::shared_ptr<Cell> cell1,
-                         std::shared_ptr<Cell> cell2);
-  void addWallBetween(std::shared_ptr<Cell> cell1, std::shared_ptr<Cell> cell2);
+  /**
+   * @brief Set every cell's wall bit.
+   * @param wall The value to store for all cells.
+   */
+  void fillWalls(bool wall);
+
+  /**
+   * @brief Add walls along the outer border of the grid.
+   */
+  void addBorderWalls();
+
+  /**
+   * @brief Largest odd coordinate usable by the perfect-maze generators.
+   * Passages are carved on odd coordinates; with an even dimension the
+   * last interior row/column is left solid.
+   * @param size The width or height of the maze.
+   */
+  static int lastOddCoordinate(int size);
+
+  /**
+   * @brief Open a cell and attach it to the carved odd-coordinate lattice.
+   * Used for start/goal cells that may lie on even coordinates; the cell is
+   * joined through a single chain so the maze stays a tree.
+   * @param x The x-coordinate of the cell.
+   * @param y The y-coordinate of the cell.
+   */
+  void connectToLattice(int x, int y);
 
   // Random number generator
   mutable std::mt19937 rng;
 };
 
+inline bool Maze::isWall(int x, int y) const {
+  const std::uint64_t word =
+      wallWords()[static_cast<std::size_t>(y) * wordsPerRow + x / 64];
+  return (word >> (x % 64)) & 1;
+}
+
+template <typename Visitor>
+void Maze::forEachNeighbor(CellIndex index, Visitor &&visit) const {
+  const Coordinate coords = coordsOf(index);
+  const std::uint8_t open = openDirections(coords.x, coords.y);
+  const CellIndex w = static_cast<CellIndex>(width);
+
+  if (open & directionBit(Direction::UP))
+    visit(index - w, Direction::UP);
+  if (open & directionBit(Direction::DOWN))
+    visit(index + w, Direction::DOWN);
+  if (open & directionBit(Direction::LEFT))
+    visit(index - 1, Direction::LEFT);
+  if (open & directionBit(Direction::RIGHT))
+    visit(index + 1, Direction::RIGHT);
+}
+
+template <typename Visitor>
+void Maze::forEachNeighbor(CellIndex index, const Movement &movement,
+                           Visitor &&visit) const {
+  if (movement.connectivity == Connectivity::FOUR) {
+    forEachNeighbor(index, visit);
+    return;
+  }
+
+  const Coordinate coords = coordsOf(index);
+  const std::uint8_t open = openDirections(coords.x, coords.y);
+  const CellIndex w = static_cast<CellIndex>(width);
+
+  if (open & directionBit(Direction::UP))
+    visit(index - w, Direction::UP);
+  if (open & directionBit(Direction::DOWN))
+    visit(index + w, Direction::DOWN);
+  if (open & directionBit(Direction::LEFT))
+    visit(index - 1, Direction::LEFT);
+  if (open & directionBit(Direction::RIGHT))
+    visit(index + 1, Direction::RIGHT);
+
+  // A diagonal step needs its target open and, depending on the corner
+  // rule, the cells it passes between (a border counts as a wall)
+  const int requiredOpen = movement.corners == CornerRule::ALWAYS ? 0
+                           : movement.corners == CornerRule::AT_MOST_ONE_WALL
+                               ? 1
+                               : 2;
+  auto diagonal = [&](Direction vertical, Direction horizontal,
+                      Direction step) {
+    const int x = coords.x + (horizontal == Direction::LEFT ? -1 : 1);
+    const int y = coords.y + (vertical == Direction::UP ? -1 : 1);
+    const int openSides = ((open & directionBit(vertical)) != 0) +
+                          ((open & directionBit(horizontal)) != 0);
+    if (openSides >= requiredOpen && isValid(x, y) && !isWall(x, y))
+      visit(static_cast<CellIndex>(y) * w + static_cast<CellIndex>(x), step);
+  };
+  diagonal(Direction::UP, Direction::LEFT, Direction::UP_LEFT);
+  diagonal(Direction::DOWN, Direction::RIGHT, Direction::DOWN_RIGHT);
+  diagonal(Direction::UP, Direction::RIGHT, Direction::UP_RIGHT);
+  diagonal(Direction::DOWN, Direction::LEFT, Direction::DOWN_LEFT);
+}
+
 #endif // MAZE_H
@@ -1,4 +1,5 @@
 #include "MazeVisualizer.h"
+#include <algorithm>
 #include <iostream>
 #include <set>
 
@@ -40,7 +41,11 @@ void MazeVisualizer::displayMazeWithPath(const Maze &maze,
   std::cout << std::endl;
 }
 
-void MazeVisualizer::displayMazeWithVisited(const Maze &maze) {
+void MazeVisualizer::displayMazeWithVisited(const Maze &maze,
+                                            const SearchContext &context) {
+  // A context that was never used on this maze has nothing to show
+  const bool searched = context.getCellCount() == maze.getCellCount();
+
   std::cout << std::endl;
   for (int y = 0; y < maze.getHeight(); ++y) {
     for (int x = 0; x < maze.getWidth(); ++x) {
@@ -54,7 +59,9 @@ void MazeVisualizer::displayMazeWithVisited(const Maze &maze) {
         std::cout << 'S';
       } else if (isGoal) {
         std::cout << 'G';
-      } else if (cell->isVisited()) {
+      } else if (searched && context.isPath(maze.indexOf(x, y))) {
+        std::cout << '*';
+      } else if (searched && context.isVisited(maze.indexOf(x, y))) {
         std::cout << '.';
       } else {
         std::cout << ' ';
@@ -65,6 +72,36 @@ void MazeVisualizer::displayMazeWithVisited(const Maze &maze) {
   std::cout << std::endl;
 }
 
+void MazeVisualizer::displayDistanceHeatmap(
+    const Maze &maze, const DistanceTransform &transform) {
+  // Shades in order of distance, splitting 0..max into equal bands
+  const char shades[] = ".:-=+*%@";
+  const std::uint64_t bands = sizeof(shades) - 1;
+  const std::uint64_t maxDistance = transform.getMaxDistance();
+  const bool built = transform.matches(maze);
+
+  std::cout << std::endl;
+  for (int y = 0; y < maze.getHeight(); ++y) {
+    for (int x = 0; x < maze.getWidth(); ++x) {
+      const PathCost distance =
+          built ? transform.getDistance(maze.indexOf(x, y))
+                : DistanceTransform::UNREACHABLE;
+      if (maze.isWall(x, y)) {
+        std::cout << '#';
+      } else if (distance == 0) {
+        std::cout << 'X';
+      } else if (distance == DistanceTransform::UNREACHABLE) {
+        std::cout << ' ';
+      } else {
+        const std::uint64_t band = distance * bands / maxDistance;
+        std::cout << shades[std::min(bands - 1, band)];
+      }
+    }
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+}
+
 char MazeVisualizer::getCellChar(std::shared_ptr<Cell> cell, bool isInPath,
                                  bool isStart, bool isGoal) {
   if (cell->isWall()) {
@@ -2,7 +2,9 @@
 #define MAZE_VISUALIZER_H
 
 #include "Cell.h"
+#include "DistanceTransform.h"
 #include "Maze.h"
+#include "SearchContext.h"
 #include <vector>
 
 
@@ -29,10 +31,22 @@ public:
                                   const std::vector<Cell> &path);
 
   /**
-   * @brief Display the maze with visited cells highlighted.
+   * @brief Display the maze with the visited cells and path of a search.
    * @param maze The maze to display.
+   * @param context The search state to show (visited '.', path '*').
    */
-  static void displayMazeWithVisited(const Maze &maze);
+  static void displayMazeWithVisited(const Maze &maze,
+                                     const SearchContext &context);
+
+  /**
+   * @brief Display the maze as a heatmap of the distance to the nearest
+   * source. Sources are shown as 'X', and reached cells in eight shades
+   * from '.' (near) to '@' (as far as any cell gets).
+   * @param maze The maze to display.
+   * @param transform The distances to show, built for this maze.
+   */
+  static void displayDistanceHeatmap(const Maze &maze,
+                                     const DistanceTransform &transform);
 
 private:
   /**
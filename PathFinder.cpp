@@ -0,0 +1,71 @@
+#include "PathFinder.h"
+
+#include "ComponentIndex.h"
+#include "Maze.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+void PathFinder::reconstructPath(const Maze &maze, SearchContext &context,
+                                 CellIndex start, CellIndex goal) {
+  const int dx[] = {0, 0, -1, 1, -1, 1, 1, -1}; // In Direction order
+  const int dy[] = {-1, 1, 0, 0, -1, 1, -1, 1};
+  const Movement &movement = context.getMovement();
+
+  std::vector<Cell> &path = context.getPath();
+  Coordinate current = maze.coordsOf(goal);
+  path.emplace_back(current.x, current.y);
+  context.markPath(goal);
+
+  std::uint64_t cost = 0;
+  for (CellIndex index = goal; index != start;) {
+    const std::uint8_t dir = context.getParentDirection(index);
+    cost += movement.stepCost(static_cast<Direction>(dir)) *
+            maze.getCost(current.x, current.y);
+    current = {current.x + dx[dir], current.y + dy[dir]};
+    path.emplace_back(current.x, current.y);
+    index = maze.indexOf(current.x, current.y);
+    context.markPath(index);
+  }
+
+  std::reverse(path.begin(), path.end());
+  context.getStats().pathLength = path.size();
+  context.getStats().pathCost = cost;
+}
+
+void PathFinder::joinReversePath(const Maze &maze, SearchContext &context,
+                                 CellIndex meeting, CellIndex goal) {
+  const SearchContext &reverse = context.getReverse();
+  for (CellIndex index = meeting; index != goal;) {
+    // The backward parent points towards the goal
+    const Direction step =
+        static_cast<Direction>(reverse.getParentDirection(index));
+    const CellIndex next = maze.neighborIndex(index, step);
+    context.markVisited(next, SearchContext::oppositeDirection(step));
+    index = next;
+  }
+}
+
+void PathFinder::requireFourConnected(const SearchContext &context,
+                                      const char *algorithm) {
+  if (context.getMovement().connectivity != Connectivity::FOUR) {
+    throw std::invalid_argument(std::string(algorithm) +
+                                " supports only 4-connected movement");
+  }
+}
+
+bool PathFinder::isUnreachable(const Maze &maze, const SearchContext &context,
+                               CellIndex start, CellIndex goal) {
+  const ComponentIndex *components = context.getComponents();
+  if (!components || context.getMovement().connectivity != Connectivity::FOUR)
+    return false;
+  if (!components->matches(maze)) {
+    throw std::invalid_argument(
+        "Component index was not built for this maze");
+  }
+  // Searches may leave a wall start, so only open cells are compared
+  const std::uint32_t startLabel = components->getLabel(start);
+  const std::uint32_t goalLabel = components->getLabel(goal);
+  return startLabel != ComponentIndex::NO_LABEL &&
+         goalLabel != ComponentIndex::NO_LABEL && startLabel != goalLabel;
+}
@@ -3,15 +3,14 @@
 
 #include "Cell.h"
 #include "PathStats.h"
+#include "SearchContext.h"
+#include "SearchEngine.h"
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <vector>
 
-// Forward declaration for the Maze class.
-// The PathFinder holds a reference to the maze it operates on, but doesn't own
-// it.
-class Maze;
-
 /**
  * @brief Abstract base class for all pathfinding algorithms.
  *
@@ -34,9 +33,7 @@ public:
   virtual ~PathFinder() = default;
 
   /**
-   * @brief The primary pathfinding method that all concrete classes must
-   * implement. This is a pure virtual function, making PathFinder an abstract
-   * class.
+   * @brief Find a path using this pathfinder's own SearchContext.
    *
    * @param maze A reference to the maze grid to be traversed.
    * @param start A smart pointer to the starting cell. Using std::shared_ptr
@@ -47,21 +44,43 @@ public:
    * @return A std::vector<Cell> representing the sequence of cells in the found
    * path. Returns an empty vector if no path is found.
    */
-  virtual std::vector<Cell>
+  std::vector<Cell>
   findPath(const Maze &maze, std::shared_ptr<Cell> start,
            std::shared_ptr<Cell> goal,
-           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr) = 0;
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr) {
+    return findPath(maze, context, start, goal, onVisit);
+  }
+
+  /**
+   * @brief The primary pathfinding method that all concrete classes must
+   * implement. This is a pure virtual function, making PathFinder an abstract
+   * class.
+   *
+   * All per-query state (visited marks, parents, path, statistics) is written
+   * to the given context and neither the maze nor the pathfinder is modified,
+   * so one pathfinder can serve concurrent queries on one maze as long as
+   * each thread passes its own context. The exceptions are the atomic
+   * counters of the last query that some searches keep for their own
+   * figures (such as JPSPathfinder::getJumpPoints()).
+   *
+   * @param maze A reference to the maze grid to be traversed.
+   * @param context The per-query state; begun (and so cleared) by the call.
+   * @param start A smart pointer to the starting cell.
+   * @param goal A smart pointer to the goal cell.
+   * @param onVisit Optional callback function called when a cell is visited.
+   * @return The path, as also stored in the context.
+   */
+  virtual std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const = 0;
 
   /**
    * @brief Initializes the algorithm's state before a run.
    * Resets statistics and any stored path data.
    */
-  virtual void initialize() {
-    stats = {}; // Zero-initialize the stats struct
-    path.clear();
-    // The visited array/state is managed by the Maze/Cell objects,
-    // so we call the maze's reset method.
-  }
+  virtual void initialize() { context.reset(); }
 
   /**
    * @brief Resets the algorithm to its initial state.
@@ -72,18 +91,147 @@ public:
    * @brief Retrieves the performance statistics of the last algorithm run.
    * @return A const PathStats struct containing the collected metrics.
    */
-  virtual PathStats getStats() const { return stats; }
+  virtual PathStats getStats() const { return context.getStats(); }
+
+  /**
+   * @brief Set the movement (4- or 8-connected) of findPath() calls without
+   * an explicit context. Calls that pass a context use its movement.
+   */
+  void setMovement(const Movement &movement) { context.setMovement(movement); }
+
+  /**
+   * @brief Get the context used by findPath() calls without an explicit one,
+   * e.g. to render the last run.
+   */
+  const SearchContext &getContext() const { return context; }
 
 protected:
-  // A vector to store the sequence of cells forming the path.
-  std::vector<Cell> path;
+  /**
+   * @brief Run a SearchEngine with the given open-list policy.
+   *
+   * Begins the context, times the run and rebuilds the path. Without an
+   * onVisit callback the engine is instantiated with NullVisitor, so
+   * headless runs carry no per-expansion callback test.
+   *
+   * @param maze The maze to search.
+   * @param context The per-query state to use.
+   * @param start The starting cell.
+   * @param goal The goal cell.
+   * @param onVisit Optional callback for animation.
+   * @param policy The open-list policy.
+   * @return The path, as also stored in the context.
+   */
+  template <typename Policy>
+  static std::vector<Cell>
+  runEngine(const Maze &maze, SearchContext &context,
+            const std::shared_ptr<Cell> &start,
+            const std::shared_ptr<Cell> &goal,
+            const std::function<void(std::shared_ptr<Cell>)> &onVisit,
+            Policy policy = Policy());
+
+  /**
+   * @brief Rebuild the path by following parent directions from the goal.
+   *
+   * Searches record for each reached cell only the direction back to its
+   * parent, which keeps their memory bounded on very large grids. The path
+   * is stored in the context, its cells are flagged with markPath() and
+   * stats.pathLength and stats.pathCost are set.
+   *
+   * @param maze The maze that was searched.
+   * @param context The context holding the parent directions.
+   * @param start Index of the start cell.
+   * @param goal Index of the goal cell.
+   */
+  static void reconstructPath(const Maze &maze, SearchContext &context,
+                              CellIndex start, CellIndex goal);
+
+  /**
+   * @brief Append the backward half of a bidirectional search to the
+   * forward parents.
+   *
+   * Follows the reverse context's parent directions from a cell the forward
+   * search has reached to the goal, and records each step as a forward
+   * parent. reconstructPath() can then rebuild the whole path from the
+   * context alone.
+   *
+   * @param maze The maze that was searched.
+   * @param context The forward context; its reverse context holds the
+   * backward search rooted at the goal.
+   * @param meeting Index of a cell with a forward parent (or the start) that
+   * the backward search has reached.
+   * @param goal Index of the goal cell.
+   */
+  static void joinReversePath(const Maze &maze, SearchContext &context,
+                              CellIndex meeting, CellIndex goal);
+
+  /**
+   * @brief Reject a query whose movement is not 4-connected, for searches
+   * that only support that.
+   * @param context The context of the query.
+   * @param algorithm Name of the search, for the error message.
+   * @throws std::invalid_argument if the movement is 8-connected.
+   */
+  static void requireFourConnected(const SearchContext &context,
+                                   const char *algorithm);
 
-  // A 2D array to keep track of visited cells. This is managed by the concrete
-  // algorithm.
-  std::vector<std::vector<bool>> visited;
+  /**
+   * @brief Check the context's component labels for a query that cannot
+   * succeed: a 4-connected one between open cells of different regions.
+   * @param maze The maze being searched.
+   * @param context The context of the query (see
+   * SearchContext::setComponents()).
+   * @param start Index of the start cell.
+   * @param goal Index of the goal cell.
+   * @return true if the query has no path; false if it has one, or the
+   * context has no labels, or the movement is 8-connected.
+   * @throws std::invalid_argument if the labels were built for a maze of a
+   * different size.
+   */
+  static bool isUnreachable(const Maze &maze, const SearchContext &context,
+                            CellIndex start, CellIndex goal);
 
-  // Struct to hold performance data.
-  PathStats stats;
+private:
+  // Context for findPath() calls that do not pass their own.
+  SearchContext context;
 };
 
+template <typename Policy>
+std::vector<Cell> PathFinder::runEngine(
+    const Maze &maze, SearchContext &context,
+    const std::shared_ptr<Cell> &start, const std::shared_ptr<Cell> &goal,
+    const std::function<void(std::shared_ptr<Cell>)> &onVisit, Policy policy) {
+  auto startTime = std::chrono::high_resolution_clock::now();
+
+  context.begin(maze);
+  if (!start || !goal) {
+    return context.getPath();
+  }
+
+  const CellIndex startIndex = maze.indexOf(start->getX(), start->getY());
+  const CellIndex goalIndex = maze.indexOf(goal->getX(), goal->getY());
+
+  // Start and goal in different regions need no search
+  bool found;
+  if (isUnreachable(maze, context, startIndex, goalIndex)) {
+    found = false;
+  } else if (onVisit) {
+    SearchEngine<Policy, CellCallbackVisitor> engine(
+        std::move(policy), CellCallbackVisitor(maze, onVisit));
+    found = engine.run(maze, context, startIndex, goalIndex);
+  } else {
+    SearchEngine<Policy> engine(std::move(policy));
+    found = engine.run(maze, context, startIndex, goalIndex);
+  }
+
+  if (found) {
+    reconstructPath(maze, context, startIndex, goalIndex);
+  }
+
+  auto endTime = std::chrono::high_resolution_clock::now();
+  context.getStats().executionTime =
+      std::chrono::duration<double, std::milli>(endTime - startTime);
+
+  return context.getPath();
+}
+
 #endif // PATHFINDER_H
@@ -2,18 +2,38 @@
 #define PATH_STATS_H
 
 #include <chrono>
+#include <cstdint>
 
 /**
- * @brief Enum for representing the four cardinal directions.
- * Used to determine neighbor cells in the maze.
+ * @brief Enum for representing the directions of a step between cells.
+ * Used to determine neighbor cells in the maze. The four cardinal
+ * directions come first; the diagonals are only used by 8-connected
+ * searches (see Movement). Opposite directions are adjacent enumerators.
  */
 enum class Direction {
     UP,
     DOWN,
     LEFT,
-    RIGHT
+    RIGHT,
+    UP_LEFT,
+    DOWN_RIGHT,
+    UP_RIGHT,
+    DOWN_LEFT
 };
 
+/**
+ * @brief Row-major index of a cell (y * width + x).
+ * Always 64 bits wide so that grids of more than 2^32 cells can be addressed.
+ */
+using CellIndex = std::uint64_t;
+
+/**
+ * @brief Accumulated cost of a path (sum of step costs).
+ * 64 bits wide: with cell costs up to 255 and 14 per diagonal step, a path
+ * through a few million cells already exceeds 32 bits.
+ */
+using PathCost = std::uint64_t;
+
 /**
  * @brief A simple struct to hold X, Y coordinates.
  * Includes comparison operators for easy use in data structures.
@@ -37,8 +57,9 @@ struct Coordinate {
  * This allows for easy comparison between different algorithms.
  */
 struct PathStats {
-    int pathLength = 0;
-    int nodesExplored = 0;
+    std::uint64_t pathLength = 0;
+    std::uint64_t pathCost = 0; // Sum of the step costs (see Movement)
+    std::uint64_t nodesExplored = 0;
     std::chrono::duration<double, std::milli> executionTime{0};
 };
 
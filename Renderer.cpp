@@ -198,7 +198,24 @@ void Renderer::moveCursor(int x, int y) {
 // CHARACTER AND COLOR HELPERS
 // ============================================================================
 
-char Renderer::getCellChar(std::shared_ptr<Cell> cell, const Maze &maze) const {
+bool Renderer::isVisitedCell(const Cell &cell, const Maze &maze,
+                             const SearchContext *search) const {
+  if (!search)
+    return cell.isVisited();
+  const CellIndex index = maze.indexOf(cell.getX(), cell.getY());
+  return index < search->getCellCount() && search->isVisited(index);
+}
+
+bool Renderer::isPathCell(const Cell &cell, const Maze &maze,
+                          const SearchContext *search) const {
+  if (!search)
+    return cell.isPath();
+  const CellIndex index = maze.indexOf(cell.getX(), cell.getY());
+  return index < search->getCellCount() && search->isPath(index);
+}
+
+char Renderer::getCellChar(std::shared_ptr<Cell> cell, const Maze &maze,
+                           const SearchContext *search) const {
   // Check if it's start or goal
   if (maze.getStart() && *cell == *maze.getStart())
     return 'S';
@@ -217,16 +234,16 @@ char Renderer::getCellChar(std::shared_ptr<Cell> cell, const Maze &maze) const {
     }
   }
 
-  if (cell->isPath())
+  if (isPathCell(*cell, maze, search))
     return '*';
-  if (cell->isVisited())
+  if (isVisitedCell(*cell, maze, search))
     return '.';
 
   return ' '; // Empty cell
 }
 
-Color Renderer::getCellColor(std::shared_ptr<Cell> cell,
-                             const Maze &maze) const {
+Color Renderer::getCellColor(std::shared_ptr<Cell> cell, const Maze &maze,
+                             const SearchContext *search) const {
   // Check if it's start or goal
   if (maze.getStart() && *cell == *maze.getStart())
     return Color::BRIGHT_CYAN;
@@ -236,9 +253,9 @@ Color Renderer::getCellColor(std::shared_ptr<Cell> cell,
   // Check cell state
   if (cell->isWall())
     return Color::WHITE;
-  if (cell->isPath())
+  if (isPathCell(*cell, maze, search))
     return Color::BRIGHT_GREEN;
-  if (cell->isVisited())
+  if (isVisitedCell(*cell, maze, search))
     return Color::BLUE;
 
   return Color::RESET;
@@ -248,15 +265,21 @@ Color Renderer::getCellColor(std::shared_ptr<Cell> cell,
 // CORE RENDERING
 // ============================================================================
 
-void Renderer::drawMaze(const Maze &maze) {
+void Renderer::drawMaze(const Maze &maze) { drawCells(maze, nullptr); }
+
+void Renderer::drawMaze(const Maze &maze, const SearchContext &context) {
+  drawCells(maze, &context);
+}
+
+void Renderer::drawCells(const Maze &maze, const SearchContext *search) {
   clearScreen();
 
   for (int y = 0; y < maze.getHeight(); ++y) {
     for (int x = 0; x < maze.getWidth(); ++x) {
       auto cell = maze.getCell(x, y);
 
-      setColor(getCellColor(cell, maze));
-      std::cout << getCellChar(cell, maze);
+      setColor(getCellColor(cell, maze, search));
+      std::cout << getCellChar(cell, maze, search);
     }
     std::cout << std::endl;
   }
@@ -278,7 +301,8 @@ void Renderer::drawPath(const std::vector<std::shared_ptr<Cell>> &path) {
 // ANIMATION
 // ============================================================================
 
-void Renderer::animateStep(const Maze &maze, std::shared_ptr<Cell> current) {
+void Renderer::animateStep(const Maze &maze, const SearchContext &context,
+                           std::shared_ptr<Cell> current) {
   if (paused || animationDelay == 0)
     return;
 
@@ -294,8 +318,8 @@ void Renderer::animateStep(const Maze &maze, std::shared_ptr<Cell> current) {
         setColor(Color::BRIGHT_YELLOW);
         std::cout << '@';
       } else {
-        setColor(getCellColor(cell, maze));
-        std::cout << getCellChar(cell, maze);
+        setColor(getCellColor(cell, maze, &context));
+        std::cout << getCellChar(cell, maze, &context);
       }
     }
     std::cout << std::endl;
@@ -337,8 +361,8 @@ void Renderer::setShowLegend(bool show) { showLegend = show; }
 // STATISTICS AND LEGEND
 // ============================================================================
 
-void Renderer::displayStats(int nodesExplored, int pathLength,
-                            double timeElapsed) {
+void Renderer::displayStats(std::uint64_t nodesExplored,
+                            std::uint64_t pathLength, double timeElapsed) {
   if (!showStats)
     return;
 
@@ -402,7 +426,7 @@ void Renderer::bufferFrame(const Maze &maze) {
   for (int y = 0; y < maze.getHeight(); ++y) {
     for (int x = 0; x < maze.getWidth(); ++x) {
       auto cell = maze.getCell(x, y);
-      buffer << getCellChar(cell, maze);
+      buffer << getCellChar(cell, maze, nullptr);
     }
     buffer << '\n';
   }
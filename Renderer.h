@@ -3,6 +3,8 @@
 
 #include "Cell.h"
 #include "Maze.h"
+#include "SearchContext.h"
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -71,6 +73,13 @@ public:
    */
   void drawMaze(const Maze &maze);
 
+  /**
+   * @brief Draw the maze with the visited cells and path of a search
+   * @param maze The maze to render
+   * @param context The search state to show
+   */
+  void drawMaze(const Maze &maze, const SearchContext &context);
+
   /**
    * @brief Draw the final path
    * @param path Vector of cells representing the path
@@ -88,10 +97,12 @@ public:
 
   /**
    * @brief Animate a single step of the algorithm
-   * @param maze The current maze state
+   * @param maze The maze being searched
+   * @param context The state of the running search
    * @param current The cell being explored
    */
-  void animateStep(const Maze &maze, std::shared_ptr<Cell> current);
+  void animateStep(const Maze &maze, const SearchContext &context,
+                   std::shared_ptr<Cell> current);
 
   /**
    * @brief Set animation speed
@@ -152,7 +163,8 @@ public:
    * @param pathLength Length of the path
    * @param timeElapsed Time elapsed in milliseconds
    */
-  void displayStats(int nodesExplored, int pathLength, double timeElapsed);
+  void displayStats(std::uint64_t nodesExplored, std::uint64_t pathLength,
+                    double timeElapsed);
 
 private:
   // ========================================================================
@@ -178,17 +190,39 @@ private:
    * @brief Get the character for a cell
    * @param cell The cell to get character for
    * @param maze The maze (for context)
+   * @param search Search state to show, or nullptr to use the cell's flags
    * @return char The character to display
    */
-  char getCellChar(std::shared_ptr<Cell> cell, const Maze &maze) const;
+  char getCellChar(std::shared_ptr<Cell> cell, const Maze &maze,
+                   const SearchContext *search) const;
 
   /**
    * @brief Get the color for a cell
    * @param cell The cell to get color for
    * @param maze The maze (for context)
+   * @param search Search state to show, or nullptr to use the cell's flags
    * @return Color The color to use
    */
-  Color getCellColor(std::shared_ptr<Cell> cell, const Maze &maze) const;
+  Color getCellColor(std::shared_ptr<Cell> cell, const Maze &maze,
+                     const SearchContext *search) const;
+
+  /**
+   * @brief Check whether a cell is shown as visited / on the path
+   * @param cell The cell to check
+   * @param maze The maze (for context)
+   * @param search Search state to read, or nullptr to use the cell's flags
+   */
+  bool isVisitedCell(const Cell &cell, const Maze &maze,
+                     const SearchContext *search) const;
+  bool isPathCell(const Cell &cell, const Maze &maze,
+                  const SearchContext *search) const;
+
+  /**
+   * @brief Draw every cell of the maze
+   * @param maze The maze to render
+   * @param search Search state to show, or nullptr to use the cell's flags
+   */
+  void drawCells(const Maze &maze, const SearchContext *search);
 
   /**
    * @brief Move cursor to specific position
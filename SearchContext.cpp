@@ -0,0 +1,44 @@
+#include "SearchContext.h"
+
+#include "Maze.h"
+#include <algorithm>
+
+SearchContext::SearchContext() : generation(0), currentTag(0) {}
+
+void SearchContext::begin(const Maze &maze) {
+  const std::size_t cellCount = static_cast<std::size_t>(maze.getCellCount());
+  if (marks.size() != cellCount) {
+    marks.assign(cellCount, 0);
+    std::vector<PathCost>().swap(costs);
+    generation = 0;
+  }
+  reset();
+}
+
+void SearchContext::reset() {
+  path.clear();
+  stats = {};
+
+  // Generation 0 is what cleared marks hold, so it is never current
+  if (generation == MAX_GENERATION) {
+    std::fill(marks.begin(), marks.end(), 0);
+    generation = 0;
+  }
+  ++generation;
+  currentTag = static_cast<std::uint16_t>(generation << GENERATION_SHIFT);
+}
+
+void SearchContext::reserveCosts() {
+  // Entries are only read for cells visited in the current query, so stale
+  // values never need clearing
+  if (costs.size() != marks.size()) {
+    costs.resize(marks.size());
+  }
+}
+
+SearchContext &SearchContext::getReverse() {
+  if (!reverse) {
+    reverse = std::make_unique<SearchContext>();
+  }
+  return *reverse;
+}
@@ -0,0 +1,244 @@
+#ifndef SEARCH_CONTEXT_H
+#define SEARCH_CONTEXT_H
+
+#include "Cell.h"
+#include "Maze.h"
+#include "PathStats.h"
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class ComponentIndex;
+
+/**
+ * @brief Per-query search state.
+ *
+ * A SearchContext owns everything a search writes: which cells were visited,
+ * the direction from each visited cell back to its parent, which cells lie on
+ * the found path, the cost of reaching each cell (for weighted searches), the
+ * path itself and the run's statistics. Searches only read the Maze, so any
+ * number of threads can search the same const Maze at once as long as each
+ * thread uses its own context.
+ *
+ * Each cell has a 16-bit mark: a 10-bit generation number, a closed bit, a
+ * path bit and a 4-bit parent direction. A mark only counts if its
+ * generation is the current one, so starting a new query just bumps the
+ * generation and is O(1). The marks are cleared only when the generation
+ * wraps (every 1023 queries) or when the context is used with a maze of a
+ * different size.
+ *
+ * The context also holds the query's Movement (4- or 8-connected) and an
+ * optional ComponentIndex, which are kept across queries until changed.
+ *
+ * The per-cell tables are dense arrays indexed by CellIndex and are kept
+ * between queries, so a context that is reused allocates nothing per search.
+ */
+class SearchContext {
+public:
+  /**
+   * @brief Parent direction reported for cells that were not visited.
+   */
+  static constexpr std::uint8_t NO_PARENT = 0xFF;
+
+  /**
+   * @brief Parent direction stored for a search root, which is visited but
+   * has no parent.
+   */
+  static constexpr std::uint8_t ROOT_PARENT = 8;
+
+  /**
+   * @brief Get the parent direction to store for a cell reached by a step.
+   * @param step The direction of the step from the parent to the cell.
+   * @return The opposite Direction, i.e. from the cell back to its parent.
+   */
+  static std::uint8_t oppositeDirection(Direction step) {
+    // Opposite directions (e.g. UP/DOWN, UP_LEFT/DOWN_RIGHT) are adjacent
+    // enumerators
+    return static_cast<std::uint8_t>(static_cast<unsigned>(step) ^ 1u);
+  }
+
+  /**
+   * @brief Construct an empty context; it is sized by the first begin().
+   */
+  SearchContext();
+
+  /**
+   * @brief Start a new query on a maze.
+   * Forgets the marks, path and statistics of the previous query.
+   * @param maze The maze that will be searched.
+   */
+  void begin(const Maze &maze);
+
+  /**
+   * @brief Forget the results of the previous query without resizing.
+   */
+  void reset();
+
+  /**
+   * @brief Set how searches using this context move between cells.
+   * Searches that only support 4-connected movement (jump point search and
+   * the bidirectional searches) throw std::invalid_argument otherwise.
+   */
+  void setMovement(const Movement &newMovement) { movement = newMovement; }
+
+  /**
+   * @brief Get how searches using this context move between cells
+   * (4-connected by default).
+   */
+  const Movement &getMovement() const { return movement; }
+
+  /**
+   * @brief Set the component labels of the mazes searched with this
+   * context, or nullptr for none. 4-connected searches then return no path
+   * at once when the start and goal are open cells in different regions.
+   * The index must be kept up to date (ComponentIndex::update()) as walls
+   * change.
+   */
+  void setComponents(std::shared_ptr<const ComponentIndex> index) {
+    components = std::move(index);
+  }
+
+  /**
+   * @brief Get the component labels set with setComponents(), or nullptr.
+   */
+  const ComponentIndex *getComponents() const { return components.get(); }
+
+  /**
+   * @brief Check whether a cell was visited in the current query.
+   * @param index The cell index (must be a cell of the maze given to begin()).
+   */
+  bool isVisited(CellIndex index) const {
+    return (marks[index] & GENERATION_MASK) == currentTag;
+  }
+
+  /**
+   * @brief Mark a cell as visited in the current query.
+   * @param index The cell index.
+   * @param parentDirection Direction from the cell back to its parent, or
+   * ROOT_PARENT.
+   */
+  void markVisited(CellIndex index, std::uint8_t parentDirection) {
+    marks[index] = static_cast<std::uint16_t>(currentTag | parentDirection);
+  }
+
+  /**
+   * @brief Get the direction from a visited cell back to its parent.
+   * @param index The cell index.
+   * @return The Direction, ROOT_PARENT, or NO_PARENT if not visited.
+   */
+  std::uint8_t getParentDirection(CellIndex index) const {
+    return isVisited(index)
+               ? static_cast<std::uint8_t>(marks[index] & PARENT_MASK)
+               : NO_PARENT;
+  }
+
+  /**
+   * @brief Check whether a cell is on the path found by the current query.
+   * @param index The cell index.
+   */
+  bool isPath(CellIndex index) const {
+    return isVisited(index) && (marks[index] & PATH_BIT);
+  }
+
+  /**
+   * @brief Flag a visited cell as part of the found path.
+   * @param index The cell index (must be visited in the current query).
+   */
+  void markPath(CellIndex index) { marks[index] |= PATH_BIT; }
+
+  /**
+   * @brief Check whether a cell was closed (settled) in the current query.
+   * @param index The cell index.
+   */
+  bool isClosed(CellIndex index) const {
+    return isVisited(index) && (marks[index] & CLOSED_BIT);
+  }
+
+  /**
+   * @brief Flag a visited cell as closed, for searches that keep a closed
+   * set. The flag is cleared if the cell is marked visited again.
+   * @param index The cell index (must be visited in the current query).
+   */
+  void markClosed(CellIndex index) { marks[index] |= CLOSED_BIT; }
+
+  /**
+   * @brief Allocate the cost table for the current maze.
+   * Only searches that call relax() need it (8 bytes per cell); it is kept
+   * across queries like the marks.
+   */
+  void reserveCosts();
+
+  /**
+   * @brief Record a path to a cell if it is the cheapest found so far.
+   *
+   * A cell not yet visited in this query is marked visited with the given
+   * parent; a visited cell is only updated if the new cost is lower.
+   * Requires reserveCosts().
+   *
+   * @param index The cell index.
+   * @param cost The cost of reaching the cell along the new path.
+   * @param parentDirection Direction from the cell back to its parent on the
+   * new path, or ROOT_PARENT.
+   * @return true if the cell's cost and parent were updated.
+   */
+  bool relax(CellIndex index, PathCost cost, std::uint8_t parentDirection) {
+    if (isVisited(index) && costs[index] <= cost)
+      return false;
+    markVisited(index, parentDirection);
+    costs[index] = cost;
+    return true;
+  }
+
+  /**
+   * @brief Get the cheapest known cost of reaching a cell.
+   * @param index The cell index (must have been relaxed in this query).
+   */
+  PathCost getCost(CellIndex index) const { return costs[index]; }
+
+  /**
+   * @brief Get the number of cells the context is sized for.
+   */
+  CellIndex getCellCount() const { return marks.size(); }
+
+  /**
+   * @brief Get the path found by the current query (empty if none).
+   */
+  const std::vector<Cell> &getPath() const { return path; }
+  std::vector<Cell> &getPath() { return path; }
+
+  /**
+   * @brief Get the statistics of the current query.
+   */
+  const PathStats &getStats() const { return stats; }
+  PathStats &getStats() { return stats; }
+
+  /**
+   * @brief Get the context for the backward half of a bidirectional search.
+   *
+   * The reverse context is a second, independent set of marks and costs,
+   * created on first use and kept like the other tables. It is not begun
+   * with this context; the search begins it itself.
+   */
+  SearchContext &getReverse();
+
+private:
+  static constexpr int GENERATION_SHIFT = 6;
+  static constexpr std::uint16_t GENERATION_MASK = 0xFFC0;
+  static constexpr std::uint16_t CLOSED_BIT = 1 << 5;
+  static constexpr std::uint16_t PATH_BIT = 1 << 4;
+  static constexpr std::uint16_t PARENT_MASK = 0xF;
+  static constexpr std::uint16_t MAX_GENERATION = 0x03FF;
+
+  std::vector<std::uint16_t> marks; // Generation-stamped per-cell marks
+  std::vector<PathCost> costs;      // Valid for cells visited this query
+  std::uint16_t generation;         // Current generation, never 0
+  std::uint16_t currentTag;         // generation << GENERATION_SHIFT
+  std::vector<Cell> path;
+  PathStats stats;
+  Movement movement;
+  std::shared_ptr<const ComponentIndex> components; // Region labels, if set
+  std::unique_ptr<SearchContext> reverse; // Backward search, if ever used
+};
+
+#endif // SEARCH_CONTEXT_H
@@ -0,0 +1,476 @@
+#ifndef SEARCH_ENGINE_H
+#define SEARCH_ENGINE_H
+
+#include "Maze.h"
+#include "SearchContext.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stack>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Visitor that does nothing (headless searches).
+ */
+struct NullVisitor {
+  void operator()(CellIndex) const {}
+};
+
+/**
+ * @brief Visitor that forwards expanded cells to a PathFinder onVisit
+ * callback as Cell handles.
+ */
+class CellCallbackVisitor {
+public:
+  CellCallbackVisitor(const Maze &maze,
+                      const std::function<void(std::shared_ptr<Cell>)> &onVisit)
+      : maze(maze), onVisit(onVisit) {}
+
+  void operator()(CellIndex index) const {
+    const Coordinate coords = maze.coordsOf(index);
+    onVisit(maze.getCell(coords.x, coords.y));
+  }
+
+private:
+  const Maze &maze;
+  const std::function<void(std::shared_ptr<Cell>)> &onVisit;
+};
+
+/**
+ * @brief FIFO open list: cells are marked when discovered (BFS).
+ */
+class QueuePolicy {
+public:
+  void seed(const Maze &, SearchContext &context, CellIndex start, CellIndex) {
+    context.markVisited(start, SearchContext::ROOT_PARENT);
+    open.push(start);
+  }
+
+  bool empty() const { return open.empty(); }
+
+  bool pop(const Maze &, SearchContext &, CellIndex &cell) {
+    cell = open.front();
+    open.pop();
+    return true;
+  }
+
+  void discover(SearchContext &context, CellIndex neighbor, Direction step) {
+    if (!context.isVisited(neighbor)) {
+      context.markVisited(neighbor, SearchContext::oppositeDirection(step));
+      open.push(neighbor);
+    }
+  }
+
+private:
+  std::queue<CellIndex> open;
+};
+
+/**
+ * @brief LIFO open list: cells are marked when discovered (DFS).
+ * Vector-backed, so it only allocates when it grows.
+ */
+class StackPolicy {
+public:
+  void seed(const Maze &, SearchContext &context, CellIndex start, CellIndex) {
+    context.markVisited(start, SearchContext::ROOT_PARENT);
+    open.push(start);
+  }
+
+  bool empty() const { return open.empty(); }
+
+  bool pop(const Maze &, SearchContext &, CellIndex &cell) {
+    cell = open.top();
+    open.pop();
+    return true;
+  }
+
+  void discover(SearchContext &context, CellIndex neighbor, Direction step) {
+    if (!context.isVisited(neighbor)) {
+      context.markVisited(neighbor, SearchContext::oppositeDirection(step));
+      open.push(neighbor);
+    }
+  }
+
+private:
+  std::stack<CellIndex, std::vector<CellIndex>> open;
+};
+
+/**
+ * @brief Heuristic for HeapPolicy that always returns 0 (Dijkstra).
+ */
+struct ZeroHeuristic {
+  PathCost operator()(Coordinate, Coordinate) const { return 0; }
+};
+
+/**
+ * @brief Binary-heap open list ordered by f = g + h (Dijkstra, A*).
+ *
+ * The best known g-score and parent of each cell are kept in the context's
+ * dense tables; a cell is queued again only when its g-score improves and
+ * the outdated entry is skipped when popped. With a consistent heuristic a
+ * cell's g-score is final when it is first expanded. Ties on f are broken
+ * towards the larger g, i.e. the node closer to the goal.
+ *
+ * A move costs its Movement::stepCost() times the terrain cost of the cell
+ * entered (Maze::getCost()), summed in integer PathCost.
+ *
+ * @tparam Heuristic Callable as PathCost(Coordinate cell, Coordinate goal).
+ */
+template <typename Heuristic> class HeapPolicy {
+public:
+  explicit HeapPolicy(Heuristic heuristic = Heuristic())
+      : heuristic(heuristic) {}
+
+  void seed(const Maze &maze, SearchContext &context, CellIndex start,
+            CellIndex goal) {
+    goalCoords = maze.coordsOf(goal);
+    costs = maze.getCostPlane();
+    for (int d = 0; d < 8; ++d)
+      stepCosts[d] = context.getMovement().stepCost(static_cast<Direction>(d));
+    context.reserveCosts();
+    context.relax(start, 0, SearchContext::ROOT_PARENT);
+    open.push({start, estimate(maze.coordsOf(start)), 0});
+  }
+
+  bool empty() const { return open.empty(); }
+
+  bool pop(const Maze &maze, SearchContext &context, CellIndex &cell) {
+    const Node node = open.top();
+    open.pop();
+
+    // Skip outdated entries (the cell was reached more cheaply since)
+    if (node.gScore > context.getCost(node.index))
+      return false;
+
+    cell = node.index;
+    currentG = node.gScore;
+    if constexpr (INFORMED)
+      currentCoords = maze.coordsOf(cell);
+    return true;
+  }
+
+  void discover(SearchContext &context, CellIndex neighbor, Direction step) {
+    // A move costs its step cost times the terrain cost of the cell entered
+    const int d = static_cast<int>(step);
+    const PathCost g =
+        currentG + stepCosts[d] * (costs ? costs[neighbor] : PathCost{1});
+    if (context.relax(neighbor, g, SearchContext::oppositeDirection(step))) {
+      PathCost h = 0;
+      if constexpr (INFORMED)
+        h = estimate({currentCoords.x + DX[d], currentCoords.y + DY[d]});
+      open.push({neighbor, g + h, g});
+    }
+  }
+
+private:
+  // Whether there is a heuristic to evaluate (i.e. A* rather than Dijkstra)
+  static constexpr bool INFORMED =
+      !std::is_same<Heuristic, ZeroHeuristic>::value;
+  // Offsets of the steps, in Direction order
+  static constexpr int DX[] = {0, 0, -1, 1, -1, 1, 1, -1};
+  static constexpr int DY[] = {-1, 1, 0, 0, -1, 1, -1, 1};
+
+  struct Node {
+    CellIndex index;
+    PathCost fScore; // f = g + h
+    PathCost gScore; // Cost from start when the node was queued
+
+    bool operator>(const Node &other) const {
+      // Without a heuristic f == g, so there is nothing to break ties on
+      if constexpr (INFORMED)
+        return fScore > other.fScore ||
+               (fScore == other.fScore && gScore < other.gScore);
+      return fScore > other.fScore;
+    }
+  };
+
+  PathCost estimate(Coordinate cell) const {
+    return heuristic(cell, goalCoords);
+  }
+
+  Heuristic heuristic;
+  std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
+  const std::uint8_t *costs = nullptr; // Maze cost plane, or nullptr
+  PathCost stepCosts[8] = {};          // Movement::stepCost() per Direction
+  Coordinate goalCoords;
+  Coordinate currentCoords; // Cell being expanded (if INFORMED)
+  PathCost currentG = 0;    // g-score of the cell being expanded
+};
+
+/**
+ * @brief Bucket-queue open list (Dial's algorithm) ordered by f = g + h
+ * (Dijkstra, A*).
+ *
+ * A move costs at most its step cost times Maze::getMaxCost(), and the
+ * heuristic changes by at most the step cost times Maze::getMinCost(), so a
+ * discovered cell's f exceeds the expanded cell's f by at most the sum,
+ * and f never decreases. Queued cells therefore fall into a small window
+ * of f values, kept in a ring of buckets indexed by f (4 buckets for a
+ * 4-connected search without terrain costs). Push
+ * and pop are O(1), with integer keys only. Within a bucket the last cell
+ * queued is expanded first. For A* that is the cell with the larger g, the
+ * same tie-break as HeapPolicy.
+ *
+ * Costs and outdated entries are handled as in HeapPolicy.
+ *
+ * @tparam Heuristic Callable as PathCost(Coordinate cell, Coordinate goal);
+ * must be consistent and change by at most Maze::getMinCost() times the
+ * step cost (Movement::stepCost()) between adjacent cells.
+ */
+template <typename Heuristic> class BucketPolicy {
+public:
+  explicit BucketPolicy(Heuristic heuristic = Heuristic())
+      : heuristic(heuristic) {}
+
+  void seed(const Maze &maze, SearchContext &context, CellIndex start,
+            CellIndex goal) {
+    goalCoords = maze.coordsOf(goal);
+    costs = maze.getCostPlane();
+    for (int d = 0; d < 8; ++d)
+      stepCosts[d] = context.getMovement().stepCost(static_cast<Direction>(d));
+    context.reserveCosts();
+    context.relax(start, 0, SearchContext::ROOT_PARENT);
+
+    // Enough buckets for the widest step in f, rounded up to a power of two
+    const PathCost longest = stepCosts[static_cast<int>(Direction::UP_LEFT)];
+    const PathCost step =
+        longest * (PathCost{maze.getMaxCost()} +
+                   (INFORMED ? PathCost{maze.getMinCost()} : 0));
+    PathCost count = 2;
+    while (count <= step)
+      count *= 2;
+    buckets.resize(count);
+    bucketMask = count - 1;
+
+    currentF = estimate(maze.coordsOf(start));
+    push(start, currentF, 0);
+  }
+
+  bool empty() const { return queued == 0; }
+
+  bool pop(const Maze &maze, SearchContext &context, CellIndex &cell) {
+    std::vector<Entry> *bucket = &buckets[currentF & bucketMask];
+    while (bucket->empty()) {
+      bucket = &buckets[++currentF & bucketMask];
+    }
+    const Entry entry = bucket->back();
+    bucket->pop_back();
+    --queued;
+
+    // Skip outdated entries (the cell was reached more cheaply since)
+    if (entry.gScore > context.getCost(entry.index))
+      return false;
+
+    cell = entry.index;
+    currentG = entry.gScore;
+    if constexpr (INFORMED)
+      currentCoords = maze.coordsOf(cell);
+    return true;
+  }
+
+  void discover(SearchContext &context, CellIndex neighbor, Direction step) {
+    // A move costs its step cost times the terrain cost of the cell entered
+    const int d = static_cast<int>(step);
+    const PathCost g =
+        currentG + stepCosts[d] * (costs ? costs[neighbor] : PathCost{1});
+    if (context.relax(neighbor, g, SearchContext::oppositeDirection(step))) {
+      PathCost h = 0;
+      if constexpr (INFORMED)
+        h = estimate({currentCoords.x + DX[d], currentCoords.y + DY[d]});
+      push(neighbor, g + h, g);
+    }
+  }
+
+private:
+  static constexpr bool INFORMED =
+      !std::is_same<Heuristic, ZeroHeuristic>::value;
+  // Offsets of the steps, in Direction order
+  static constexpr int DX[] = {0, 0, -1, 1, -1, 1, 1, -1};
+  static constexpr int DY[] = {-1, 1, 0, 0, -1, 1, -1, 1};
+
+  struct Entry {
+    CellIndex index;
+    PathCost gScore; // Cost from start when the cell was queued
+  };
+
+  void push(CellIndex index, PathCost fScore, PathCost gScore) {
+    buckets[fScore & bucketMask].push_back({index, gScore});
+    ++queued;
+  }
+
+  PathCost estimate(Coordinate cell) const {
+    return heuristic(cell, goalCoords);
+  }
+
+  Heuristic heuristic;
+  std::vector<std::vector<Entry>> buckets; // Ring indexed by f & bucketMask
+  PathCost bucketMask = 0;
+  std::size_t queued = 0; // Entries in all buckets
+  PathCost currentF = 0;  // f of the bucket being drained
+  const std::uint8_t *costs = nullptr; // Maze cost plane, or nullptr
+  PathCost stepCosts[8] = {};          // Movement::stepCost() per Direction
+  Coordinate goalCoords;
+  Coordinate currentCoords; // Cell being expanded (if INFORMED)
+  PathCost currentG = 0;    // g-score of the cell being expanded
+};
+
+/**
+ * @brief Open list used by the pathfinders that can use either
+ * (Dijkstra, A*).
+ */
+enum class OpenList {
+  BINARY_HEAP, // HeapPolicy: std::priority_queue
+  BUCKETS      // BucketPolicy: Dial's bucket queue, O(1) push and pop
+};
+
+/**
+ * @brief Detects whether an open-list Policy generates successors itself,
+ * through expand(const Maze &, SearchContext &, CellIndex).
+ */
+template <typename Policy, typename = void>
+struct PolicyExpands : std::false_type {};
+
+template <typename Policy>
+struct PolicyExpands<
+    Policy, std::void_t<decltype(std::declval<Policy &>().expand(
+                std::declval<const Maze &>(), std::declval<SearchContext &>(),
+                CellIndex{}))>> : std::true_type {};
+
+/**
+ * @brief Detects whether an open-list Policy has a
+ * finish(const Maze &, SearchContext &, CellIndex start, CellIndex goal) step.
+ */
+template <typename Policy, typename = void>
+struct PolicyFinishes : std::false_type {};
+
+template <typename Policy>
+struct PolicyFinishes<
+    Policy, std::void_t<decltype(std::declval<Policy &>().finish(
+                std::declval<const Maze &>(), std::declval<SearchContext &>(),
+                CellIndex{}, CellIndex{}))>> : std::true_type {};
+
+/**
+ * @brief Statically dispatched best-first search over a Maze.
+ *
+ * SearchEngine runs the expansion loop shared by all grid searches; what
+ * differs between them is supplied as compile-time parameters:
+ *
+ * - The open-list Policy decides which cell is expanded next and how a
+ *   newly seen neighbor is recorded (QueuePolicy for BFS, StackPolicy for
+ *   DFS, HeapPolicy or BucketPolicy for Dijkstra and A*). A policy
+ *   provides:
+ *   @code
+ *   void seed(const Maze &, SearchContext &, CellIndex start, CellIndex goal);
+ *   bool empty() const;
+ *   // Pop the next cell; false if the entry is outdated and must be skipped
+ *   bool pop(const Maze &, SearchContext &, CellIndex &cell);
+ *   void discover(SearchContext &, CellIndex neighbor, Direction step);
+ *   @endcode
+ *   A policy that does not step to adjacent cells (e.g. jump point search)
+ *   provides expand() instead of discover(), and may provide finish(), which
+ *   runs once the goal is reached, before the path is rebuilt:
+ *   @code
+ *   void expand(const Maze &, SearchContext &, CellIndex cell);
+ *   void finish(const Maze &, SearchContext &, CellIndex start,
+ *               CellIndex goal);
+ *   @endcode
+ * - The Visitor is called with the index of every expanded cell. The default
+ *   NullVisitor does nothing, so a headless search compiles down to the bare
+ *   loop with no callback test.
+ *
+ * Nothing is virtual and nothing is allocated per expansion; all calls are
+ * resolved (and normally inlined) at compile time.
+ */
+template <typename Policy, typename Visitor = NullVisitor>
+class SearchEngine {
+public:
+  explicit SearchEngine(Policy policy = Policy(), Visitor visitor = Visitor())
+      : policy(std::move(policy)), visitor(std::move(visitor)) {}
+
+  /**
+   * @brief Search from start until the goal is expanded or the open list is
+   * exhausted.
+   *
+   * Visited marks, parent directions and stats.nodesExplored are written to
+   * the context, which must have been begun for this maze. Cells step to
+   * the neighbors allowed by the context's Movement.
+   *
+   * @return true if the goal was reached.
+   */
+  bool run(const Maze &maze, SearchContext &context, CellIndex start,
+           CellIndex goal) {
+    PathStats &stats = context.getStats();
+    const Movement movement = context.getMovement();
+    policy.seed(maze, context, start, goal);
+
+    while (!policy.empty()) {
+      CellIndex current;
+      if (!policy.pop(maze, context, current))
+        continue;
+
+      stats.nodesExplored++;
+      visitor(current);
+
+      if (current == goal) {
+        if constexpr (PolicyFinishes<Policy>::value)
+          policy.finish(maze, context, start, goal);
+        return true;
+      }
+
+      if constexpr (PolicyExpands<Policy>::value) {
+        policy.expand(maze, context, current);
+      } else {
+        maze.forEachNeighbor(current, movement,
+                             [&](CellIndex neighbor, Direction step) {
+                               policy.discover(context, neighbor, step);
+                             });
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Search from start, with no single goal, until stop() asks to
+   * end or the open list is exhausted (one-to-many queries).
+   *
+   * Like run(), but stop(cell) is called with every expanded cell and the
+   * search ends when it returns true. The policy is seeded with the start
+   * as its goal, so only uninformed policies are meaningful here.
+   */
+  template <typename Stop>
+  void sweep(const Maze &maze, SearchContext &context, CellIndex start,
+             Stop &&stop) {
+    PathStats &stats = context.getStats();
+    const Movement movement = context.getMovement();
+    policy.seed(maze, context, start, start);
+
+    while (!policy.empty()) {
+      CellIndex current;
+      if (!policy.pop(maze, context, current))
+        continue;
+
+      stats.nodesExplored++;
+      visitor(current);
+      if (stop(current))
+        return;
+
+      if constexpr (PolicyExpands<Policy>::value) {
+        policy.expand(maze, context, current);
+      } else {
+        maze.forEachNeighbor(current, movement,
+                             [&](CellIndex neighbor, Direction step) {
+                               policy.discover(context, neighbor, step);
+                             });
+      }
+    }
+  }
+
+private:
+  Policy policy;
+  Visitor visitor;
+};
+
+#endif // SEARCH_ENGINE_H
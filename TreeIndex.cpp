@@ -0,0 +1,130 @@
+#include "TreeIndex.h"
+
+#include "SearchContext.h"
+#include <utility>
+
+TreeIndex::TreeIndex() : width(0), height(0), tree(false), walls{0, 0} {}
+
+TreeIndex::TreeIndex(const Maze &maze) : TreeIndex() { build(maze); }
+
+void TreeIndex::build(const Maze &maze) {
+  const std::size_t cellCount = static_cast<std::size_t>(maze.getCellCount());
+  const std::uint8_t *costs = maze.getCostPlane();
+  std::vector<std::uint8_t> parentSteps(cellCount, NO_PARENT);
+  std::vector<std::uint32_t> depth(cellCount, 0);
+  std::vector<CellIndex> jump(cellCount, NO_CELL);
+  std::vector<PathCost> cost(costs ? cellCount : 0, 0);
+
+  // Breadth-first from the first cell of each region, so that a cell's
+  // parent (and the parent's jump) is set before the cell. In a tree the
+  // only neighbor already reached is the parent; any other closes a cycle.
+  bool acyclic = true;
+  std::vector<CellIndex> queue;
+  for (CellIndex root = 0; acyclic && root < cellCount; ++root) {
+    const Coordinate coords = maze.coordsOf(root);
+    if (parentSteps[root] != NO_PARENT || maze.isWall(coords.x, coords.y))
+      continue;
+    parentSteps[root] = ROOT;
+    jump[root] = root;
+    queue.assign(1, root);
+    for (std::size_t head = 0; acyclic && head < queue.size(); ++head) {
+      const CellIndex cell = queue[head];
+      const CellIndex up = jump[cell];
+      // Jump past the parent's jump if it is as long as the one after it
+      const CellIndex skip =
+          depth[cell] - depth[up] == depth[up] - depth[jump[up]] ? jump[up]
+                                                                 : cell;
+      maze.forEachNeighbor(cell, [&](CellIndex neighbor, Direction dir) {
+        if (parentSteps[neighbor] == NO_PARENT) {
+          parentSteps[neighbor] = SearchContext::oppositeDirection(dir);
+          depth[neighbor] = depth[cell] + 1;
+          jump[neighbor] = skip;
+          if (costs)
+            cost[neighbor] = cost[cell] + costs[neighbor];
+          queue.push_back(neighbor);
+        } else if (parentSteps[cell] == ROOT ||
+                   neighbor != maze.neighborIndex(
+                                   cell, static_cast<Direction>(
+                                             parentSteps[cell]))) {
+          acyclic = false;
+        }
+      });
+    }
+  }
+
+  width = maze.getWidth();
+  height = maze.getHeight();
+  tree = acyclic;
+  walls = maze.getWallVersion();
+  if (acyclic) {
+    parents.swap(parentSteps);
+    depths.swap(depth);
+    jumps.swap(jump);
+    rootCosts.swap(cost);
+    if (costs)
+      cellCosts.assign(costs, costs + cellCount);
+    else
+      std::vector<std::uint8_t>().swap(cellCosts);
+  } else {
+    std::vector<std::uint8_t>().swap(parents);
+    std::vector<std::uint32_t>().swap(depths);
+    std::vector<CellIndex>().swap(jumps);
+    std::vector<PathCost>().swap(rootCosts);
+    std::vector<std::uint8_t>().swap(cellCosts);
+  }
+}
+
+CellIndex TreeIndex::commonAncestor(CellIndex a, CellIndex b,
+                                    std::uint64_t *steps) const {
+  std::uint64_t taken = 0;
+  if (depths[a] < depths[b])
+    std::swap(a, b);
+
+  // Climb to the same depth, jumping while the jump does not overshoot
+  while (depths[a] > depths[b]) {
+    a = depths[jumps[a]] >= depths[b] ? jumps[a] : getParent(a);
+    ++taken;
+  }
+
+  // Jumps depend only on depth, so both cells jump the same distance; take
+  // a jump while it stays below the common ancestor
+  while (a != b) {
+    if (parents[a] == ROOT) {
+      a = NO_CELL; // Different regions
+      break;
+    }
+    if (jumps[a] != jumps[b]) {
+      a = jumps[a];
+      b = jumps[b];
+    } else {
+      a = getParent(a);
+      b = getParent(b);
+    }
+    ++taken;
+  }
+
+  if (steps)
+    *steps = taken;
+  return a;
+}
+
+PathCost TreeIndex::distance(CellIndex a, CellIndex b) const {
+  const CellIndex ancestor = commonAncestor(a, b);
+  if (ancestor == NO_CELL)
+    return NO_PATH;
+  // Up from a to the ancestor pays for the cells above a, down to b for
+  // the cells below the ancestor
+  const PathCost up = rootCost(a) - rootCost(ancestor);
+  const PathCost down = rootCost(b) - rootCost(ancestor);
+  if (cellCosts.empty())
+    return up + down;
+  return up - cellCosts[a] + cellCosts[ancestor] + down;
+}
+
+std::size_t TreeIndex::getMemoryBytes() const {
+  return parents.capacity() * sizeof(std::uint8_t) +
+         depths.capacity() * sizeof(std::uint32_t) +
+         jumps.capacity() * sizeof(CellIndex) +
+         rootCosts.capacity() * sizeof(PathCost) +
+         cellCosts.capacity() * sizeof(std::uint8_t);
+}
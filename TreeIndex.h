@@ -0,0 +1,173 @@
+#ifndef TREE_INDEX_H
+#define TREE_INDEX_H
+
+#include "Maze.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Rooted-tree index of a perfect maze, for path queries without
+ * search (see TreePathfinder).
+ *
+ * Mazes from Maze::generatePerfectMaze() are spanning trees: there is
+ * exactly one path between any two open cells. The index roots each region
+ * of open cells at its first cell in index order and stores, for every
+ * cell, the step to its parent, its depth and a jump pointer. Jump pointers
+ * skip up the tree in a skew-binary pattern (each cell jumps either to its
+ * parent or, if its parent's jump and the one after it are the same length,
+ * past both), so the lowest common ancestor of two cells is found in
+ * O(log depth) steps with O(1) memory per cell. The path between two cells
+ * runs through their common ancestor, and its cost follows from the costs
+ * of the cells from their region's root.
+ *
+ * Building is one breadth-first pass. It also checks the maze: if any
+ * region has a cycle (Maze::generate() mazes, or a perfect maze with a wall
+ * removed) the index holds no tree and isTree() is false. The index
+ * records the wall version (Maze::getWallVersion()), so isCurrent() tells
+ * in O(1) whether the walls have changed since. Terrain costs are read
+ * when building and not checked afterwards.
+ */
+class TreeIndex {
+public:
+  /**
+   * @brief Cell returned when two cells have no common ancestor.
+   */
+  static constexpr CellIndex NO_CELL = ~CellIndex{0};
+
+  /**
+   * @brief Cost returned for cells with no path between them.
+   */
+  static constexpr PathCost NO_PATH = ~PathCost{0};
+
+  /**
+   * @brief Construct an empty index; see build().
+   */
+  TreeIndex();
+
+  /**
+   * @brief Construct the index of a maze.
+   * @param maze The maze to index.
+   */
+  explicit TreeIndex(const Maze &maze);
+
+  /**
+   * @brief Index a maze, replacing any index held. Takes O(cells).
+   * @param maze The maze to index.
+   */
+  void build(const Maze &maze);
+
+  /**
+   * @brief Check whether the maze was acyclic when the index was built, so
+   * that connected cells have exactly one path between them. Only then
+   * does the index hold anything.
+   */
+  bool isTree() const { return tree; }
+
+  /**
+   * @brief Check whether the index was built for a maze of this size. The
+   * walls are not compared.
+   */
+  bool matches(const Maze &maze) const {
+    return maze.getWidth() == width && maze.getHeight() == height;
+  }
+
+  /**
+   * @brief Check whether the index was built for this maze and its walls
+   * have not been edited since. A copy of the maze has a wall version of
+   * its own, so it is not current for an index built on the original.
+   */
+  bool isCurrent(const Maze &maze) const {
+    return matches(maze) && maze.getWallVersion() == walls;
+  }
+
+  /**
+   * @brief Check whether a cell is an indexed open cell.
+   * @param cell The cell index (must be a cell of the index's maze).
+   */
+  bool contains(CellIndex cell) const {
+    return tree && parents[cell] != NO_PARENT;
+  }
+
+  /**
+   * @brief Get the number of steps from a cell to the root of its region.
+   * @param cell An indexed cell (see contains()).
+   */
+  std::uint32_t getDepth(CellIndex cell) const { return depths[cell]; }
+
+  /**
+   * @brief Get the parent of a cell.
+   * @param cell An indexed cell (see contains()).
+   * @return The neighbor one step closer to the root, or NO_CELL for a root.
+   */
+  CellIndex getParent(CellIndex cell) const {
+    switch (parents[cell]) {
+    case static_cast<std::uint8_t>(Direction::UP):
+      return cell - static_cast<CellIndex>(width);
+    case static_cast<std::uint8_t>(Direction::DOWN):
+      return cell + static_cast<CellIndex>(width);
+    case static_cast<std::uint8_t>(Direction::LEFT):
+      return cell - 1;
+    case static_cast<std::uint8_t>(Direction::RIGHT):
+      return cell + 1;
+    default:
+      return NO_CELL;
+    }
+  }
+
+  /**
+   * @brief Get the step from a cell to its parent.
+   * @param cell An indexed cell that is not a root.
+   */
+  Direction getParentDirection(CellIndex cell) const {
+    return static_cast<Direction>(parents[cell]);
+  }
+
+  /**
+   * @brief Find the lowest common ancestor of two cells.
+   * @param a An indexed cell.
+   * @param b An indexed cell.
+   * @param steps If not null, receives the number of jumps and parent steps
+   * taken, which is O(log depth).
+   * @return The deepest cell that is an ancestor of both (possibly a or b
+   * itself), or NO_CELL if they lie in different regions.
+   */
+  CellIndex commonAncestor(CellIndex a, CellIndex b,
+                           std::uint64_t *steps = nullptr) const;
+
+  /**
+   * @brief Get the cost of the path between two cells: the sum of the
+   * terrain costs of its cells after the first, as of build().
+   * @param a An indexed cell.
+   * @param b An indexed cell.
+   * @return The cost, or NO_PATH if they lie in different regions.
+   */
+  PathCost distance(CellIndex a, CellIndex b) const;
+
+  /**
+   * @brief Get the size of the index in bytes.
+   */
+  std::size_t getMemoryBytes() const;
+
+private:
+  // parents value of a root, and of a wall or unindexed cell
+  static constexpr std::uint8_t ROOT = 4;
+  static constexpr std::uint8_t NO_PARENT = 5;
+
+  // Cost of a cell's path from its root, excluding the root
+  PathCost rootCost(CellIndex cell) const {
+    return rootCosts.empty() ? depths[cell] : rootCosts[cell];
+  }
+
+  int width;
+  int height;
+  bool tree;
+  Maze::WallVersion walls;           // Maze::getWallVersion() at the build
+  std::vector<std::uint8_t> parents; // Direction to the parent, per cell
+  std::vector<std::uint32_t> depths; // Steps from the root
+  std::vector<CellIndex> jumps;      // Skew-binary jump pointers
+  // Cost of the path from the root, only for mazes with terrain costs
+  std::vector<PathCost> rootCosts;
+  std::vector<std::uint8_t> cellCosts; // Copy of the cost plane, if any
+};
+
+#endif // TREE_INDEX_H
@@ -0,0 +1,63 @@
+#include "TreePathfinder.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+TreePathfinder::TreePathfinder(std::shared_ptr<const TreeIndex> index)
+    : index(std::move(index)) {}
+
+std::vector<Cell> TreePathfinder::findPath(
+    const Maze &maze, SearchContext &context, std::shared_ptr<Cell> start,
+    std::shared_ptr<Cell> goal,
+    std::function<void(std::shared_ptr<Cell>)> onVisit) const {
+  if (!index || !index->matches(maze)) {
+    throw std::invalid_argument("Tree index was not built for this maze");
+  }
+  requireFourConnected(context, "Tree index search");
+  if (!index->isTree() || !index->isCurrent(maze))
+    return fallback.findPath(maze, context, start, goal, onVisit);
+  auto startTime = std::chrono::high_resolution_clock::now();
+
+  context.begin(maze);
+  if (!start || !goal || maze.isWall(start->getX(), start->getY()) ||
+      maze.isWall(goal->getX(), goal->getY())) {
+    return context.getPath();
+  }
+
+  const CellIndex startIndex = maze.indexOf(start->getX(), start->getY());
+  const CellIndex goalIndex = maze.indexOf(goal->getX(), goal->getY());
+  PathStats &stats = context.getStats();
+  const CellIndex ancestor =
+      isUnreachable(maze, context, startIndex, goalIndex)
+          ? TreeIndex::NO_CELL
+          : index->commonAncestor(startIndex, goalIndex,
+                                  &stats.nodesExplored);
+
+  if (ancestor != TreeIndex::NO_CELL) {
+    // Up from the start, each cell's parent on the path is the cell below
+    // it; down to the goal, it is the cell's parent in the tree
+    context.markVisited(startIndex, SearchContext::ROOT_PARENT);
+    for (CellIndex cell = startIndex; cell != ancestor;) {
+      const Direction up = index->getParentDirection(cell);
+      cell = index->getParent(cell);
+      context.markVisited(cell, SearchContext::oppositeDirection(up));
+    }
+    for (CellIndex cell = goalIndex; cell != ancestor;
+         cell = index->getParent(cell)) {
+      context.markVisited(
+          cell, static_cast<std::uint8_t>(index->getParentDirection(cell)));
+    }
+    reconstructPath(maze, context, startIndex, goalIndex);
+    if (onVisit) {
+      for (const Cell &cell : context.getPath())
+        onVisit(maze.getCell(cell.getX(), cell.getY()));
+    }
+  }
+
+  auto endTime = std::chrono::high_resolution_clock::now();
+  context.getStats().executionTime =
+      std::chrono::duration<double, std::milli>(endTime - startTime);
+
+  return context.getPath();
+}
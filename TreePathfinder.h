@@ -0,0 +1,64 @@
+#ifndef TREE_PATHFINDER_H
+#define TREE_PATHFINDER_H
+
+#include "AStarPathfinder.h"
+#include "Maze.h"
+#include "PathFinder.h"
+#include "TreeIndex.h"
+#include <memory>
+
+/**
+ * @brief Path queries on perfect mazes answered from a TreeIndex, without
+ * search.
+ *
+ * The path between two cells of a tree runs from the start up to their
+ * lowest common ancestor and down to the goal. The ancestor is found in
+ * O(log depth) jumps, and the path is marked by following parent steps
+ * from both ends, so a query costs O(path length). Checking that the index
+ * is current compares the maze's wall version with the one it was built
+ * for, in O(1). It is the only path, so it is also the cheapest.
+ *
+ * If the index holds no tree (the maze had a cycle when it was built) or
+ * the walls have changed since, the query falls back to A*.
+ * stats.nodesExplored counts the jumps and parent steps taken to find the
+ * ancestor. There is no path from or to a wall cell.
+ *
+ * The ancestor jumps and parent steps only read the index. Concurrent
+ * queries through one index are safe when each has its own context;
+ * TreeIndex::build() must not overlap with them.
+ */
+class TreePathfinder : public PathFinder {
+public:
+  using PathFinder::findPath;
+
+  /**
+   * @brief Construct a pathfinder that uses a precomputed index.
+   * @param index The tree index of the mazes that will be searched.
+   */
+  explicit TreePathfinder(std::shared_ptr<const TreeIndex> index);
+
+  /**
+   * @brief Find the path from start to goal in the tree.
+   * @param maze The maze to search.
+   * @param context The per-query state to use.
+   * @param start The starting cell.
+   * @param goal The goal cell.
+   * @param onVisit Optional callback for animation, called for each path
+   * cell (default: nullptr).
+   * @return A vector of cells representing the path, or empty if no path
+   * exists.
+   * @throws std::invalid_argument if the index was built for a maze of a
+   * different size, or if the context's movement is not 4-connected.
+   */
+  std::vector<Cell>
+  findPath(const Maze &maze, SearchContext &context,
+           std::shared_ptr<Cell> start, std::shared_ptr<Cell> goal,
+           std::function<void(std::shared_ptr<Cell>)> onVisit = nullptr)
+      const override;
+
+private:
+  std::shared_ptr<const TreeIndex> index;
+  AStarPathfinder fallback; // For mazes the index does not describe
+};
+
+#endif // TREE_PATHFINDER_H
@@ -0,0 +1,112 @@
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AStarPathfinder.h"
+#include "BFSPathfinder.h"
+#include "DFSPathfinder.h"
+#include "DijkstraPathfinder.h"
+#include "Maze.h"
+
+/**
+ * @brief Counts heap allocations made by each pathfinder during findPath.
+ *
+ * The global allocation functions are replaced to count calls and bytes
+ * while a search is running. Each algorithm is run on several random perfect
+ * mazes per size; the table shows averages per search and per 1000 expanded
+ * nodes.
+ *
+ * Usage: bench_allocations [size...]   (square mazes, default: 101 1001)
+ */
+
+namespace {
+
+bool counting = false;
+std::size_t allocationCount = 0;
+std::size_t allocationBytes = 0;
+
+constexpr int TRIALS = 5;
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  if (counting) {
+    ++allocationCount;
+    allocationBytes += size;
+  }
+  if (void *ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+int main(int argc, char *argv[]) {
+  std::vector<int> sizes;
+  for (int i = 1; i < argc; ++i) {
+    sizes.push_back(std::atoi(argv[i]));
+  }
+  if (sizes.empty()) {
+    sizes = {101, 1001};
+  }
+
+  std::vector<std::pair<std::string, std::unique_ptr<PathFinder>>> algorithms;
+  algorithms.push_back({"BFS", std::make_unique<BFSPathfinder>()});
+  algorithms.push_back({"DFS", std::make_unique<DFSPathfinder>()});
+  algorithms.push_back({"Dijkstra", std::make_unique<DijkstraPathfinder>()});
+  algorithms.push_back({"A*", std::make_unique<AStarPathfinder>()});
+
+  std::cout << "=== Heap allocations per search ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(12) << "Algorithm" << std::right
+            << std::setw(12) << "Grid" << std::setw(16) << "Allocs/search"
+            << std::setw(16) << "KiB/search" << std::setw(20)
+            << "Allocs/1000 nodes" << std::endl;
+  std::cout << std::string(76, '-') << std::endl;
+
+  for (int size : sizes) {
+    std::vector<std::size_t> calls(algorithms.size(), 0);
+    std::vector<std::size_t> bytes(algorithms.size(), 0);
+    std::vector<std::uint64_t> nodes(algorithms.size(), 0);
+
+    for (int trial = 0; trial < TRIALS; ++trial) {
+      Maze maze;
+      maze.generatePerfectMaze(size, size,
+                               MazeGenerationAlgorithm::RECURSIVE_BACKTRACKING);
+      auto start = maze.getStart();
+      auto goal = maze.getGoal();
+
+      for (std::size_t i = 0; i < algorithms.size(); ++i) {
+        allocationCount = 0;
+        allocationBytes = 0;
+        counting = true;
+        algorithms[i].second->findPath(maze, start, goal);
+        counting = false;
+
+        calls[i] += allocationCount;
+        bytes[i] += allocationBytes;
+        nodes[i] += algorithms[i].second->getStats().nodesExplored;
+      }
+    }
+
+    for (std::size_t i = 0; i < algorithms.size(); ++i) {
+      std::cout << std::left << std::setw(12) << algorithms[i].first
+                << std::right << std::setw(12)
+                << (std::to_string(size) + "x" + std::to_string(size))
+                << std::fixed << std::setprecision(1) << std::setw(16)
+                << static_cast<double>(calls[i]) / TRIALS << std::setw(16)
+                << static_cast<double>(bytes[i]) / TRIALS / 1024.0
+                << std::setprecision(2) << std::setw(20)
+                << 1000.0 * calls[i] / nodes[i] << std::endl;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AStarPathfinder.h"
+#include "BenchUtil.h"
+#include "LandmarkTable.h"
+#include "Maze.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Compares A* with the Manhattan distance and with the ALT landmark
+ * heuristic for each maze generator.
+ *
+ * For every MazeGenerationAlgorithm, generates a maze and runs the same
+ * random queries (between open cells, fixed seed) with plain A* and with
+ * A* over LandmarkTables of 4, 8 and 16 landmarks, each reusing one
+ * SearchContext. Reports the cells expanded and the time per query, and
+ * checks path costs against plain A*. The 8-landmark table is also saved
+ * and loaded back, and queried again from the mapped file.
+ *
+ * Usage: bench_alt [size] [queries]   (default: 1001 200)
+ */
+
+namespace {
+
+struct Totals {
+  std::uint64_t nodes = 0;
+  double milliseconds = 0.0;
+};
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int queries = intArgument(argc, argv, 2, 200);
+  const int landmarkCounts[] = {4, 8, 16};
+  const std::string tableFile = "bench_alt.alt";
+
+  const std::pair<const char *, MazeGenerationAlgorithm> generators[] = {
+      {"backtracking", MazeGenerationAlgorithm::RECURSIVE_BACKTRACKING},
+      {"prims", MazeGenerationAlgorithm::RANDOMIZED_PRIMS},
+      {"division", MazeGenerationAlgorithm::RECURSIVE_DIVISION}};
+
+  std::cout << "=== ALT landmarks: " << size << "x" << size << " mazes, "
+            << queries << " random queries ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(14) << "Generator" << std::setw(11)
+            << "Heuristic" << std::right << std::setw(10) << "Build ms"
+            << std::setw(8) << "MiB" << std::setw(13) << "Nodes/query"
+            << std::setw(10) << "Fewer" << std::setw(10) << "ms/query"
+            << std::setw(10) << "Speedup" << std::endl;
+  std::cout << std::string(86, '-') << std::endl;
+
+  int mismatches = 0;
+  for (const auto &generator : generators) {
+    Maze maze;
+    maze.generatePerfectMaze(size, size, generator.second);
+
+    std::mt19937 rng(12345);
+    std::vector<std::pair<std::shared_ptr<Cell>, std::shared_ptr<Cell>>>
+        pairs;
+    for (int i = 0; i < queries; ++i)
+      pairs.push_back({randomOpenCell(maze, rng), randomOpenCell(maze, rng)});
+
+    std::vector<PathCost> costs(pairs.size());
+    auto run = [&](const AStarPathfinder &astar, bool reference) {
+      Totals totals;
+      SearchContext context;
+      for (std::size_t q = 0; q < pairs.size(); ++q) {
+        astar.findPath(maze, context, pairs[q].first, pairs[q].second);
+        const PathStats &stats = context.getStats();
+        totals.nodes += stats.nodesExplored;
+        totals.milliseconds += stats.executionTime.count();
+        if (reference)
+          costs[q] = stats.pathCost;
+        else if (stats.pathCost != costs[q])
+          ++mismatches;
+      }
+      return totals;
+    };
+    const Totals manhattan = run(AStarPathfinder(), true);
+
+    auto report = [&](const std::string &heuristic, double buildMs,
+                      std::size_t bytes, const Totals &totals) {
+      std::cout << std::left << std::setw(14) << generator.first
+                << std::setw(11) << heuristic << std::right << std::fixed
+                << std::setprecision(1) << std::setw(10) << buildMs
+                << std::setw(8) << bytes / (1024.0 * 1024.0) << std::setw(13)
+                << static_cast<double>(totals.nodes) / queries
+                << std::setprecision(2) << std::setw(9)
+                << static_cast<double>(manhattan.nodes) /
+                       static_cast<double>(totals.nodes)
+                << "x" << std::setprecision(3) << std::setw(10)
+                << totals.milliseconds / queries << std::setprecision(2)
+                << std::setw(9)
+                << manhattan.milliseconds / totals.milliseconds << "x"
+                << std::endl;
+    };
+    report("Manhattan", 0.0, 0, manhattan);
+
+    for (int count : landmarkCounts) {
+      auto buildStart = Clock::now();
+      auto table = std::make_shared<LandmarkTable>(maze, count);
+      const double buildMs = millisecondsSince(buildStart);
+      report("ALT-" + std::to_string(count), buildMs, table->getMemoryBytes(),
+             run(AStarPathfinder(table), false));
+
+      if (count == 8) {
+        auto loadStart = Clock::now();
+        auto loaded = std::make_shared<LandmarkTable>();
+        if (!table->saveToFile(tableFile) ||
+            !loaded->loadFromFile(tableFile, maze)) {
+          ++mismatches;
+          continue;
+        }
+        const double loadMs = millisecondsSince(loadStart);
+        report("ALT-8 file", loadMs, loaded->getMemoryBytes(),
+               run(AStarPathfinder(loaded), false));
+      }
+    }
+  }
+  std::remove(tableFile.c_str());
+
+  std::cout << std::endl
+            << "Build ms is the save and load time for the file row."
+            << std::endl;
+  if (mismatches > 0) {
+    std::cerr << "Error: " << mismatches << " path costs differ from A*"
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
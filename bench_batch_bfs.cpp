@@ -0,0 +1,124 @@
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BFSPathfinder.h"
+#include "BatchBFS.h"
+#include "BenchUtil.h"
+#include "Maze.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Measures bit-parallel BFS (BatchBFS) against one BFSPathfinder
+ * search per query.
+ *
+ * On a perfect maze and on a maze with cycles, runs the same queries
+ * between open cells (fixed seed) with BFSPathfinder, reusing one
+ * SearchContext, and with BatchBFS, 64 per sweep. There are two query
+ * sets: every query from its own random start, and all queries from a few
+ * shared starts (say, many agents leaving from the same depots), taken in
+ * turn so that no two neighboring queries share one. BatchBFS gets the
+ * queries unsorted and groups them by start itself. Path lengths are
+ * checked against BFSPathfinder.
+ *
+ * Usage: bench_batch_bfs [size] [queries] [shared starts]
+ *        (default: 1001 640 16)
+ */
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int queryCount = intArgument(argc, argv, 2, 640);
+  const int sharedCount = intArgument(argc, argv, 3, 16);
+
+  std::cout << "=== Bit-parallel BFS: " << size << "x" << size << " mazes, "
+            << queryCount << " queries ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(10) << "Maze" << std::setw(12)
+            << "Starts" << std::setw(16) << "Search" << std::right
+            << std::setw(11) << "Total ms" << std::setw(12) << "Queries/s"
+            << std::setw(13) << "Expanded" << std::setw(10) << "Speedup"
+            << std::endl;
+  std::cout << std::string(84, '-') << std::endl;
+
+  Maze perfect;
+  perfect.generatePerfectMaze(size, size);
+  Maze cyclic;
+  cyclic.generate(size, size);
+  const std::pair<const char *, const Maze *> mazes[] = {
+      {"perfect", &perfect}, {"generate", &cyclic}};
+
+  int mismatches = 0;
+  std::mt19937 rng(12345);
+  for (const auto &entry : mazes) {
+    const Maze &maze = *entry.second;
+    std::vector<CellIndex> shared;
+    for (int i = 0; i < sharedCount; ++i)
+      shared.push_back(randomOpenIndex(maze, rng));
+    std::vector<BatchBFS::Query> ownStarts, sharedStarts;
+    for (int i = 0; i < queryCount; ++i) {
+      ownStarts.push_back(
+          {randomOpenIndex(maze, rng), randomOpenIndex(maze, rng)});
+      sharedStarts.push_back(
+          {shared[i % sharedCount], randomOpenIndex(maze, rng)});
+    }
+    const std::string sharedLabel = std::to_string(sharedCount) + " shared";
+    const std::pair<std::string, const std::vector<BatchBFS::Query> *>
+        workloads[] = {{"own", &ownStarts}, {sharedLabel, &sharedStarts}};
+
+    for (const auto &workload : workloads) {
+      const std::vector<BatchBFS::Query> &queries = *workload.second;
+
+      // One search per query
+      BFSPathfinder bfs;
+      SearchContext context;
+      std::vector<std::uint64_t> expected;
+      std::uint64_t bfsExpanded = 0;
+      auto bfsStart = Clock::now();
+      for (const BatchBFS::Query &query : queries) {
+        const Coordinate start = maze.coordsOf(query.start);
+        const Coordinate goal = maze.coordsOf(query.goal);
+        bfs.findPath(maze, context, maze.getCell(start.x, start.y),
+                     maze.getCell(goal.x, goal.y));
+        expected.push_back(context.getStats().pathLength);
+        bfsExpanded += context.getStats().nodesExplored;
+      }
+      const double bfsMs = millisecondsSince(bfsStart);
+
+      // The same queries in sweeps of 64
+      BatchBFS batch;
+      batch.pathLengths(maze, queries); // Allocate the per-cell words
+      auto batchStart = Clock::now();
+      const std::vector<std::uint64_t> lengths =
+          batch.pathLengths(maze, queries);
+      const double batchMs = millisecondsSince(batchStart);
+      for (std::size_t i = 0; i < queries.size(); ++i) {
+        if (lengths[i] != expected[i])
+          ++mismatches;
+      }
+
+      const std::pair<const char *, std::pair<double, std::uint64_t>>
+          rows[] = {{"BFSPathfinder", {bfsMs, bfsExpanded}},
+                    {"BatchBFS", {batchMs, batch.getCellsExpanded()}}};
+      for (const auto &row : rows) {
+        std::cout << std::left << std::setw(10) << entry.first
+                  << std::setw(12) << workload.first << std::setw(16)
+                  << row.first << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(11)
+                  << row.second.first << std::setw(12)
+                  << queryCount * 1000.0 / row.second.first << std::setw(13)
+                  << row.second.second << std::setw(9)
+                  << bfsMs / row.second.first << "x" << std::endl;
+      }
+    }
+  }
+
+  if (mismatches > 0) {
+    std::cerr << "Error: " << mismatches << " results differ from BFS"
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
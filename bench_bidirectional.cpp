@@ -0,0 +1,117 @@
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AStarPathfinder.h"
+#include "BFSPathfinder.h"
+#include "BenchUtil.h"
+#include "BidirectionalAStarPathfinder.h"
+#include "BidirectionalBFSPathfinder.h"
+#include "Maze.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Compares unidirectional and bidirectional searches.
+ *
+ * Generates a maze and runs the same random queries (between open cells,
+ * fixed seed) with each algorithm, reusing one SearchContext per algorithm.
+ * Reports expanded nodes per query, split by side for the bidirectional
+ * searches. The BFS searches ignore terrain costs and must agree with BFS
+ * on path lengths; the A* searches must agree with A* on path costs.
+ *
+ * Usage: bench_bidirectional [size] [queries] [layout]
+ *        (default: 1001 200 perfect; layout as for bench_throughput)
+ */
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int queries = intArgument(argc, argv, 2, 200);
+  const std::string layout = textArgument(argc, argv, 3, "perfect");
+  if (!isLayout(layout)) {
+    std::cerr << "Unknown layout: " << layout << std::endl;
+    return 1;
+  }
+
+  std::mt19937 rng(12345);
+  Maze maze;
+  generateLayout(maze, size, layout, rng);
+
+  std::vector<std::pair<std::shared_ptr<Cell>, std::shared_ptr<Cell>>> pairs;
+  for (int i = 0; i < queries; ++i)
+    pairs.push_back({randomOpenCell(maze, rng), randomOpenCell(maze, rng)});
+
+  auto bidirectionalBfs = std::make_unique<BidirectionalBFSPathfinder>();
+  auto bidirectionalAStar = std::make_unique<BidirectionalAStarPathfinder>();
+  // Expansions of each side, as counted by the bidirectional searches
+  const BidirectionalBFSPathfinder &bfsSides = *bidirectionalBfs;
+  const BidirectionalAStarPathfinder &aStarSides = *bidirectionalAStar;
+  auto sideNodes = [&](std::size_t algorithm) {
+    if (algorithm == 1)
+      return std::make_pair(bfsSides.getForwardNodes(),
+                            bfsSides.getBackwardNodes());
+    if (algorithm == 3)
+      return std::make_pair(aStarSides.getForwardNodes(),
+                            aStarSides.getBackwardNodes());
+    return std::make_pair(std::uint64_t{0}, std::uint64_t{0});
+  };
+
+  std::vector<std::pair<std::string, std::unique_ptr<PathFinder>>> algorithms;
+  algorithms.push_back({"BFS", std::make_unique<BFSPathfinder>()});
+  algorithms.push_back({"Bidir. BFS", std::move(bidirectionalBfs)});
+  algorithms.push_back({"A*", std::make_unique<AStarPathfinder>()});
+  algorithms.push_back({"Bidir. A*", std::move(bidirectionalAStar)});
+
+  std::cout << "=== Bidirectional search: " << size << "x" << size << " "
+            << layout << " maze, " << queries << " random queries ==="
+            << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(12) << "Algorithm" << std::right
+            << std::setw(14) << "Nodes/query" << std::setw(12) << "Forward"
+            << std::setw(12) << "Backward" << std::setw(12) << "ms/query"
+            << std::endl;
+  std::cout << std::string(62, '-') << std::endl;
+
+  // BFS lengths check the BFS searches, A* costs the A* searches
+  std::vector<std::uint64_t> lengths(pairs.size()), costs(pairs.size());
+  int mismatches = 0;
+  for (std::size_t i = 0; i < algorithms.size(); ++i) {
+    SearchContext context;
+    double milliseconds = 0.0;
+    double nodes = 0.0, forward = 0.0, backward = 0.0;
+    for (std::size_t q = 0; q < pairs.size(); ++q) {
+      algorithms[i].second->findPath(maze, context, pairs[q].first,
+                                     pairs[q].second);
+      const PathStats &stats = context.getStats();
+      milliseconds += stats.executionTime.count();
+      nodes += static_cast<double>(stats.nodesExplored);
+      const auto sides = sideNodes(i);
+      forward += static_cast<double>(sides.first);
+      backward += static_cast<double>(sides.second);
+      if (i == 0)
+        lengths[q] = stats.pathLength;
+      else if (i == 1 && stats.pathLength != lengths[q])
+        ++mismatches;
+      else if (i == 2)
+        costs[q] = stats.pathCost;
+      else if (i == 3 && stats.pathCost != costs[q])
+        ++mismatches;
+    }
+
+    std::cout << std::left << std::setw(12) << algorithms[i].first
+              << std::right << std::fixed << std::setprecision(0)
+              << std::setw(14) << nodes / queries << std::setw(12)
+              << forward / queries << std::setw(12) << backward / queries
+              << std::setprecision(3) << std::setw(12)
+              << milliseconds / queries << std::endl;
+  }
+
+  if (mismatches > 0) {
+    std::cerr << "Error: " << mismatches
+              << " paths differ from the unidirectional search" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "AStarPathfinder.h"
+#include "BFSPathfinder.h"
+#include "BenchUtil.h"
+#include "ComponentIndex.h"
+#include "Maze.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Measures component labels: building them, rejecting unreachable
+ * goals with them, and keeping them up to date after wall edits.
+ *
+ * For every MazeGenerationAlgorithm, generates a maze, walls off one random
+ * corridor cell so that the maze falls apart, and runs random queries
+ * between open cells of different regions (fixed seed) with BFS and A*,
+ * once without and once with labels on the context. Then toggles random
+ * cells one at a time, updating the labels after each change, and checks
+ * the result against labels built from scratch.
+ *
+ * Usage: bench_components [size] [queries] [edits]   (default: 1001 50 2000)
+ */
+
+namespace {
+
+// Whether two indexes group the open cells into the same regions
+bool samePartition(const Maze &maze, const ComponentIndex &a,
+                   const ComponentIndex &b) {
+  std::unordered_map<std::uint32_t, std::uint32_t> forward, backward;
+  for (CellIndex cell = 0; cell < maze.getCellCount(); ++cell) {
+    const std::uint32_t x = a.getLabel(cell);
+    const std::uint32_t y = b.getLabel(cell);
+    if ((x == ComponentIndex::NO_LABEL) != (y == ComponentIndex::NO_LABEL))
+      return false;
+    if (x == ComponentIndex::NO_LABEL)
+      continue;
+    if (forward.emplace(x, y).first->second != y ||
+        backward.emplace(y, x).first->second != x)
+      return false;
+  }
+  return forward.size() == a.getComponentCount() &&
+         a.getComponentCount() == b.getComponentCount();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int queries = intArgument(argc, argv, 2, 50);
+  const int edits = intArgument(argc, argv, 3, 2000);
+
+  const std::pair<const char *, MazeGenerationAlgorithm> generators[] = {
+      {"backtracking", MazeGenerationAlgorithm::RECURSIVE_BACKTRACKING},
+      {"prims", MazeGenerationAlgorithm::RANDOMIZED_PRIMS},
+      {"division", MazeGenerationAlgorithm::RECURSIVE_DIVISION}};
+
+  std::cout << "=== Component labels: " << size << "x" << size << " mazes, "
+            << queries << " unreachable queries, " << edits
+            << " wall edits ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(14) << "Generator" << std::right
+            << std::setw(10) << "Build ms" << std::setw(8) << "MiB"
+            << std::setw(11) << "BFS ms" << std::setw(11) << "A* ms"
+            << std::setw(13) << "Labeled us" << std::setw(12) << "Update us"
+            << std::setw(12) << "Max upd ms" << std::endl;
+  std::cout << std::string(91, '-') << std::endl;
+
+  int failures = 0;
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<int> coordinate(0, size - 1);
+  for (const auto &generator : generators) {
+    Maze maze;
+    maze.generatePerfectMaze(size, size, generator.second);
+
+    // Wall off a straight corridor cell, splitting the tree in two
+    int cutX = size / 2, cutY = size / 2;
+    while (maze.isWall(cutX, cutY) ||
+           maze.openDirections(cutX, cutY) !=
+               (Maze::directionBit(Direction::LEFT) |
+                Maze::directionBit(Direction::RIGHT))) {
+      cutX = coordinate(rng);
+      cutY = coordinate(rng);
+    }
+    maze.setWall(cutX, cutY, true);
+
+    auto buildStart = Clock::now();
+    auto components = std::make_shared<ComponentIndex>(maze);
+    const double buildMs = millisecondsSince(buildStart);
+
+    auto labelOf = [&](const std::shared_ptr<Cell> &cell) {
+      return components->getLabel(maze.indexOf(cell->getX(), cell->getY()));
+    };
+    std::vector<std::pair<std::shared_ptr<Cell>, std::shared_ptr<Cell>>>
+        pairs;
+    while (static_cast<int>(pairs.size()) < queries) {
+      auto start = randomOpenCell(maze, rng);
+      auto goal = randomOpenCell(maze, rng);
+      if (labelOf(start) != labelOf(goal))
+        pairs.push_back({start, goal});
+    }
+
+    // Unreachable queries flood the start's region unless labels are set
+    BFSPathfinder bfs;
+    AStarPathfinder astar;
+    const PathFinder *algorithms[] = {&bfs, &astar};
+    double milliseconds[2] = {0.0, 0.0};
+    double labeledMs = 0.0;
+    SearchContext context;
+    for (int i = 0; i < 2; ++i) {
+      for (const auto &pair : pairs) {
+        context.setComponents(nullptr);
+        algorithms[i]->findPath(maze, context, pair.first, pair.second);
+        milliseconds[i] += context.getStats().executionTime.count();
+        failures += context.getStats().pathLength != 0;
+        context.setComponents(components);
+        algorithms[i]->findPath(maze, context, pair.first, pair.second);
+        labeledMs += context.getStats().executionTime.count();
+        failures += context.getStats().pathLength != 0;
+      }
+    }
+
+    // Single wall toggles, each followed by an update
+    auto index = std::make_shared<ComponentIndex>(maze);
+    double updateMs = 0.0;
+    double slowestMs = 0.0;
+    for (int e = 0; e < edits; ++e) {
+      const int x = coordinate(rng);
+      const int y = coordinate(rng);
+      maze.setWall(x, y, !maze.isWall(x, y));
+      auto updateStart = Clock::now();
+      index->update(maze, x, y);
+      const double ms = millisecondsSince(updateStart);
+      updateMs += ms;
+      slowestMs = std::max(slowestMs, ms);
+    }
+    if (!samePartition(maze, *index, ComponentIndex(maze)))
+      ++failures;
+
+    std::cout << std::left << std::setw(14) << generator.first << std::right
+              << std::fixed << std::setprecision(1) << std::setw(10)
+              << buildMs << std::setw(8)
+              << components->getMemoryBytes() / (1024.0 * 1024.0)
+              << std::setprecision(3) << std::setw(11)
+              << milliseconds[0] / queries << std::setw(11)
+              << milliseconds[1] / queries << std::setw(13)
+              << labeledMs * 1000.0 / (2 * queries) << std::setw(12)
+              << updateMs * 1000.0 / edits << std::setw(12) << slowestMs
+              << std::endl;
+  }
+
+  if (failures > 0) {
+    std::cerr << "Error: " << failures << " checks failed" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AStarPathfinder.h"
+#include "BenchUtil.h"
+#include "DijkstraPathfinder.h"
+#include "Maze.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Measures one-to-many distance queries against one A* search per
+ * target.
+ *
+ * On a perfect maze and on a maze with cycles, picks random starts and,
+ * for K = 1, 16 and 256 random targets (open cells, fixed seed), finds the
+ * cost to every target with a loop of AStarPathfinder::findPath() and with
+ * one DijkstraPathfinder::distancesTo() sweep, with and without paths.
+ * Costs and path lengths are checked against A*.
+ *
+ * Usage: bench_distances [size] [starts]   (default: 1001 3)
+ */
+
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int starts = intArgument(argc, argv, 2, 3);
+
+  std::cout << "=== One-to-many distances: " << size << "x" << size
+            << " mazes, " << starts << " starts ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(10) << "Maze" << std::right
+            << std::setw(6) << "K" << std::setw(12) << "A* loop ms"
+            << std::setw(11) << "Sweep ms" << std::setw(10) << "+ paths"
+            << std::setw(10) << "Speedup" << std::setw(11) << "Expanded"
+            << std::endl;
+  std::cout << std::string(70, '-') << std::endl;
+
+  Maze perfect;
+  perfect.generatePerfectMaze(size, size);
+  Maze cyclic;
+  cyclic.generate(size, size);
+  const std::pair<const char *, const Maze *> mazes[] = {
+      {"perfect", &perfect}, {"generate", &cyclic}};
+
+  int mismatches = 0;
+  std::mt19937 rng(12345);
+  AStarPathfinder astar;
+  DijkstraPathfinder dijkstra(OpenList::BUCKETS);
+  SearchContext context;
+  for (const auto &entry : mazes) {
+    const Maze &maze = *entry.second;
+
+    for (int k : {1, 16, 256}) {
+      double loopMs = 0.0, sweepMs = 0.0, pathsMs = 0.0;
+      std::uint64_t expanded = 0;
+      for (int s = 0; s < starts; ++s) {
+        const std::shared_ptr<Cell> start = randomOpenCell(maze, rng);
+        std::vector<std::shared_ptr<Cell>> targets;
+        for (int i = 0; i < k; ++i)
+          targets.push_back(randomOpenCell(maze, rng));
+
+        std::vector<PathCost> costs;
+        std::vector<std::uint64_t> lengths;
+        for (const auto &target : targets) {
+          astar.findPath(maze, context, start, target);
+          loopMs += context.getStats().executionTime.count();
+          costs.push_back(static_cast<PathCost>(context.getStats().pathCost));
+          lengths.push_back(context.getStats().pathLength);
+        }
+
+        const std::vector<PathCost> distances =
+            dijkstra.distancesTo(maze, context, start, targets);
+        sweepMs += context.getStats().executionTime.count();
+        expanded += context.getStats().nodesExplored;
+        std::vector<std::vector<Cell>> paths;
+        dijkstra.distancesTo(maze, context, start, targets, &paths);
+        pathsMs += context.getStats().executionTime.count();
+
+        for (int i = 0; i < k; ++i) {
+          if (distances[i] != costs[i] || paths[i].size() != lengths[i])
+            ++mismatches;
+        }
+      }
+
+      std::cout << std::left << std::setw(10) << entry.first << std::right
+                << std::setw(6) << k << std::fixed << std::setprecision(2)
+                << std::setw(12) << loopMs / starts << std::setw(11)
+                << sweepMs / starts << std::setw(10) << pathsMs / starts
+                << std::setw(9) << loopMs / sweepMs
+                << "x" << std::setw(11) << expanded / starts << std::endl;
+    }
+  }
+
+  if (mismatches > 0) {
+    std::cerr << "Error: " << mismatches << " results differ from A*"
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
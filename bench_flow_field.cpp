@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AStarPathfinder.h"
+#include "BenchUtil.h"
+#include "FlowFieldCache.h"
+#include "FlowFieldPathfinder.h"
+#include "Maze.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Measures the amortised cost of flow fields for crowds of agents
+ * heading for a few shared goals.
+ *
+ * On a perfect maze and on a maze with cycles, picks a few goals and, for
+ * 1, 100 and 10,000 agents at random open cells (fixed seed), routes every
+ * agent to one of the goals with FlowFieldPathfinder, starting each run
+ * with an empty cache. The time per agent includes building the fields. A* is
+ * timed on the first agents and its path costs are compared. Finally runs
+ * agents for more goals than the cache can hold, grouped by goal and
+ * interleaved, to show LRU eviction.
+ *
+ * Usage: bench_flow_field [size] [goals]   (default: 1001 4)
+ */
+
+namespace {
+
+struct Agent {
+  std::shared_ptr<Cell> start;
+  std::shared_ptr<Cell> goal;
+};
+
+// Route every agent through one pathfinder and context; total milliseconds
+double routeAll(const Maze &maze, const PathFinder &pathfinder,
+                const std::vector<Agent> &agents) {
+  SearchContext context;
+  auto start = Clock::now();
+  for (const Agent &agent : agents)
+    pathfinder.findPath(maze, context, agent.start, agent.goal);
+  return millisecondsSince(start);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int goalCount = intArgument(argc, argv, 2, 4);
+  const int sampled = 100; // Agents routed with A*
+
+  std::mt19937 rng(12345);
+  std::vector<std::shared_ptr<Cell>> goals;
+  std::vector<Agent> agents;
+  auto placeAgents = [&](const Maze &maze) {
+    goals.clear();
+    for (int i = 0; i < 2 * goalCount; ++i)
+      goals.push_back(randomOpenCell(maze, rng));
+    agents.clear();
+    for (int i = 0; i < 10000; ++i)
+      agents.push_back({randomOpenCell(maze, rng), goals[i % goalCount]});
+  };
+
+  std::cout << "=== Flow fields: " << size << "x" << size << " mazes, "
+            << goalCount << " goals ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(14) << "Maze" << std::setw(8)
+            << "Agents" << std::right << std::setw(8) << "Built"
+            << std::setw(12) << "Total ms" << std::setw(14) << "Per agent us"
+            << std::setw(12) << "A* us" << std::setw(10) << "Speedup"
+            << std::endl;
+  std::cout << std::string(78, '-') << std::endl;
+
+  int mismatches = 0;
+  Maze perfect;
+  perfect.generatePerfectMaze(size, size);
+  Maze maze;
+  maze.generate(size, size);
+  const std::pair<const char *, const Maze *> mazes[] = {
+      {"perfect", &perfect}, {"generate", &maze}};
+  SearchContext context;
+  for (const auto &entry : mazes) {
+    const Maze &current = *entry.second;
+    placeAgents(current);
+
+    // A* on the first agents, for the time per agent and the path costs
+    AStarPathfinder astar;
+    std::vector<std::uint64_t> costs;
+    double astarMs = 0.0;
+    for (int i = 0; i < sampled; ++i) {
+      astar.findPath(current, context, agents[i].start, agents[i].goal);
+      astarMs += context.getStats().executionTime.count();
+      costs.push_back(context.getStats().pathCost);
+    }
+    const double astarUs = astarMs * 1000.0 / sampled;
+
+    for (int count : {1, 100, 10000}) {
+      auto cache = std::make_shared<FlowFieldCache>(std::size_t{1} << 30);
+      FlowFieldPathfinder flow(cache);
+      const std::vector<Agent> crowd(agents.begin(), agents.begin() + count);
+      const double totalMs = routeAll(current, flow, crowd);
+      const double perAgentUs = totalMs * 1000.0 / count;
+
+      for (int i = 0; i < std::min(count, sampled); ++i) {
+        flow.findPath(current, context, crowd[i].start, crowd[i].goal);
+        if (context.getStats().pathCost != costs[i])
+          ++mismatches;
+      }
+
+      std::cout << std::left << std::setw(14) << entry.first << std::setw(8)
+                << count << std::right << std::setw(8) << cache->getMisses()
+                << std::fixed << std::setprecision(1) << std::setw(12)
+                << totalMs << std::setw(14) << perAgentUs << std::setw(12)
+                << astarUs << std::setprecision(2) << std::setw(9)
+                << astarUs / perAgentUs << "x" << std::endl;
+    }
+  }
+
+  // Twice as many goals as fit in the cache, on the last maze: agents
+  // grouped by goal build each field once, interleaved agents evict a
+  // field before its next use
+  const std::size_t fieldBytes = FlowField(maze, 0).getMemoryBytes();
+  std::vector<Agent> interleaved;
+  for (int i = 0; i < 200; ++i)
+    interleaved.push_back({agents[i].start, goals[i % goals.size()]});
+  std::vector<Agent> grouped = interleaved;
+  std::stable_sort(grouped.begin(), grouped.end(),
+                   [](const Agent &a, const Agent &b) {
+                     return std::make_pair(a.goal->getX(), a.goal->getY()) <
+                            std::make_pair(b.goal->getX(), b.goal->getY());
+                   });
+
+  std::cout << std::endl;
+  std::cout << "200 agents on the generate() maze, " << goals.size()
+            << " goals, budget of " << goalCount << " fields ("
+            << std::fixed << std::setprecision(1)
+            << goalCount * fieldBytes / (1024.0 * 1024.0) << " MiB):"
+            << std::endl;
+  const std::pair<const char *, const std::vector<Agent> *> orders[] = {
+      {"grouped by goal", &grouped}, {"interleaved", &interleaved}};
+  for (const auto &order : orders) {
+    auto cache = std::make_shared<FlowFieldCache>(goalCount * fieldBytes);
+    FlowFieldPathfinder flow(cache);
+    const double totalMs = routeAll(maze, flow, *order.second);
+    std::cout << "  " << std::left << std::setw(17) << order.first
+              << std::right << std::setw(6) << cache->getMisses()
+              << " built" << std::setw(6) << cache->getEvictions()
+              << " evicted" << std::setw(10) << std::setprecision(1)
+              << totalMs * 1000.0 / order.second->size() << " us per agent"
+              << std::endl;
+    if (cache->getMemoryBytes() > cache->getCapacityBytes())
+      ++mismatches;
+  }
+
+  if (mismatches > 0) {
+    std::cerr << "Error: " << mismatches << " results differ from A*"
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
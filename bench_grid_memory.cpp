@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "Maze.h"
+
+/**
+ * @brief Measures the memory cost per cell of the maze grid storage.
+ *
+ * Compares the flat Maze planes against the previous layout (a vector of
+ * rows of std::shared_ptr<Cell>, one heap allocation per cell), which is
+ * rebuilt here for reference. Heap bytes (including allocator overhead) are
+ * read from glibc's mallinfo2() and resident set size from /proc, where
+ * available.
+ *
+ * Usage: bench_grid_memory [size...]   (square grids, default: 100 4096)
+ */
+
+namespace {
+
+// Cell as laid out before the flat storage planes
+struct LegacyCell {
+  Coordinate coords;
+  bool wall = false;
+  bool visited = false;
+  bool path = false;
+};
+
+std::size_t heapBytes() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+#else
+  return 0;
+#endif
+}
+
+std::size_t residentBytes() {
+#ifdef __linux__
+  std::FILE *statm = std::fopen("/proc/self/statm", "r");
+  if (!statm)
+    return 0;
+  unsigned long size = 0, resident = 0;
+  int read = std::fscanf(statm, "%lu %lu", &size, &resident);
+  std::fclose(statm);
+  return read == 2 ? resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE))
+                   : 0;
+#else
+  return 0;
+#endif
+}
+
+struct Measurement {
+  bool ok = false;
+  double heapPerCell = 0.0;
+  double rssPerCell = 0.0;
+};
+
+template <typename Build> Measurement measure(int size, Build build) {
+  const double cells = static_cast<double>(size) * size;
+  const std::size_t heapBefore = heapBytes();
+  const std::size_t rssBefore = residentBytes();
+
+  Measurement m;
+  try {
+    auto grid = build(size);
+    m.heapPerCell = (static_cast<double>(heapBytes()) - heapBefore) / cells;
+    m.rssPerCell = (static_cast<double>(residentBytes()) - rssBefore) / cells;
+    m.ok = true;
+  } catch (const std::exception &e) {
+    std::cerr << "  (" << size << "x" << size << ": " << e.what() << ")\n";
+  }
+  return m;
+}
+
+void printRow(const std::string &layout, int size, const Measurement &m) {
+  std::cout << std::left << std::setw(28) << layout << std::right
+            << std::setw(12) << (std::to_string(size) + "x" +
+                                 std::to_string(size));
+  if (m.ok) {
+    std::cout << std::setw(18) << std::fixed << std::setprecision(2)
+              << m.heapPerCell << std::setw(18) << m.rssPerCell << "\n";
+  } else {
+    std::cout << std::setw(18) << "n/a" << std::setw(18) << "n/a" << "\n";
+  }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::vector<int> sizes;
+  for (int i = 1; i < argc; ++i) {
+    sizes.push_back(std::atoi(argv[i]));
+  }
+  if (sizes.empty()) {
+    sizes = {100, 4096};
+  }
+
+  std::cout << "=== Grid storage memory per cell ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(28) << "Layout" << std::right
+            << std::setw(12) << "Grid" << std::setw(18) << "Heap B/cell"
+            << std::setw(18) << "RSS B/cell" << std::endl;
+  std::cout << std::string(76, '-') << std::endl;
+
+  for (int size : sizes) {
+    Measurement legacy = measure(size, [](int n) {
+      std::vector<std::vector<std::shared_ptr<LegacyCell>>> grid(n);
+      for (int y = 0; y < n; ++y) {
+        grid[y].resize(n);
+        for (int x = 0; x < n; ++x) {
+          grid[y][x] = std::make_shared<LegacyCell>();
+          grid[y][x]->coords = {x, y};
+        }
+      }
+      return grid;
+    });
+    printRow("vector<vector<shared_ptr>>", size, legacy);
+
+    Measurement flat = measure(size, [](int n) {
+      return std::make_unique<Maze>(n, n);
+    });
+    printRow("Maze (flat planes)", size, flat);
+  }
+
+  return 0;
+}
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AStarPathfinder.h"
+#include "BenchUtil.h"
+#include "ClusterGraph.h"
+#include "HPAStarPathfinder.h"
+#include "Maze.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Measures HPA* preprocessing, query speed and path quality against
+ * A*.
+ *
+ * Generates a maze, builds its cluster graph, then runs the same random
+ * queries (between open cells, fixed seed) with A* and HPA*, each reusing
+ * one SearchContext. Path lengths of HPA* are compared with the shortest
+ * ones found by A*. Finally random cells are toggled between wall and open
+ * and the graph is updated after each change.
+ *
+ * Usage: bench_hpa [size] [queries] [layout] [cluster size]
+ *        (default: 1001 100 rooms 32; layout as for bench_throughput)
+ */
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int queries = intArgument(argc, argv, 2, 100);
+  const std::string layout = textArgument(argc, argv, 3, "rooms");
+  const int clusterSize = intArgument(argc, argv, 4, 32);
+  if (!isLayout(layout) || layout == "terrain") {
+    std::cerr << "Unknown layout: " << layout << std::endl;
+    return 1;
+  }
+  if (clusterSize < 2) {
+    std::cerr << "Cluster size must be at least 2" << std::endl;
+    return 1;
+  }
+
+  std::mt19937 rng(12345);
+  Maze maze;
+  generateLayout(maze, size, layout, rng);
+
+  auto buildStart = Clock::now();
+  auto graph = std::make_shared<ClusterGraph>(maze, clusterSize);
+  const double buildMs = millisecondsSince(buildStart);
+
+  std::vector<std::pair<std::shared_ptr<Cell>, std::shared_ptr<Cell>>> pairs;
+  for (int i = 0; i < queries; ++i)
+    pairs.push_back({randomOpenCell(maze, rng), randomOpenCell(maze, rng)});
+
+  std::vector<std::pair<std::string, std::unique_ptr<PathFinder>>> algorithms;
+  algorithms.push_back({"A*", std::make_unique<AStarPathfinder>()});
+  algorithms.push_back({"HPA*", std::make_unique<HPAStarPathfinder>(graph)});
+
+  std::vector<double> milliseconds(algorithms.size(), 0.0);
+  std::vector<double> nodes(algorithms.size(), 0.0);
+  std::vector<std::uint64_t> lengths(pairs.size());
+  double totalExcess = 0.0;
+  double worstExcess = 0.0;
+  int failures = 0;
+
+  for (std::size_t i = 0; i < algorithms.size(); ++i) {
+    SearchContext context;
+    for (std::size_t q = 0; q < pairs.size(); ++q) {
+      algorithms[i].second->findPath(maze, context, pairs[q].first,
+                                     pairs[q].second);
+      const PathStats &stats = context.getStats();
+      milliseconds[i] += stats.executionTime.count();
+      nodes[i] += static_cast<double>(stats.nodesExplored);
+      if (i == 0) {
+        lengths[q] = stats.pathLength;
+      } else if ((stats.pathLength == 0) != (lengths[q] == 0) ||
+                 stats.pathLength < lengths[q]) {
+        ++failures;
+      } else if (lengths[q] > 1) {
+        // Excess steps over the shortest path
+        const double excess =
+            static_cast<double>(stats.pathLength - lengths[q]) /
+            static_cast<double>(lengths[q] - 1);
+        totalExcess += excess;
+        worstExcess = std::max(worstExcess, excess);
+      }
+    }
+  }
+
+  // Toggle random cells and restore them, updating the graph each time
+  const int edits = 100;
+  double updateMs = 0.0;
+  std::size_t rebuilt = 0;
+  std::uniform_int_distribution<int> coordinate(0, size - 1);
+  for (int i = 0; i < edits; ++i) {
+    const int x = coordinate(rng);
+    const int y = coordinate(rng);
+    for (int pass = 0; pass < 2; ++pass) {
+      maze.setWall(x, y, !maze.isWall(x, y));
+      auto updateStart = Clock::now();
+      rebuilt += graph->update(maze, x, y);
+      updateMs += millisecondsSince(updateStart);
+    }
+  }
+
+  std::cout << "=== HPA*: " << size << "x" << size << " " << layout
+            << " maze, " << queries << " random queries, " << clusterSize
+            << "x" << clusterSize << " clusters ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "Cluster graph: " << graph->getClusterCount() << " clusters, "
+            << graph->getNodeCount() << " nodes, "
+            << graph->getMemoryBytes() / (1024.0 * 1024.0) << " MiB, built in "
+            << buildMs << " ms" << std::endl;
+  std::cout << "Wall edit: " << std::setprecision(2)
+            << static_cast<double>(rebuilt) / (2 * edits)
+            << " clusters rebuilt, " << std::setprecision(3)
+            << updateMs / (2 * edits) << " ms" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(12) << "Algorithm" << std::right
+            << std::setw(16) << "Nodes/query" << std::setw(16) << "ms/query"
+            << std::setw(18) << "Speedup vs A*" << std::endl;
+  std::cout << std::string(62, '-') << std::endl;
+
+  for (std::size_t i = 0; i < algorithms.size(); ++i) {
+    std::cout << std::left << std::setw(12) << algorithms[i].first
+              << std::right << std::setprecision(0) << std::setw(16)
+              << nodes[i] / queries << std::setprecision(3) << std::setw(16)
+              << milliseconds[i] / queries << std::setprecision(2)
+              << std::setw(17) << milliseconds[0] / milliseconds[i] << "x"
+              << std::endl;
+  }
+  std::cout << std::endl;
+  std::cout << std::setprecision(1) << "HPA* path length over shortest: "
+            << 100.0 * totalExcess / queries << "% on average, "
+            << 100.0 * worstExcess << "% at worst" << std::endl;
+
+  if (failures > 0) {
+    std::cerr << "Error: " << failures
+              << " HPA* paths missing or shorter than A*" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,115 @@
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AStarPathfinder.h"
+#include "BenchUtil.h"
+#include "JPSPathfinder.h"
+#include "JPSPlusPathfinder.h"
+#include "JumpPointTable.h"
+#include "Maze.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Measures JPS+ preprocessing and query speed against A* and JPS.
+ *
+ * Generates a maze, builds its jump table, saves and reloads it, then runs
+ * the same random queries (between open cells, fixed seed) with A*, JPS and
+ * JPS+. Each algorithm reuses one SearchContext, as a server answering many
+ * queries on a static map would. Path lengths are checked against A*.
+ *
+ * Usage: bench_jps_plus [size] [queries] [layout]   (default: 1001 200 rooms)
+ * The layout is "perfect", "rooms" or "open", as for bench_throughput.
+ */
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int queries = intArgument(argc, argv, 2, 200);
+  const std::string layout = textArgument(argc, argv, 3, "rooms");
+  if (!isLayout(layout) || layout == "terrain") {
+    std::cerr << "Unknown layout: " << layout << std::endl;
+    return 1;
+  }
+
+  std::mt19937 rng(12345);
+  Maze maze;
+  generateLayout(maze, size, layout, rng);
+
+  auto buildStart = Clock::now();
+  auto table = std::make_shared<JumpPointTable>(maze);
+  const double buildMs = millisecondsSince(buildStart);
+
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "bench_jps_plus.jps").string();
+  if (!table->saveToFile(path))
+    return 1;
+  auto loadStart = Clock::now();
+  auto loaded = std::make_shared<JumpPointTable>();
+  if (!loaded->loadFromFile(path, maze))
+    return 1;
+  const double loadMs = millisecondsSince(loadStart);
+
+  std::vector<std::pair<std::shared_ptr<Cell>, std::shared_ptr<Cell>>> pairs;
+  for (int i = 0; i < queries; ++i)
+    pairs.push_back({randomOpenCell(maze, rng), randomOpenCell(maze, rng)});
+
+  std::vector<std::pair<std::string, std::unique_ptr<PathFinder>>> algorithms;
+  algorithms.push_back({"A*", std::make_unique<AStarPathfinder>()});
+  algorithms.push_back({"JPS", std::make_unique<JPSPathfinder>()});
+  algorithms.push_back({"JPS+", std::make_unique<JPSPlusPathfinder>(loaded)});
+
+  std::vector<double> milliseconds(algorithms.size(), 0.0);
+  std::vector<double> nodes(algorithms.size(), 0.0);
+  std::vector<std::uint64_t> lengths(pairs.size());
+  int mismatches = 0;
+
+  for (std::size_t i = 0; i < algorithms.size(); ++i) {
+    SearchContext context;
+    for (std::size_t q = 0; q < pairs.size(); ++q) {
+      algorithms[i].second->findPath(maze, context, pairs[q].first,
+                                     pairs[q].second);
+      const PathStats &stats = context.getStats();
+      milliseconds[i] += stats.executionTime.count();
+      nodes[i] += static_cast<double>(stats.nodesExplored);
+      if (i == 0)
+        lengths[q] = stats.pathLength;
+      else if (stats.pathLength != lengths[q])
+        ++mismatches;
+    }
+  }
+  std::remove(path.c_str());
+
+  std::cout << "=== JPS+: " << size << "x" << size << " " << layout
+            << " maze, " << queries << " random queries ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "Jump table: " << table->getMemoryBytes() / (1024.0 * 1024.0)
+            << " MiB, built in " << buildMs << " ms, loaded in "
+            << std::setprecision(2) << loadMs << " ms" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(12) << "Algorithm" << std::right
+            << std::setw(16) << "Nodes/query" << std::setw(16) << "ms/query"
+            << std::setw(18) << "Speedup vs A*" << std::endl;
+  std::cout << std::string(62, '-') << std::endl;
+
+  for (std::size_t i = 0; i < algorithms.size(); ++i) {
+    std::cout << std::left << std::setw(12) << algorithms[i].first
+              << std::right << std::setprecision(0) << std::setw(16)
+              << nodes[i] / queries << std::setprecision(3) << std::setw(16)
+              << milliseconds[i] / queries << std::setprecision(2)
+              << std::setw(17) << milliseconds[0] / milliseconds[i] << "x"
+              << std::endl;
+  }
+
+  if (mismatches > 0) {
+    std::cerr << "Error: " << mismatches << " path lengths differ from A*"
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
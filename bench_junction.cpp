@@ -0,0 +1,106 @@
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AStarPathfinder.h"
+#include "BenchUtil.h"
+#include "JunctionGraph.h"
+#include "JunctionPathfinder.h"
+#include "Maze.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Measures corridor contraction and junction-graph search against A*
+ * for each maze generator.
+ *
+ * For every MazeGenerationAlgorithm, generates a maze, builds its
+ * JunctionGraph and runs the same random queries (between open cells,
+ * fixed seed) with A* and JunctionPathfinder, each reusing one
+ * SearchContext. Path lengths are checked against A*.
+ *
+ * Usage: bench_junction [size] [queries]   (default: 1001 200)
+ */
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int queries = intArgument(argc, argv, 2, 200);
+
+  const std::pair<const char *, MazeGenerationAlgorithm> generators[] = {
+      {"backtracking", MazeGenerationAlgorithm::RECURSIVE_BACKTRACKING},
+      {"prims", MazeGenerationAlgorithm::RANDOMIZED_PRIMS},
+      {"division", MazeGenerationAlgorithm::RECURSIVE_DIVISION}};
+
+  std::cout << "=== Junction graph: " << size << "x" << size << " mazes, "
+            << queries << " random queries ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(14) << "Generator" << std::right
+            << std::setw(12) << "Open cells" << std::setw(11) << "Nodes"
+            << std::setw(8) << "Ratio" << std::setw(8) << "MiB"
+            << std::setw(10) << "Build ms" << std::setw(12) << "A* ms"
+            << std::setw(12) << "Graph ms" << std::setw(10) << "Speedup"
+            << std::endl;
+  std::cout << std::string(97, '-') << std::endl;
+
+  int mismatches = 0;
+  for (const auto &generator : generators) {
+    Maze maze;
+    maze.generatePerfectMaze(size, size, generator.second);
+    std::uint64_t openCells = 0;
+    for (int y = 0; y < size; ++y)
+      for (int x = 0; x < size; ++x)
+        openCells += !maze.isWall(x, y);
+
+    auto buildStart = Clock::now();
+    auto graph = std::make_shared<JunctionGraph>(maze);
+    const double buildMs = millisecondsSince(buildStart);
+
+    std::mt19937 rng(12345);
+    std::vector<std::pair<std::shared_ptr<Cell>, std::shared_ptr<Cell>>>
+        pairs;
+    for (int i = 0; i < queries; ++i)
+      pairs.push_back({randomOpenCell(maze, rng), randomOpenCell(maze, rng)});
+
+    AStarPathfinder astar;
+    JunctionPathfinder junction(graph);
+    const PathFinder *algorithms[] = {&astar, &junction};
+    double milliseconds[2] = {0.0, 0.0};
+    std::vector<std::uint64_t> lengths(pairs.size());
+    for (int i = 0; i < 2; ++i) {
+      SearchContext context;
+      for (std::size_t q = 0; q < pairs.size(); ++q) {
+        algorithms[i]->findPath(maze, context, pairs[q].first,
+                                pairs[q].second);
+        const PathStats &stats = context.getStats();
+        milliseconds[i] += stats.executionTime.count();
+        if (i == 0)
+          lengths[q] = stats.pathLength;
+        else if (stats.pathLength != lengths[q])
+          ++mismatches;
+      }
+    }
+
+    std::cout << std::left << std::setw(14) << generator.first << std::right
+              << std::setw(12) << openCells << std::setw(11)
+              << graph->getNodeCount() << std::fixed << std::setprecision(1)
+              << std::setw(7)
+              << static_cast<double>(openCells) /
+                     static_cast<double>(graph->getNodeCount())
+              << "x" << std::setw(8)
+              << graph->getMemoryBytes() / (1024.0 * 1024.0) << std::setw(10)
+              << buildMs << std::setprecision(3) << std::setw(12)
+              << milliseconds[0] / queries << std::setw(12)
+              << milliseconds[1] / queries << std::setprecision(2)
+              << std::setw(9) << milliseconds[0] / milliseconds[1] << "x"
+              << std::endl;
+  }
+
+  if (mismatches > 0) {
+    std::cerr << "Error: " << mismatches << " path lengths differ from A*"
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
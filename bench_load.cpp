@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "AStarPathfinder.h"
+#include "Maze.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Measures time to first query for the text, binary and PBM formats.
+ *
+ * Generates a perfect maze, saves it in each format (the PBM image as P4,
+ * with start and goal in its sidecar file), then for each format loads it
+ * into a fresh Maze and solves it once with A* (start to goal).
+ * The files were just written, so they are read from the page cache; the
+ * times exclude disk latency.
+ *
+ * Usage: bench_load [size] [directory]   (default: 10000, system temp dir)
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+enum class Format { TEXT, BINARY, BINARY_VERIFIED, IMAGE };
+
+// Write a maze as a binary PBM (P4) image plus its start/goal sidecar
+bool writePbm(const Maze &maze, const std::string &filename) {
+  std::ofstream file(filename, std::ios::binary);
+  file << "P4\n" << maze.getWidth() << " " << maze.getHeight() << "\n";
+  std::string row((maze.getWidth() + 7) / 8, '\0');
+  for (int y = 0; y < maze.getHeight(); ++y) {
+    std::fill(row.begin(), row.end(), '\0');
+    for (int x = 0; x < maze.getWidth(); ++x) {
+      if (maze.isWall(x, y))
+        row[x / 8] = static_cast<char>(row[x / 8] | (0x80 >> (x % 8)));
+    }
+    file << row;
+  }
+
+  std::ofstream sidecar(filename + ".sg");
+  auto start = maze.getStart();
+  auto goal = maze.getGoal();
+  sidecar << "start " << start->getX() << " " << start->getY() << "\n"
+          << "goal " << goal->getX() << " " << goal->getY() << "\n";
+  return file && sidecar;
+}
+
+bool measure(const std::string &label, const std::string &filename,
+             Format format) {
+  const auto begin = Clock::now();
+
+  Maze maze;
+  bool loaded = false;
+  switch (format) {
+  case Format::TEXT:
+    loaded = maze.loadFromFile(filename);
+    break;
+  case Format::BINARY:
+  case Format::BINARY_VERIFIED:
+    loaded =
+        maze.loadFromBinaryFile(filename, format == Format::BINARY_VERIFIED);
+    break;
+  case Format::IMAGE:
+    loaded = maze.loadFromImageFile(filename);
+    break;
+  }
+  if (!loaded)
+    return false;
+  const double loadMs = millisecondsSince(begin);
+
+  const auto queryBegin = Clock::now();
+  SearchContext context;
+  AStarPathfinder finder;
+  auto path =
+      finder.findPath(maze, context, maze.getStart(), maze.getGoal());
+  const double queryMs = millisecondsSince(queryBegin);
+  if (path.empty()) {
+    std::cerr << "Error: No path found in " << filename << std::endl;
+    return false;
+  }
+
+  std::cout << std::left << std::setw(22) << label << std::right << std::fixed
+            << std::setprecision(1) << std::setw(12) << loadMs << std::setw(14)
+            << queryMs << std::setw(14) << loadMs + queryMs << std::endl;
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const int size = argc > 1 ? std::atoi(argv[1]) : 10000;
+  const std::filesystem::path directory =
+      argc > 2 ? std::filesystem::path(argv[2])
+               : std::filesystem::temp_directory_path();
+  const std::string textFile = (directory / "bench_load.txt").string();
+  const std::string binaryFile = (directory / "bench_load.mazb").string();
+  const std::string imageFile = (directory / "bench_load.pbm").string();
+
+  {
+    Maze maze;
+    maze.generatePerfectMaze(size, size,
+                             MazeGenerationAlgorithm::RECURSIVE_BACKTRACKING);
+    if (!maze.saveToFile(textFile) || !maze.saveToBinaryFile(binaryFile) ||
+        !writePbm(maze, imageFile))
+      return 1;
+  }
+
+  std::cout << "=== Time to first query: " << size << "x" << size
+            << " ===" << std::endl;
+  std::cout << "text file:   " << std::filesystem::file_size(textFile)
+            << " bytes" << std::endl;
+  std::cout << "binary file: " << std::filesystem::file_size(binaryFile)
+            << " bytes" << std::endl;
+  std::cout << "PBM file:    " << std::filesystem::file_size(imageFile)
+            << " bytes" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(22) << "Format" << std::right
+            << std::setw(12) << "Load ms" << std::setw(14) << "Query ms"
+            << std::setw(14) << "Total ms" << std::endl;
+  std::cout << std::string(62, '-') << std::endl;
+
+  const bool ok =
+      measure("text", textFile, Format::TEXT) &&
+      measure("binary (mmap)", binaryFile, Format::BINARY) &&
+      measure("binary + checksum", binaryFile, Format::BINARY_VERIFIED) &&
+      measure("PBM (P4)", imageFile, Format::IMAGE);
+
+  std::filesystem::remove(textFile);
+  std::filesystem::remove(binaryFile);
+  std::filesystem::remove(imageFile);
+  std::filesystem::remove(imageFile + ".sg");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "DijkstraPathfinder.h"
+#include "DistanceTransform.h"
+#include "Maze.h"
+#include "MazeVisualizer.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Measures nearest-source queries and distance transforms.
+ *
+ * First shows the heatmap of a small maze with an exit at each corner.
+ * Then, on a perfect maze and on a maze with cycles, picks random sources
+ * and starts (open cells, fixed seed) and times: building the
+ * DistanceTransform (first build and rebuild into the same arrays), a
+ * lookup in it, DistanceTransform::nearestSource() with early exit, and
+ * one DijkstraPathfinder::distancesTo() sweep from the start to all
+ * sources. All three must agree on the distance.
+ *
+ * Usage: bench_nearest [size] [sources] [starts]   (default: 1001 64 100)
+ */
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int sourceCount = intArgument(argc, argv, 2, 64);
+  const int starts = intArgument(argc, argv, 3, 100);
+
+  // Exits in the corners of a small maze
+  Maze small;
+  small.generatePerfectMaze(41, 15);
+  std::vector<CellIndex> exits;
+  for (Coordinate corner : {Coordinate{1, 1}, Coordinate{39, 1},
+                            Coordinate{1, 13}, Coordinate{39, 13}}) {
+    small.setWall(corner.x, corner.y, false);
+    exits.push_back(small.indexOf(corner.x, corner.y));
+  }
+  std::cout << "Distance to the nearest exit (X):" << std::endl;
+  MazeVisualizer::displayDistanceHeatmap(small,
+                                         DistanceTransform(small, exits));
+
+  std::cout << "=== Nearest of " << sourceCount << " sources: " << size << "x"
+            << size << " mazes, " << starts << " starts ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(10) << "Maze" << std::right
+            << std::setw(10) << "Build ms" << std::setw(12) << "Rebuild ms"
+            << std::setw(8) << "MiB" << std::setw(11) << "Lookup us"
+            << std::setw(12) << "Nearest ms" << std::setw(11) << "Expanded"
+            << std::setw(10) << "Sweep ms" << std::endl;
+  std::cout << std::string(84, '-') << std::endl;
+
+  Maze perfect;
+  perfect.generatePerfectMaze(size, size);
+  Maze cyclic;
+  cyclic.generate(size, size);
+  const std::pair<const char *, const Maze *> mazes[] = {
+      {"perfect", &perfect}, {"generate", &cyclic}};
+
+  int mismatches = 0;
+  std::mt19937 rng(12345);
+  DijkstraPathfinder dijkstra(OpenList::BUCKETS);
+  SearchContext context;
+  for (const auto &entry : mazes) {
+    const Maze &maze = *entry.second;
+    std::vector<std::shared_ptr<Cell>> sourceCells;
+    std::vector<CellIndex> sources;
+    for (int i = 0; i < sourceCount; ++i) {
+      sourceCells.push_back(randomOpenCell(maze, rng));
+      sources.push_back(maze.indexOf(sourceCells.back()->getX(),
+                                     sourceCells.back()->getY()));
+    }
+
+    auto buildStart = Clock::now();
+    DistanceTransform transform(maze, sources);
+    const double buildMs = millisecondsSince(buildStart);
+    auto rebuildStart = Clock::now();
+    transform.build(maze, sources);
+    const double rebuildMs = millisecondsSince(rebuildStart);
+
+    std::vector<std::shared_ptr<Cell>> startCells;
+    std::vector<CellIndex> startIndexes;
+    for (int s = 0; s < starts; ++s) {
+      startCells.push_back(randomOpenCell(maze, rng));
+      startIndexes.push_back(
+          maze.indexOf(startCells.back()->getX(), startCells.back()->getY()));
+    }
+
+    // Lookups are timed together; one alone is below the clock's resolution
+    std::vector<std::uint32_t> nearest(starts);
+    std::vector<PathCost> distance(starts);
+    auto lookupStart = Clock::now();
+    for (int s = 0; s < starts; ++s) {
+      nearest[s] = transform.getNearest(startIndexes[s]);
+      distance[s] = transform.getDistance(startIndexes[s]);
+    }
+    const double lookupMs = millisecondsSince(lookupStart);
+
+    double nearestMs = 0.0, sweepMs = 0.0;
+    std::uint64_t expanded = 0;
+    for (int s = 0; s < starts; ++s) {
+      const std::uint32_t found = DistanceTransform::nearestSource(
+          maze, context, sources, startIndexes[s]);
+      nearestMs += context.getStats().executionTime.count();
+      expanded += context.getStats().nodesExplored;
+      if (found != nearest[s] || context.getStats().pathCost != distance[s])
+        ++mismatches;
+
+      const std::vector<PathCost> distances =
+          dijkstra.distancesTo(maze, context, startCells[s], sourceCells);
+      sweepMs += context.getStats().executionTime.count();
+      if (*std::min_element(distances.begin(), distances.end()) !=
+          distance[s])
+        ++mismatches;
+    }
+
+    std::cout << std::left << std::setw(10) << entry.first << std::right
+              << std::fixed << std::setprecision(1) << std::setw(10)
+              << buildMs << std::setw(12) << rebuildMs << std::setw(8)
+              << transform.getMemoryBytes() / (1024.0 * 1024.0)
+              << std::setprecision(3) << std::setw(11)
+              << lookupMs * 1000.0 / starts << std::setw(12)
+              << nearestMs / starts << std::setw(11) << expanded / starts
+              << std::setw(10) << sweepMs / starts << std::endl;
+  }
+
+  if (mismatches > 0) {
+    std::cerr << "Error: " << mismatches << " results disagree" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,110 @@
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AStarPathfinder.h"
+#include "BFSPathfinder.h"
+#include "BenchUtil.h"
+#include "BidirectionalBFSPathfinder.h"
+#include "DFSPathfinder.h"
+#include "DijkstraPathfinder.h"
+#include "JPSPathfinder.h"
+#include "Maze.h"
+
+/**
+ * @brief Measures search throughput (expanded nodes per second).
+ *
+ * Each algorithm solves the same mazes (corner to corner); times are the
+ * executionTime reported in PathStats, summed over all trials. The layout is
+ * "perfect" (recursive backtracking), "rooms" (recursive division) or
+ * "open" (Maze::generate, an open grid with scattered pillars). "terrain"
+ * is the open grid with random terrain costs of 1-9; only Dijkstra and A*
+ * take the costs into account.
+ *
+ * With moves = 8 the searches are 8-connected (no corner cutting), and the
+ * searches that are 4-connected only are left out.
+ *
+ * Usage: bench_throughput [size] [trials] [layout] [moves]
+ *        (default: 1001 5 perfect 4)
+ */
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int trials = intArgument(argc, argv, 2, 5);
+  const std::string layout = textArgument(argc, argv, 3, "perfect");
+  const std::string moves = textArgument(argc, argv, 4, "4");
+  if (!isLayout(layout)) {
+    std::cerr << "Unknown layout: " << layout << std::endl;
+    return 1;
+  }
+  if (moves != "4" && moves != "8") {
+    std::cerr << "Moves must be 4 or 8" << std::endl;
+    return 1;
+  }
+  const bool diagonal = moves == "8";
+  Movement movement;
+  if (diagonal)
+    movement.connectivity = Connectivity::EIGHT;
+
+  std::vector<std::pair<std::string, std::unique_ptr<PathFinder>>> algorithms;
+  algorithms.push_back({"BFS", std::make_unique<BFSPathfinder>()});
+  if (!diagonal)
+    algorithms.push_back(
+        {"Bidir. BFS", std::make_unique<BidirectionalBFSPathfinder>()});
+  algorithms.push_back({"DFS", std::make_unique<DFSPathfinder>()});
+  algorithms.push_back({"Dijkstra", std::make_unique<DijkstraPathfinder>()});
+  algorithms.push_back(
+      {"Dijkstra/B", std::make_unique<DijkstraPathfinder>(OpenList::BUCKETS)});
+  algorithms.push_back({"A*", std::make_unique<AStarPathfinder>()});
+  algorithms.push_back(
+      {"A*/B", std::make_unique<AStarPathfinder>(OpenList::BUCKETS)});
+  if (!diagonal)
+    algorithms.push_back({"JPS", std::make_unique<JPSPathfinder>()});
+  for (auto &algorithm : algorithms)
+    algorithm.second->setMovement(movement);
+
+  std::vector<double> milliseconds(algorithms.size(), 0.0);
+  std::vector<double> nodes(algorithms.size(), 0.0);
+  std::vector<double> lengths(algorithms.size(), 0.0);
+
+  std::mt19937 rng(12345);
+
+  for (int trial = 0; trial < trials; ++trial) {
+    Maze maze;
+    generateLayout(maze, size, layout, rng);
+    auto start = maze.getStart();
+    auto goal = maze.getGoal();
+
+    for (std::size_t i = 0; i < algorithms.size(); ++i) {
+      algorithms[i].second->findPath(maze, start, goal);
+      auto stats = algorithms[i].second->getStats();
+      milliseconds[i] += stats.executionTime.count();
+      nodes[i] += static_cast<double>(stats.nodesExplored);
+      lengths[i] += static_cast<double>(stats.pathLength);
+    }
+  }
+
+  std::cout << "=== Search throughput: " << size << "x" << size << ", "
+            << trials << " " << layout << " mazes, " << moves
+            << "-connected ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(12) << "Algorithm" << std::right
+            << std::setw(16) << "Nodes/search" << std::setw(16) << "ms/search"
+            << std::setw(18) << "M nodes/s" << std::setw(12) << "Path len"
+            << std::endl;
+  std::cout << std::string(74, '-') << std::endl;
+
+  for (std::size_t i = 0; i < algorithms.size(); ++i) {
+    std::cout << std::left << std::setw(12) << algorithms[i].first
+              << std::right << std::fixed << std::setprecision(0)
+              << std::setw(16) << nodes[i] / trials << std::setprecision(2)
+              << std::setw(16) << milliseconds[i] / trials << std::setw(18)
+              << nodes[i] / (milliseconds[i] * 1000.0) << std::setprecision(0)
+              << std::setw(12) << lengths[i] / trials << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,152 @@
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AStarPathfinder.h"
+#include "BenchUtil.h"
+#include "Maze.h"
+#include "SearchContext.h"
+#include "TreeIndex.h"
+#include "TreePathfinder.h"
+
+/**
+ * @brief Measures tree-index path and distance queries against A* on
+ * perfect mazes.
+ *
+ * For every MazeGenerationAlgorithm, generates a maze, builds its TreeIndex
+ * and runs the same random queries (between open cells, fixed seed) with
+ * A* and TreePathfinder, each reusing one SearchContext, and with
+ * TreeIndex::distance() alone. Path costs are checked against A*. Finally
+ * checks that the index refuses a maze with cycles and a maze whose walls
+ * changed.
+ *
+ * Usage: bench_tree [size] [queries]   (default: 1001 200)
+ */
+int main(int argc, char *argv[]) {
+  const int size = intArgument(argc, argv, 1, 1001);
+  const int queries = intArgument(argc, argv, 2, 200);
+
+  const std::pair<const char *, MazeGenerationAlgorithm> generators[] = {
+      {"backtracking", MazeGenerationAlgorithm::RECURSIVE_BACKTRACKING},
+      {"prims", MazeGenerationAlgorithm::RANDOMIZED_PRIMS},
+      {"division", MazeGenerationAlgorithm::RECURSIVE_DIVISION}};
+
+  std::cout << "=== Tree index: " << size << "x" << size << " mazes, "
+            << queries << " random queries ===" << std::endl;
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(14) << "Generator" << std::right
+            << std::setw(10) << "Build ms" << std::setw(8) << "MiB"
+            << std::setw(10) << "Path len" << std::setw(11) << "A* ms"
+            << std::setw(11) << "Tree ms" << std::setw(10) << "Speedup"
+            << std::setw(10) << "Steps" << std::setw(13) << "Distance us"
+            << std::endl;
+  std::cout << std::string(97, '-') << std::endl;
+
+  int mismatches = 0;
+  for (const auto &generator : generators) {
+    Maze maze;
+    maze.generatePerfectMaze(size, size, generator.second);
+
+    auto buildStart = Clock::now();
+    auto index = std::make_shared<TreeIndex>(maze);
+    const double buildMs = millisecondsSince(buildStart);
+    if (!index->isTree()) {
+      std::cerr << "Error: " << generator.first << " maze is not a tree"
+                << std::endl;
+      return 1;
+    }
+
+    std::mt19937 rng(12345);
+    std::vector<std::pair<std::shared_ptr<Cell>, std::shared_ptr<Cell>>>
+        pairs;
+    for (int i = 0; i < queries; ++i)
+      pairs.push_back({randomOpenCell(maze, rng), randomOpenCell(maze, rng)});
+
+    AStarPathfinder astar;
+    TreePathfinder treeSearch(index);
+    const PathFinder *algorithms[] = {&astar, &treeSearch};
+    double milliseconds[2] = {0.0, 0.0};
+    std::uint64_t pathLength = 0;
+    std::uint64_t steps = 0;
+    std::vector<PathCost> costs(pairs.size());
+    for (int i = 0; i < 2; ++i) {
+      SearchContext context;
+      for (std::size_t q = 0; q < pairs.size(); ++q) {
+        algorithms[i]->findPath(maze, context, pairs[q].first,
+                                pairs[q].second);
+        const PathStats &stats = context.getStats();
+        milliseconds[i] += stats.executionTime.count();
+        if (i == 0) {
+          costs[q] = stats.pathCost;
+          pathLength += stats.pathLength;
+        } else {
+          steps += stats.nodesExplored;
+          if (stats.pathCost != costs[q])
+            ++mismatches;
+        }
+      }
+    }
+
+    // Distance queries alone, repeated to get a measurable time
+    const int rounds = 100;
+    auto distanceStart = Clock::now();
+    std::uint64_t total = 0;
+    for (int round = 0; round < rounds; ++round) {
+      for (const auto &pair : pairs) {
+        total += index->distance(
+            maze.indexOf(pair.first->getX(), pair.first->getY()),
+            maze.indexOf(pair.second->getX(), pair.second->getY()));
+      }
+    }
+    const double distanceMs = millisecondsSince(distanceStart);
+    std::uint64_t expected = 0;
+    for (PathCost cost : costs)
+      expected += cost;
+    if (total != expected * rounds)
+      ++mismatches;
+
+    std::cout << std::left << std::setw(14) << generator.first << std::right
+              << std::fixed << std::setprecision(1) << std::setw(10)
+              << buildMs << std::setw(8)
+              << index->getMemoryBytes() / (1024.0 * 1024.0) << std::setw(10)
+              << static_cast<double>(pathLength) / queries
+              << std::setprecision(3) << std::setw(11)
+              << milliseconds[0] / queries << std::setw(11)
+              << milliseconds[1] / queries << std::setprecision(1)
+              << std::setw(9) << milliseconds[0] / milliseconds[1] << "x"
+              << std::setw(10) << static_cast<double>(steps) / queries
+              << std::setprecision(3) << std::setw(13)
+              << distanceMs * 1000.0 / (queries * rounds) << std::endl;
+  }
+
+  // A maze with cycles is refused, and so is a tree whose walls changed
+  std::cout << std::endl;
+  Maze cyclic;
+  cyclic.generate(size, size);
+  const TreeIndex cyclicIndex(cyclic);
+  std::cout << "Maze::generate(): "
+            << (cyclicIndex.isTree() ? "indexed" : "not a tree, refused")
+            << std::endl;
+
+  Maze edited;
+  edited.generatePerfectMaze(size, size);
+  auto editedIndex = std::make_shared<TreeIndex>(edited);
+  edited.setWall(1, 1, true);
+  std::cout << "Wall edit: "
+            << (editedIndex->isCurrent(edited) ? "still current"
+                                               : "stale, queries fall back")
+            << std::endl;
+  if (cyclicIndex.isTree() || editedIndex->isCurrent(edited))
+    ++mismatches;
+
+  if (mismatches > 0) {
+    std::cerr << "Error: " << mismatches << " results differ from A*"
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -9,8 +10,10 @@
 #include "BFSPathfinder.h"
 #include "DFSPathfinder.h"
 #include "DijkstraPathfinder.h"
+#include "JPSPathfinder.h"
 #include "Maze.h"
 #include "Renderer.h"
+#include "SearchContext.h"
 
 /**
  * @brief Main project demonstration with interactive menu
@@ -21,8 +24,8 @@ struct AlgorithmResult {
   std::string name;
   bool executed = false;
   bool pathFound = false;
-  int pathLength = 0;
-  int nodesExplored = 0;
+  std::uint64_t pathLength = 0;
+  std::uint64_t nodesExplored = 0;
   double executionTime = 0.0;
 };
 
@@ -37,8 +40,9 @@ void displayMenu() {
   std::cout << "  2. DFS (Depth-First Search)\n";
   std::cout << "  3. Dijkstra's Algorithm\n";
   std::cout << "  4. A* (A-Star) Algorithm\n";
-  std::cout << "  5. Run All Algorithms\n";
-  std::cout << "  6. Show Comparative Analysis\n";
+  std::cout << "  5. JPS (Jump Point Search)\n";
+  std::cout << "  6. Run All Algorithms\n";
+  std::cout << "  7. Show Comparative Analysis\n";
   std::cout << "  0. Exit\n";
   std::cout << "\n";
   std::cout << "Enter your choice: ";
@@ -100,6 +104,7 @@ void displayComparativeAnalysis(const std::vector<AlgorithmResult> &results) {
   std::cout
       << "  * Dijkstra: Finds shortest path (similar to BFS for unweighted)\n";
   std::cout << "  * A*: Most efficient, uses heuristic to guide search\n";
+  std::cout << "  * JPS: Shortest path, queues only jump points (open areas)\n";
   std::cout << "\n";
 }
 
@@ -107,9 +112,6 @@ void runAlgorithm(int algorithmIndex, Maze &maze, std::shared_ptr<Cell> start,
                   std::shared_ptr<Cell> goal, Renderer &renderer,
                   std::vector<AlgorithmResult> &results) {
 
-  // Reset maze state
-  maze.reset();
-
   // Create appropriate algorithm
   std::unique_ptr<PathFinder> algorithm;
   std::string algorithmName;
@@ -131,6 +133,10 @@ void runAlgorithm(int algorithmIndex, Maze &maze, std::shared_ptr<Cell> start,
     algorithm = std::make_unique<AStarPathfinder>();
     algorithmName = "A* (A-Star) Algorithm";
     break;
+  case 4: // JPS
+    algorithm = std::make_unique<JPSPathfinder>();
+    algorithmName = "JPS (Jump Point Search)";
+    break;
   default:
     return;
   }
@@ -141,13 +147,16 @@ void runAlgorithm(int algorithmIndex, Maze &maze, std::shared_ptr<Cell> start,
   std::cout
       << "===============================================================\n\n";
 
+  // Search state (visited cells, path) for this run, drawn by the renderer
+  SearchContext context;
+
   // Create animation callback
   auto callback = [&](std::shared_ptr<Cell> cell) {
-    renderer.animateStep(maze, cell);
+    renderer.animateStep(maze, context, cell);
   };
 
   // Run algorithm with animation
-  auto path = algorithm->findPath(maze, start, goal, callback);
+  auto path = algorithm->findPath(maze, context, start, goal, callback);
 
   // Display final result
   renderer.clearScreen();
@@ -163,13 +172,8 @@ void runAlgorithm(int algorithmIndex, Maze &maze, std::shared_ptr<Cell> start,
   results[algorithmIndex].pathFound = !path.empty();
 
   if (!path.empty()) {
-    // Mark path
-    for (auto &cell : path) {
-      maze.getCell(cell.getX(), cell.getY())->setPath(true);
-    }
-
     // Draw final maze with path
-    renderer.drawMaze(maze);
+    renderer.drawMaze(maze, context);
 
     // Get and display statistics
     auto stats = algorithm->getStats();
@@ -225,11 +229,12 @@ int main() {
   renderer.drawMaze(maze);
 
   // Initialize results storage
-  std::vector<AlgorithmResult> results(4);
+  std::vector<AlgorithmResult> results(5);
   results[0].name = "BFS";
   results[1].name = "DFS";
   results[2].name = "Dijkstra";
   results[3].name = "A*";
+  results[4].name = "JPS";
 
   // Main menu loop
   bool running = true;
@@ -263,14 +268,18 @@ int main() {
       runAlgorithm(3, maze, start, goal, renderer, results);
       break;
 
-    case 5: // Run All
+    case 5: // JPS
+      runAlgorithm(4, maze, start, goal, renderer, results);
+      break;
+
+    case 6: // Run All
       std::cout << "\nRunning all algorithms...\n";
-      for (int i = 0; i < 4; i++) {
+      for (int i = 0; i < 5; i++) {
         runAlgorithm(i, maze, start, goal, renderer, results);
       }
       break;
 
-    case 6: // Show Analysis
+    case 7: // Show Analysis
       displayComparativeAnalysis(results);
       std::cout << "Press Enter to continue...";
       std::cin.ignore();
@@ -290,7 +299,7 @@ int main() {
       break;
 
     default:
-      std::cout << "\nInvalid choice! Please select 0-6.\n";
+      std::cout << "\nInvalid choice! Please select 0-7.\n";
       std::cin.ignore();
     }
   }
@@ -7,6 +7,7 @@
 #include "BFSPathfinder.h"
 #include "Maze.h"
 #include "Renderer.h"
+#include "SearchContext.h"
 
 /**
  * @brief Minimal demo of the new Renderer with BFS animation
@@ -43,13 +44,16 @@ int main() {
   // Create BFS pathfinder
   BFSPathfinder bfs;
 
+  // Search state (visited cells, path) for this run, drawn by the renderer
+  SearchContext context;
+
   // Run BFS with animation callback
   auto callback = [&](std::shared_ptr<Cell> cell) {
-    renderer.animateStep(maze, cell);
+    renderer.animateStep(maze, context, cell);
   };
 
   std::cout << "Running BFS with animation..." << std::endl;
-  auto path = bfs.findPath(maze, start, goal, callback);
+  auto path = bfs.findPath(maze, context, start, goal, callback);
 
   // Display final result
   renderer.clearScreen();
@@ -57,13 +61,8 @@ int main() {
   if (!path.empty()) {
     std::cout << "Path found!" << std::endl;
 
-    // Mark path
-    for (auto &cell : path) {
-      maze.getCell(cell.getX(), cell.getY())->setPath(true);
-    }
-
     // Draw final maze with path
-    renderer.drawMaze(maze);
+    renderer.drawMaze(maze, context);
 
     // Show statistics
     auto stats = bfs.getStats();
@@ -6,8 +6,10 @@
 
 #include "AStarPathfinder.h"
 #include "BFSPathfinder.h"
+#include "BidirectionalBFSPathfinder.h"
 #include "DFSPathfinder.h"
 #include "DijkstraPathfinder.h"
+#include "JPSPathfinder.h"
 #include "Maze.h"
 #include "MazeVisualizer.h"
 #include "PathFinder.h"
@@ -55,9 +57,12 @@ int main() {
   // Create algorithm instances
   std::vector<std::pair<std::string, std::unique_ptr<PathFinder>>> algorithms;
   algorithms.push_back({"BFS", std::make_unique<BFSPathfinder>()});
+  algorithms.push_back(
+      {"Bidir. BFS", std::make_unique<BidirectionalBFSPathfinder>()});
   algorithms.push_back({"DFS", std::make_unique<DFSPathfinder>()});
   algorithms.push_back({"Dijkstra", std::make_unique<DijkstraPathfinder>()});
   algorithms.push_back({"A*", std::make_unique<AStarPathfinder>()});
+  algorithms.push_back({"JPS", std::make_unique<JPSPathfinder>()});
 
   // Store results for comparison
   std::vector<std::pair<std::string, PathStats>> results;
@@ -67,10 +72,8 @@ int main() {
   std::cout << std::endl;
 
   for (auto &[name, algorithm] : algorithms) {
-    // Reset maze state before each algorithm
-    maze.reset();
-
-    // Run the algorithm
+    // Run the algorithm (search state lives in the pathfinder's context, so
+    // the maze needs no reset between runs)
     algorithm->initialize();
     auto path = algorithm->findPath(maze, start, goal);
     auto stats = algorithm->getStats();
@@ -115,7 +118,6 @@ int main() {
     std::cout << "=== Path Visualization (BFS) ===" << std::endl;
 
     // Re-run BFS to get the path for visualization
-    maze.reset();
     BFSPathfinder bfs;
     auto path = bfs.findPath(maze, start, goal);
     MazeVisualizer::displayMazeWithPath(maze, path);
@@ -0,0 +1,191 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "JumpPointTable.h"
+#include "LandmarkTable.h"
+#include "Maze.h"
+
+/**
+ * @brief Converts mazes between the text, binary and image formats.
+ *
+ * Formats are chosen by file extension. Inputs can be binary mazes (.mazb),
+ * PBM/PGM images (.pbm, .pgm) or text mazes (anything else). The output is
+ * a binary maze if it ends in .mazb, otherwise a text maze. Terrain costs
+ * are carried over between the text and binary formats. The written file is
+ * read back and compared with the input before the tool reports success.
+ *
+ * Usage: maze_convert INPUT OUTPUT [--start X Y] [--goal X Y]
+ *                     [--threshold N] [--jump-table FILE]
+ *                     [--landmarks FILE [--landmark-count K]]
+ *   maze_convert maze.txt maze.mazb                  text -> binary
+ *   maze_convert maze.mazb maze.txt                  binary -> text
+ *   maze_convert level.pbm level.mazb --start 1 1 --goal 98 98
+ *   maze_convert maze.txt maze.mazb --jump-table maze.jps
+ *   maze_convert maze.txt maze.mazb --landmarks maze.alt
+ *
+ * --start and --goal override the input's start and goal (images have none
+ * unless a sidecar file provides them). --threshold sets the PGM gray value
+ * below which a pixel is a wall. --jump-table also writes the JPS+ jump
+ * table of the maze (see JumpPointTable), to load alongside it.
+ * --landmarks likewise writes a LandmarkTable of K landmarks (default 8)
+ * for the ALT heuristic of AStarPathfinder.
+ */
+
+namespace {
+
+bool endsWith(const std::string &text, const std::string &suffix) {
+  return text.size() >= suffix.size() &&
+         text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool isImage(const std::string &filename) {
+  return endsWith(filename, ".pbm") || endsWith(filename, ".pgm");
+}
+
+bool sameMaze(const Maze &a, const Maze &b) {
+  if (a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight())
+    return false;
+
+  auto sameCell = [](const std::shared_ptr<Cell> &p,
+                     const std::shared_ptr<Cell> &q) {
+    return (!p && !q) || (p && q && p->getCoords() == q->getCoords());
+  };
+  if (!sameCell(a.getStart(), b.getStart()) ||
+      !sameCell(a.getGoal(), b.getGoal()))
+    return false;
+
+  for (int y = 0; y < a.getHeight(); ++y) {
+    for (int x = 0; x < a.getWidth(); ++x) {
+      if (a.isWall(x, y) != b.isWall(x, y) ||
+          a.getCost(x, y) != b.getCost(x, y))
+        return false;
+    }
+  }
+  return true;
+}
+
+void printUsage(const char *program) {
+  std::cerr << "Usage: " << program
+            << " INPUT OUTPUT [--start X Y] [--goal X Y] [--threshold N]"
+            << " [--jump-table FILE]"
+            << " [--landmarks FILE [--landmark-count K]]" << std::endl;
+  std::cerr << "  INPUT: .mazb, .pbm/.pgm or text; OUTPUT: .mazb or text"
+            << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  const std::string input = argv[1];
+  const std::string output = argv[2];
+  bool hasStart = false;
+  bool hasGoal = false;
+  int startX = 0, startY = 0, goalX = 0, goalY = 0;
+  int threshold = -1;
+  std::string jumpTable;
+  std::string landmarkTable;
+  int landmarkCount = 8;
+
+  for (int i = 3; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--start" && i + 2 < argc) {
+      hasStart = true;
+      startX = std::atoi(argv[++i]);
+      startY = std::atoi(argv[++i]);
+    } else if (arg == "--goal" && i + 2 < argc) {
+      hasGoal = true;
+      goalX = std::atoi(argv[++i]);
+      goalY = std::atoi(argv[++i]);
+    } else if (arg == "--threshold" && i + 1 < argc) {
+      threshold = std::atoi(argv[++i]);
+    } else if (arg == "--jump-table" && i + 1 < argc) {
+      jumpTable = argv[++i];
+    } else if (arg == "--landmarks" && i + 1 < argc) {
+      landmarkTable = argv[++i];
+    } else if (arg == "--landmark-count" && i + 1 < argc) {
+      landmarkCount = std::atoi(argv[++i]);
+    } else {
+      printUsage(argv[0]);
+      return 2;
+    }
+  }
+
+  Maze maze;
+  bool loaded = false;
+  if (endsWith(input, ".mazb")) {
+    loaded = maze.loadFromBinaryFile(input, true);
+  } else if (isImage(input)) {
+    loaded = maze.loadFromImageFile(input, threshold);
+  } else {
+    loaded = maze.loadFromFile(input);
+  }
+  if (!loaded)
+    return 1;
+
+  if (hasStart) {
+    if (!maze.isValid(startX, startY)) {
+      std::cerr << "Error: Start is outside the maze" << std::endl;
+      return 1;
+    }
+    maze.setStart(startX, startY);
+  }
+  if (hasGoal) {
+    if (!maze.isValid(goalX, goalY)) {
+      std::cerr << "Error: Goal is outside the maze" << std::endl;
+      return 1;
+    }
+    maze.setGoal(goalX, goalY);
+  }
+
+  const bool toBinary = endsWith(output, ".mazb");
+  const bool saved =
+      toBinary ? maze.saveToBinaryFile(output) : maze.saveToFile(output);
+  if (!saved)
+    return 1;
+
+  Maze check;
+  const bool reloaded = toBinary ? check.loadFromBinaryFile(output, true)
+                                 : check.loadFromFile(output);
+  if (!reloaded || !sameMaze(maze, check)) {
+    std::cerr << "Error: " << output << " does not match " << input
+              << std::endl;
+    return 1;
+  }
+
+  std::cout << "Converted " << maze.getWidth() << "x" << maze.getHeight()
+            << " maze: " << input << " -> " << output << " ("
+            << (toBinary ? "binary" : "text") << ")" << std::endl;
+
+  if (!jumpTable.empty()) {
+    JumpPointTable table(maze);
+    JumpPointTable checkTable;
+    if (!table.saveToFile(jumpTable) ||
+        !checkTable.loadFromFile(jumpTable, check))
+      return 1;
+    std::cout << "Wrote jump table: " << jumpTable << " ("
+              << table.getMemoryBytes() << " bytes)" << std::endl;
+  }
+
+  if (!landmarkTable.empty()) {
+    if (landmarkCount < 1 || landmarkCount > LandmarkTable::MAX_LANDMARKS) {
+      std::cerr << "Error: Landmark count must be 1 to "
+                << LandmarkTable::MAX_LANDMARKS << std::endl;
+      return 1;
+    }
+    LandmarkTable table(maze, landmarkCount);
+    LandmarkTable checkTable;
+    if (!table.saveToFile(landmarkTable) ||
+        !checkTable.loadFromFile(landmarkTable, check))
+      return 1;
+    std::cout << "Wrote landmark table: " << landmarkTable << " ("
+              << table.getLandmarkCount() << " landmarks, "
+              << table.getMemoryBytes() << " bytes)" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,151 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "AStarPathfinder.h"
+#include "BFSPathfinder.h"
+#include "DFSPathfinder.h"
+#include "DijkstraPathfinder.h"
+#include "Maze.h"
+#include "SearchContext.h"
+
+/**
+ * @brief Stress test for very large mazes.
+ *
+ * Generates a perfect maze (20000x20000 = 4*10^8 cells by default), optionally
+ * round-trips it through the text format with Maze::loadFromFile, and solves
+ * it with all four pathfinders. Reports wall time and peak resident set size
+ * after each phase.
+ *
+ * Usage: stress_large_maze [size] [backtracking|prims|division] [--file PATH]
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double peakRssMiB() {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage {};
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / (1024.0 * 1024.0); // bytes
+#else
+  return usage.ru_maxrss / 1024.0; // kilobytes
+#endif
+#else
+  return 0.0;
+#endif
+}
+
+void report(const std::string &phase, double seconds) {
+  std::cout << std::left << std::setw(28) << phase << std::right
+            << std::setw(12) << std::fixed << std::setprecision(2) << seconds
+            << " s" << std::setw(12) << std::setprecision(0) << peakRssMiB()
+            << " MiB peak" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  int size = 20000;
+  MazeGenerationAlgorithm algorithm =
+      MazeGenerationAlgorithm::RECURSIVE_BACKTRACKING;
+  std::string textFile;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--file" && i + 1 < argc) {
+      textFile = argv[++i];
+    } else if (arg == "prims") {
+      algorithm = MazeGenerationAlgorithm::RANDOMIZED_PRIMS;
+    } else if (arg == "division") {
+      algorithm = MazeGenerationAlgorithm::RECURSIVE_DIVISION;
+    } else if (arg == "backtracking") {
+      algorithm = MazeGenerationAlgorithm::RECURSIVE_BACKTRACKING;
+    } else {
+      size = std::atoi(arg.c_str());
+    }
+  }
+
+  std::cout << "=== Large maze stress test: " << size << "x" << size << " ("
+            << static_cast<double>(size) * size << " cells) ===" << std::endl;
+  std::cout << std::endl;
+
+  const auto total = Clock::now();
+
+  Maze maze;
+  auto phase = Clock::now();
+  maze.generatePerfectMaze(size, size, algorithm);
+  report("generatePerfectMaze", secondsSince(phase));
+
+  if (!textFile.empty()) {
+    phase = Clock::now();
+    if (!maze.saveToFile(textFile)) {
+      return 1;
+    }
+    report("write text file", secondsSince(phase));
+
+    phase = Clock::now();
+    Maze loaded;
+    if (!loaded.loadFromFile(textFile)) {
+      return 1;
+    }
+    report("loadFromFile", secondsSince(phase));
+
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        if (loaded.isWall(x, y) != maze.isWall(x, y)) {
+          std::cerr << "Error: Loaded maze differs at (" << x << ", " << y
+                    << ")" << std::endl;
+          return 1;
+        }
+      }
+    }
+  }
+
+  auto start = maze.getStart();
+  auto goal = maze.getGoal();
+
+  std::vector<std::pair<std::string, std::unique_ptr<PathFinder>>> algorithms;
+  algorithms.push_back({"BFS", std::make_unique<BFSPathfinder>()});
+  algorithms.push_back({"DFS", std::make_unique<DFSPathfinder>()});
+  algorithms.push_back({"Dijkstra", std::make_unique<DijkstraPathfinder>()});
+  algorithms.push_back({"A*", std::make_unique<AStarPathfinder>()});
+
+  // One context shared by all runs, so the per-cell search marks are only
+  // allocated once
+  SearchContext context;
+
+  for (auto &[name, finder] : algorithms) {
+    phase = Clock::now();
+    auto path = finder->findPath(maze, context, start, goal);
+    report(name, secondsSince(phase));
+
+    auto stats = context.getStats();
+    std::cout << "    path length " << stats.pathLength << ", nodes explored "
+              << stats.nodesExplored << std::endl;
+    if (path.empty()) {
+      std::cerr << "Error: " << name << " found no path" << std::endl;
+      return 1;
+    }
+  }
+
+  std::cout << std::endl;
+  report("total", secondsSince(total));
+
+  return 0;
+}